@@ -4,7 +4,6 @@
 #define LIGHT_TYPE_SPOT 1
 #define LIGHT_TYPE_POINT 2
 
-#define MAX_MATERIALS 100
 #define MAX_LIGHTS 100
 
 
@@ -47,16 +46,14 @@ cbuffer cbPerLights : register(b1)
     Light lights[MAX_LIGHTS];
 };
 
-cbuffer MaterialBuffer : register(b2) 
-{
-    SBMaterialDSL materials[MAX_MATERIALS];
-};
+// Indexed by material id, grows with the material count
+StructuredBuffer<SBMaterialDSL> materials : register(t4);
 
 
 SBMaterialDSL GetMaterialById(float materialId)
 {
     int id = int(materialId);
-    return materials[id-1];
+    return materials[id];
 }
 
 struct VSOutput
@@ -88,7 +85,8 @@ float4 PS(VSOutput pin) : SV_Target
     float4 pixelIdMapping = texture_pixelIdMapping.Sample(g_sampler, pin.UV);
     
     float objectId = pixelIdMapping.r * 255.0f;
-    float materialId = pixelIdMapping.g * 255.0f;
+    // Low byte in g, high byte in b
+    float materialId = round(pixelIdMapping.g * 255.0f) + round(pixelIdMapping.b * 255.0f) * 256.0f;
     
     if (albedo.r == 0.678431392f || albedo.g == 0.847058892f || albedo.b == 0.901960850f)
     {
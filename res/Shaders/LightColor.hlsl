@@ -45,7 +45,7 @@ struct VertexIn
 {
     float3 PosL : POSITION;
     float4 Color : COLOR;
-    float3 Normal : NORMAL;
+    GC_VERTEX_NORMAL_TYPE Normal : NORMAL;
 };
 
 struct VertexOut
@@ -70,7 +70,7 @@ VertexOut VS(VertexIn vin)
     vout.PosH = mul(mul(posW, gView), gProj);
 
     // Transform normal to world space
-    vout.NormalW = normalize(mul(vin.Normal, (float3x3) gWorldTransposed));
+    vout.NormalW = normalize(mul(GC_DECODE_VERTEX_NORMAL(vin.Normal), (float3x3) gWorldTransposed));
 
     // Pass vertex color to the pixel shader.
     vout.Color = vin.Color;
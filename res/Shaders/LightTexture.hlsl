@@ -48,7 +48,7 @@ struct VertexIn
 {
     float3 PosL : POSITION;
     float2 UV : TEXCOORD;
-    float3 Normal : NORMAL;
+    GC_VERTEX_NORMAL_TYPE Normal : NORMAL;
 };
 
 struct VertexOut
@@ -73,7 +73,7 @@ VertexOut VS(VertexIn vin)
     vout.PosH = mul(mul(posW, gView), gProj);
 
     // Transform normal to world space
-    vout.NormalW = normalize(mul(vin.Normal, (float3x3) gWorldTransposed));
+    vout.NormalW = normalize(mul(GC_DECODE_VERTEX_NORMAL(vin.Normal), (float3x3) gWorldTransposed));
 
     // Pass vertex color to the pixel shader.
     vout.UV = vin.UV;
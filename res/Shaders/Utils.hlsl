@@ -126,4 +126,24 @@ float3 ReconstructWorldPosition(float2 screenPos, float depth, float4x4 viewMatr
     float4 worldPos = mul(InverseMatrix(viewMatrix), viewPos);
 
     return worldPos.xyz;
-}
\ No newline at end of file
+}
+
+// Normal stored by GC_VERTEX_NORMAL_OCT (octahedral map, see GCVertexLayout::EncodeOctahedralNormal)
+float3 DecodeOctahedralNormal(float2 encoded)
+{
+    float3 normal = float3(encoded.x, encoded.y, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float fold = saturate(-normal.z);
+    normal.x += normal.x >= 0.0f ? -fold : fold;
+    normal.y += normal.y >= 0.0f ? -fold : fold;
+    return normalize(normal);
+}
+
+// Vertex normal input : octahedral float2 when GCShader compiles with GC_NORMAL_OCT (mesh flag
+// GC_VERTEX_NORMAL_OCT), float3 otherwise. Lit shaders declare and read it through these
+#ifdef GC_NORMAL_OCT
+#define GC_VERTEX_NORMAL_TYPE float2
+#define GC_DECODE_VERTEX_NORMAL(normal) DecodeOctahedralNormal(normal)
+#else
+#define GC_VERTEX_NORMAL_TYPE float3
+#define GC_DECODE_VERTEX_NORMAL(normal) (normal)
+#endif
\ No newline at end of file
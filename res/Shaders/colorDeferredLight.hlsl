@@ -17,7 +17,7 @@ struct VertexIn
 {
     float3 PosL : POSITION;
     float4 Color : COLOR;
-    float3 Normal : NORMAL;
+    GC_VERTEX_NORMAL_TYPE Normal : NORMAL;
 };
 
 struct VertexOut
@@ -42,7 +42,7 @@ VertexOut VS(VertexIn vin)
     vout.PosH = mul(mul(posW, gView), gProj);
 
     // Transform normal to world space
-    vout.NormalW = normalize(mul(vin.Normal, (float3x3) gWorldTransposed));
+    vout.NormalW = normalize(mul(GC_DECODE_VERTEX_NORMAL(vin.Normal), (float3x3) gWorldTransposed));
 
     // Pass vertex color to the pixel shader.
     vout.Color = vin.Color;
@@ -74,8 +74,10 @@ PSOutput PS(VertexOut pin) : SV_Target
     output.color1 = finalColor;
     
     float r = float(objectId % 256) / 255.0f;
-    float g = float(materialId % 256) / 255.0f;
-    output.color2 = float4(r, g, 0.0f, 1.0f);
+    uint material = uint(materialId);
+    float g = float(material % 256) / 255.0f;
+    float b = float((material / 256) % 256) / 255.0f;
+    output.color2 = float4(r, g, b, 1.0f);
     
     float3 remappedNormal = (pin.NormalW * 0.5) + 0.5;
     output.Albedo = float4(finalColor.rgb, finalColor.a);
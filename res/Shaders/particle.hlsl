@@ -0,0 +1,72 @@
+#include "Utils.hlsl"
+
+Texture2D g_texture : register(t0); // Particle texture
+SamplerState g_sampler : register(s0);
+
+// Must match GCPARTICLE
+struct Particle
+{
+    float3 position;
+    float size;
+    float4 color;
+    float3 velocity;
+    float age;
+    float lifetime;
+    float3 padding;
+};
+
+StructuredBuffer<Particle> g_particles : register(t1); // One particle per instance
+
+cbuffer cbPerObject : register(b0)
+{
+    float4x4 gWorld;
+    float objectId;
+};
+
+cbuffer cbPerCamera : register(b1)
+{
+    float4x4 gView;
+    float4x4 gProj;
+};
+
+struct VertexIn
+{
+    float3 PosL : POSITION;
+    float2 UV : TEXCOORD;
+};
+
+struct VertexOut
+{
+    float4 PosH : SV_POSITION;
+    float2 UV : TEXCOORD;
+    float4 Color : COLOR;
+};
+
+VertexOut VS(VertexIn vin, uint instanceId : SV_InstanceID)
+{
+    VertexOut vout;
+
+    Particle particle = g_particles[instanceId];
+
+    // Dead particle (free slot of the gpu simulation) : zero area quad, rasterizes nothing
+    float size = particle.age < particle.lifetime ? particle.size : 0.0f;
+
+    float4x4 gWorldTransposed = TransposeMatrix(gWorld);
+
+    // Plane quad (0, 0) -> (1, -1) centered, expanded in view space : faces the camera in 2D and 3D
+    float2 corner = vin.PosL.xy - float2(0.5f, -0.5f);
+    float4 posV = mul(mul(float4(particle.position, 1.0f), gWorldTransposed), gView);
+    posV.xy += corner * size;
+
+    vout.PosH = mul(posV, gProj);
+    vout.UV = vin.UV;
+    vout.Color = particle.color;
+
+    return vout;
+}
+
+float4 PS(VertexOut pin) : SV_Target
+{
+    float4 texColor = g_texture.Sample(g_sampler, pin.UV);
+    return texColor * pin.Color;
+}
@@ -0,0 +1,60 @@
+// Must match GCPARTICLE
+struct Particle
+{
+    float3 position;
+    float size;
+    float4 color;
+    float3 velocity;
+    float age;
+    float lifetime;
+    float3 padding;
+};
+
+StructuredBuffer<Particle> spawnedParticles : register(t0); // Emitted this frame by the CPU
+RWStructuredBuffer<Particle> particles : register(u0); // Ring of maxParticles slots
+
+// Root constants, must match GC_PARTICLE_SIMULATION_CONSTANTS
+cbuffer cbSimulation : register(b0)
+{
+    float gDeltaTime;
+    float3 gGravity;
+    float gDrag;
+    float gStartSize;
+    float gEndSize;
+    uint gSpawnStart;
+    float4 gStartColor;
+    float4 gEndColor;
+    uint gSpawnCount;
+    uint gMaxParticles;
+};
+
+[numthreads(256, 1, 1)]
+void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint slot = dispatchThreadID.x;
+    if (slot >= gMaxParticles)
+        return;
+
+    // New particles overwrite the slots following gSpawnStart (oldest first), one thread per slot : no race
+    uint spawnIndex = (slot + gMaxParticles - gSpawnStart) % gMaxParticles;
+    if (spawnIndex < gSpawnCount)
+    {
+        particles[slot] = spawnedParticles[spawnIndex];
+        return;
+    }
+
+    Particle particle = particles[slot];
+    if (particle.age >= particle.lifetime)
+        return;
+
+    particle.velocity += gGravity * gDeltaTime;
+    particle.velocity *= max(1.0f - gDrag * gDeltaTime, 0.0f);
+    particle.position += particle.velocity * gDeltaTime;
+    particle.age += gDeltaTime;
+
+    float t = saturate(particle.age / particle.lifetime);
+    particle.size = lerp(gStartSize, gEndSize, t);
+    particle.color = lerp(gStartColor, gEndColor, t);
+
+    particles[slot] = particle;
+}
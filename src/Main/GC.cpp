@@ -24,6 +24,8 @@ void LEWindowGC::Initialize(int width, int height, const char* title)
 	mpGraphics = new GCGraphics();
     mpGraphics->Initialize(mpWindow, width, height);
     mpGraphics->GetRender()->Set2DMode();
+    // Most of a level is off camera, skip the sprites outside of the screen rect
+    mpGraphics->GetRender()->ActiveCulling();
 
     //Setting up camera
 	int halfHeight = -1 * (height / 2);
@@ -67,17 +69,34 @@ void LEWindowGC::Draw(IObject* pDrawable)
         mpGraphics->StartFrame();
 
         mStartFrame = true;
+
+        mPreviousFrameFirstDraw = mFrameFirstDraw;
+        mFrameFirstDraw = mDrawCounter + 1;
     }
 
+    //Rebuild world matrices of every object moved since the last draw in one batch
+    if (mTransforms.IsDirty())
+        mTransforms.Update();
+
     LEObjectGC* pLEDrawableGC = (LEObjectGC*)pDrawable;
 
+    mDrawOrder[pLEDrawableGC->mTransform] = ++mDrawCounter;
+
+    //Already in the cached static layer, no world matrix to upload
+    if (pLEDrawableGC->mIsStatic && mpGraphics->GetRender()->IsStaticLayerCached())
+        return;
+
     GCMaterial* mpMaterial = pLEDrawableGC->mpMaterial;
 	GCMesh* pMesh = pLEDrawableGC->mpMesh;
-	DirectX::XMMATRIX& mWorldMatrix = pLEDrawableGC->mWorldMatrix;
+	const DirectX::XMFLOAT4X4& world = mTransforms.GetWorldMatrix(pLEDrawableGC->mTransform);
+	DirectX::XMMATRIX worldMatrix = DirectX::XMLoadFloat4x4(&world);
 
-    mpGraphics->UpdateWorldConstantBuffer(mpMaterial, mWorldMatrix);
+    mpGraphics->UpdateWorldConstantBuffer(mpMaterial, worldMatrix);
 
-    mpGraphics->GetRender()->DrawObject(pMesh, mpMaterial, true);
+    if (pLEDrawableGC->mIsStatic)
+        mpGraphics->GetRender()->DrawStaticObject(pMesh, mpMaterial, true);
+    else
+        mpGraphics->GetRender()->DrawObject(pMesh, mpMaterial, true, 0.0f, &world);
 }
 
 void LEWindowGC::Render()
@@ -87,106 +106,329 @@ void LEWindowGC::Render()
     mStartFrame = false;
 }
 
-LEObjectGC::LEObjectGC()
+void LEWindowGC::GetFrameStats(LEFrameStats& outStats)
 {
-	mWorldMatrix = DirectX::XMMatrixIdentity();
+    const GC_FRAME_STATS& stats = mpGraphics->GetFrameStats();
+
+    outStats.frameIndex = stats.frameIndex;
+    outStats.drawCalls = stats.drawCalls;
+    outStats.triangles = stats.triangles;
+    outStats.culledDraws = stats.culledDraws;
+    outStats.pipelineStateChanges = stats.psoChanges;
+    outStats.rootSignatureChanges = stats.rootSignatureChanges;
+    outStats.constantBufferBytes = stats.constantBufferBytes;
+    outStats.meshUploadBytes = stats.meshUploadBytes;
+    outStats.descriptorsAllocated = stats.descriptorsAllocated;
+    outStats.materialsUsed = stats.materialsUsed;
+    outStats.cpuFrameMs = stats.cpuFrameMs;
+    outStats.gpuFrameMs = stats.hasGpuTiming ? stats.gpuFrameMs : -1.0;
 }
 
-void LEObjectGC::SetPosition(float x, float y)
+GCMesh* LEWindowGC::GetQuadMesh()
 {
-    mX = x;
-    mY = y;
+    int flagsTexture = 0;
+    GC_SET_FLAG(flagsTexture, GC_VERTEX_POSITION);
+    GC_SET_FLAG(flagsTexture, GC_VERTEX_UV);
+
+    auto mesh = mpGraphics->GetPrimitiveMesh(Plane, flagsTexture);
+    assert(mesh.success);
 
-    ComputeWorldMatrix();
+    return mesh.resource;
 }
 
-void LEObjectGC::ComputeWorldMatrix()
+GCMesh* LEWindowGC::GetCircleMesh()
 {
-	mWorldMatrix = DirectX::XMMatrixScaling(mWidth, mHeight, 1.0f) * DirectX::XMMatrixTranslation(mX, -mY, 0.0f);
+    int flagsColor = 0;
+    GC_SET_FLAG(flagsColor, GC_VERTEX_POSITION);
+    GC_SET_FLAG(flagsColor, GC_VERTEX_COLOR);
+
+    auto mesh = mpGraphics->GetPrimitiveMesh(Circle, flagsColor, DirectX::XMFLOAT4(DirectX::Colors::Beige));
+    assert(mesh.success);
+
+    return mesh.resource;
 }
 
-void LETextureGC::Load(const char* path)
+GCMaterial* LEWindowGC::GetCircleMaterial()
+{
+    if (mpCircleMaterial)
+        return mpCircleMaterial;
+
+    //Create material
+    auto material = mpGraphics->CreateMaterial(mpGraphics->GetShaderColor().resource);
+    assert(material.success);
+    mpCircleMaterial = material.resource;
+
+    return mpCircleMaterial;
+}
+
+bool LEWindowGC::GetTextureResource(const char* path, GCTexture*& pTexture, GCMaterial*& pMaterial)
 {
-    GCGraphics* pGraphics = LEWindowGC::Get()->GetGraphics();
+    auto it = mTextureCache.find(path);
+    if (it != mTextureCache.end())
+    {
+        pTexture = it->second.pTexture;
+        pMaterial = it->second.pMaterial;
+        return true;
+    }
 
-    pGraphics->InitializeGraphicsResourcesStart();
+    mpGraphics->InitializeGraphicsResourcesStart();
 
     //Texture creation
-    auto texture = pGraphics->CreateTexture(std::string(path) + ".dds");
-    assert(texture.success);
-    
-    mpTexture = texture.resource;
+    auto texture = mpGraphics->CreateTexture(std::string(path) + ".dds");
 
-    pGraphics->InitializeGraphicsResourcesEnd();
+    mpGraphics->InitializeGraphicsResourcesEnd();
 
-    //Create shaders
-    auto shaderTexture = pGraphics->CreateShaderTexture();
+    if (texture.success == false)
+        return false;
+
+    //Create material, the texture template shader is shared by every texture material
+    auto material = mpGraphics->CreateMaterial(mpGraphics->GetShaderTexture().resource);
+    if (material.success == false)
+        return false;
 
-    //Create material
-    auto material = pGraphics->CreateMaterial(shaderTexture.resource);
     material.resource->SetTexture(texture.resource);
-    assert(material.success);
 
-    mpMaterial = material.resource;
+    pTexture = texture.resource;
+    pMaterial = material.resource;
+
+    mTextureCache.emplace(path, TextureResource{ pTexture, pMaterial });
 
-    mWidth = texture.resource->GetWidth();
-    mHeight = texture.resource->GetHeight();
+    return true;
 }
 
+void LEWindowGC::AddObject(LEObjectGC* pObject)
+{
+    int handle = pObject->mTransform;
+    if (handle >= (int)mObjects.size())
+    {
+        mObjects.resize(handle + 1, nullptr);
+        mDrawOrder.resize(handle + 1, 0);
+    }
 
-LESpriteGC::LESpriteGC()
+    mObjects[handle] = pObject;
+    mDrawOrder[handle] = 0;
+}
+
+void LEWindowGC::RemoveObject(LEObjectGC* pObject)
 {
-    GCGraphics* pGraphics = LEWindowGC::Get()->GetGraphics();
+    int handle = pObject->mTransform;
 
-    auto geoPlane = pGraphics->CreateGeometryPrimitive(Plane, DirectX::XMFLOAT4(DirectX::Colors::Black));
-    assert(geoPlane.success);
-    mpGeometry = geoPlane.resource;
+    mSpatialGrid.Remove(handle);
+    mObjects[handle] = nullptr;
+    mDrawOrder[handle] = 0;
 
-    pGraphics->InitializeGraphicsResourcesStart();
+    if (pObject->mIsStatic)
+        InvalidateStaticLayer();
+}
 
-    //Mesh creation
-    auto mesh = pGraphics->CreateMeshTexture(mpGeometry);
-    assert(mesh.success);
+void LEWindowGC::InvalidateStaticLayer()
+{
+    GCRenderContext* pRender = mpGraphics->GetRender();
 
-    mpMesh = mesh.resource;
+    if (mIsStaticLayerActive == false)
+    {
+        pRender->ActiveStaticLayer();
+        mIsStaticLayerActive = true;
+    }
 
-    pGraphics->InitializeGraphicsResourcesEnd();
+    //Changes made after the start of the frame show from the next frame
+    pRender->InvalidateStaticLayer();
 }
 
-void LESpriteGC::SetTexture(ITexture* pTexture)
+void LEWindowGC::UpdateObjectBounds(LEObjectGC* pObject)
 {
-    LETextureGC* pLETextureGC = (LETextureGC*)pTexture;
-	mpMaterial = pLETextureGC->mpMaterial;
+    //Every transform change goes through here
+    if (pObject->mIsStatic)
+        InvalidateStaticLayer();
+
+    // No mesh yet (sprite without texture), nothing drawn so nothing to find
+    if (pObject->mpMesh == nullptr)
+        return;
+
+    int handle = pObject->mTransform;
+    const DirectX::BoundingBox& localBox = pObject->mpMesh->GetBoundingBox();
+
+    float scaleX = mTransforms.GetScaleX(handle);
+    float scaleY = mTransforms.GetScaleY(handle);
+    float sinR = std::sin(mTransforms.GetRotation(handle));
+    float cosR = std::cos(mTransforms.GetRotation(handle));
+
+    // Same transform as the world matrix : scale, rotate, then translate to (x, -y)
+    float centerX = localBox.Center.x * scaleX;
+    float centerY = localBox.Center.y * scaleY;
+    float worldX = centerX * cosR - centerY * sinR + mTransforms.GetX(handle);
+    float worldY = centerX * sinR + centerY * cosR - mTransforms.GetY(handle);
+
+    float extentX = localBox.Extents.x * std::abs(scaleX);
+    float extentY = localBox.Extents.y * std::abs(scaleY);
+    float worldExtentX = extentX * std::abs(cosR) + extentY * std::abs(sinR);
+    float worldExtentY = extentX * std::abs(sinR) + extentY * std::abs(cosR);
+
+    // Back to screen space, y down
+    float screenY = -worldY;
+    mSpatialGrid.Update(handle, worldX - worldExtentX, screenY - worldExtentY, worldX + worldExtentX, screenY + worldExtentY);
+}
 
-	mWidth = pLETextureGC->mWidth;
-	mHeight = pLETextureGC->mHeight;
+void LEWindowGC::QueryRect(float x, float y, float width, float height, std::vector<IObject*>& outObjects)
+{
+    std::vector<int> handles;
+    mSpatialGrid.QueryRect(x, y, x + width, y + height, handles);
+
+    for (int handle : handles)
+        outObjects.push_back(mObjects[handle]);
 }
 
-LECircleGC::LECircleGC()
+void LEWindowGC::QueryPoint(float x, float y, std::vector<IObject*>& outObjects)
 {
-    GCGraphics* pGraphics = LEWindowGC::Get()->GetGraphics();
+    std::vector<int> handles;
+    mSpatialGrid.QueryPoint(x, y, handles);
 
-	auto geoCircle = pGraphics->CreateGeometryPrimitive(Circle, DirectX::XMFLOAT4(DirectX::Colors::Beige));
-	assert(geoCircle.success);
-	mpGeometry = geoCircle.resource;
+    for (int handle : handles)
+        outObjects.push_back(mObjects[handle]);
+}
 
-	pGraphics->InitializeGraphicsResourcesStart();
+void LEWindowGC::QueryVisible(std::vector<IObject*>& outObjects)
+{
+    QueryRect(0.0f, 0.0f, (float)mWidth, (float)mHeight, outObjects);
+}
 
-    //Mesh creation
-	auto mesh = pGraphics->CreateMeshColor(mpGeometry);
-	assert(mesh.success);
-	mpMesh = mesh.resource;
+IObject* LEWindowGC::GetObjectAt(int x, int y)
+{
+    DirectX::XMFLOAT4X4 proj, view;
+    DirectX::XMStoreFloat4x4(&proj, mProjectionMatrix);
+    DirectX::XMStoreFloat4x4(&view, mViewMatrix);
 
-    pGraphics->InitializeGraphicsResourcesEnd();
+    DirectX::XMFLOAT3 worldPos = GCUtils::PixelToWorld((float)x, (float)y, mWidth, mHeight, proj, view);
 
-    //Create shaders
-    auto shaderColor = pGraphics->CreateShaderColor();
+    std::vector<int> handles;
+    mSpatialGrid.QueryPoint(worldPos.x, -worldPos.y, handles);
 
-    //Create material
-    auto material = pGraphics->CreateMaterial(shaderColor.resource);
-    assert(material.success);
+    LEObjectGC* pTopmost = nullptr;
+    uint32_t topmostOrder = 0;
+
+    for (int handle : handles)
+    {
+        // Not drawn recently, not on screen
+        uint32_t order = mDrawOrder[handle];
+        if (order == 0 || order < mPreviousFrameFirstDraw || order <= topmostOrder)
+            continue;
+
+        // The grid holds axis aligned bounds, check the rotated rect itself
+        if (ContainsPoint(mObjects[handle], worldPos.x, worldPos.y) == false)
+            continue;
+
+        pTopmost = mObjects[handle];
+        topmostOrder = order;
+    }
+
+    return pTopmost;
+}
+
+bool LEWindowGC::ContainsPoint(LEObjectGC* pObject, float worldX, float worldY)
+{
+    int handle = pObject->mTransform;
+    const DirectX::BoundingBox& localBox = pObject->mpMesh->GetBoundingBox();
+
+    float scaleX = mTransforms.GetScaleX(handle);
+    float scaleY = mTransforms.GetScaleY(handle);
+    if (scaleX == 0.0f || scaleY == 0.0f)
+        return false;
+
+    float sinR = std::sin(mTransforms.GetRotation(handle));
+    float cosR = std::cos(mTransforms.GetRotation(handle));
+
+    // Undo the world matrix : translation to (x, -y), rotation, then scale
+    float dx = worldX - mTransforms.GetX(handle);
+    float dy = worldY + mTransforms.GetY(handle);
+    float localX = (dx * cosR + dy * sinR) / scaleX;
+    float localY = (dy * cosR - dx * sinR) / scaleY;
+
+    return std::abs(localX - localBox.Center.x) <= localBox.Extents.x
+        && std::abs(localY - localBox.Center.y) <= localBox.Extents.y;
+}
+
+LEObjectGC::LEObjectGC()
+{
+    mpMesh = nullptr;
+    mpMaterial = nullptr;
+
+    LEWindowGC* pWindow = LEWindowGC::Get();
+    mTransform = pWindow->GetTransforms().Create();
+    pWindow->AddObject(this);
+    UpdateScale();
+}
+
+LEObjectGC::~LEObjectGC()
+{
+    LEWindowGC* pWindow = LEWindowGC::Get();
+    pWindow->RemoveObject(this);
+    pWindow->GetTransforms().Destroy(mTransform);
+}
+
+void LEObjectGC::SetPosition(float x, float y)
+{
+    LEWindowGC* pWindow = LEWindowGC::Get();
+    pWindow->GetTransforms().SetPosition(mTransform, x, y);
+    pWindow->UpdateObjectBounds(this);
+}
+
+void LEObjectGC::SetRotation(float angle)
+{
+    LEWindowGC* pWindow = LEWindowGC::Get();
+    pWindow->GetTransforms().SetRotation(mTransform, DirectX::XMConvertToRadians(angle));
+    pWindow->UpdateObjectBounds(this);
+}
+
+void LEObjectGC::UpdateScale()
+{
+    LEWindowGC* pWindow = LEWindowGC::Get();
+    pWindow->GetTransforms().SetScale(mTransform, (float)mWidth, (float)mHeight);
+    pWindow->UpdateObjectBounds(this);
+}
+
+void LEObjectGC::SetStatic(bool isStatic)
+{
+    if (mIsStatic == isStatic)
+        return;
+
+    //Invalidated in both cases : the object enters or leaves the layer
+    mIsStatic = isStatic;
+    LEWindowGC::Get()->InvalidateStaticLayer();
+}
+
+void LETextureGC::Load(const char* path)
+{
+    bool loaded = LEWindowGC::Get()->GetTextureResource(path, mpTexture, mpMaterial);
+    assert(loaded);
+
+    mWidth = mpTexture->GetWidth();
+    mHeight = mpTexture->GetHeight();
+}
+
+
+LESpriteGC::LESpriteGC()
+{
+    //Every sprite is drawn with the same unit quad, scaled by its world matrix
+    mpMesh = LEWindowGC::Get()->GetQuadMesh();
+}
+
+void LESpriteGC::SetTexture(ITexture* pTexture)
+{
+    LETextureGC* pLETextureGC = (LETextureGC*)pTexture;
+	mpMaterial = pLETextureGC->mpMaterial;
+
+	mWidth = pLETextureGC->mWidth;
+	mHeight = pLETextureGC->mHeight;
+
+    UpdateScale();
+}
+
+LECircleGC::LECircleGC()
+{
+    LEWindowGC* pWindow = LEWindowGC::Get();
 
-    mpMaterial = material.resource;
+    mpMesh = pWindow->GetCircleMesh();
+    mpMaterial = pWindow->GetCircleMaterial();
 
 	SetRadius(1.0f);
 }
@@ -195,5 +437,8 @@ void LECircleGC::SetRadius(float radius)
 {
 	mRadius = radius;
 
-    ComputeWorldMatrix();
+    //Circle primitive has a unit diameter
+    LEWindowGC* pWindow = LEWindowGC::Get();
+    pWindow->GetTransforms().SetScale(mTransform, radius * 2.0f, radius * 2.0f);
+    pWindow->UpdateObjectBounds(this);
 }
\ No newline at end of file
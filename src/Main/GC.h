@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Generic.h"
+#include "LEPool.h"
+#include "LETransformGC.h"
+#include "LESpatialGridGC.h"
 
 class Window;
 class GCGraphics;
 
 class GCTexture;
 class GCMaterial;
+class GCShader;
 
 struct GCGeometry;
 class GCMesh;
 
+class LEObjectGC;
+
 namespace DirectX 
 {
 	struct XMMATRIX;
@@ -27,6 +33,31 @@ class LEWindowGC : public IWindow
 
 	bool mStartFrame = false;
 
+	// Material shared by every circle, created once on first use
+	GCMaterial* mpCircleMaterial = nullptr;
+
+	LETransformSystemGC mTransforms;
+
+	// Screen space bounds of the objects, indexed by transform handle like mObjects
+	LESpatialGridGC mSpatialGrid;
+	std::vector<LEObjectGC*> mObjects;
+
+	// Draw counter value of the last Draw of each object, the topmost object is the last drawn
+	std::vector<uint32_t> mDrawOrder;
+	uint32_t mDrawCounter = 0;
+	uint32_t mFrameFirstDraw = 0;
+	uint32_t mPreviousFrameFirstDraw = 0;
+
+	// Static layer target is only allocated once an object is made static
+	bool mIsStaticLayerActive = false;
+
+	struct TextureResource
+	{
+		GCTexture* pTexture;
+		GCMaterial* pMaterial;
+	};
+	std::unordered_map<std::string, TextureResource> mTextureCache;
+
 	inline static LEWindowGC* mpInstance = nullptr;
 
 public:
@@ -34,6 +65,8 @@ public:
 
 	static LEWindowGC* Get() { return mpInstance; }
 	GCGraphics* GetGraphics() { return mpGraphics; }
+	LETransformSystemGC& GetTransforms() { return mTransforms; }
+	LESpatialGridGC& GetSpatialGrid() { return mSpatialGrid; }
 
 	int GetWidth() { return mWidth; }
 	int GetHeight() { return mHeight; }
@@ -42,35 +75,74 @@ public:
 	void Clear() override {};
 	void Draw(IObject* pDrawable) override;
 	void Render() override;
+	void GetFrameStats(LEFrameStats& outStats) override;
+
+	GCMesh* GetQuadMesh();
+	GCMesh* GetCircleMesh();
+	GCMaterial* GetCircleMaterial();
+
+	// Texture and material are loaded once per path and shared by every LETexture loading it
+	bool GetTextureResource(const char* path, GCTexture*& pTexture, GCMaterial*& pMaterial);
+
+	void AddObject(LEObjectGC* pObject);
+	void RemoveObject(LEObjectGC* pObject);
+	// Refreshes the object in the spatial grid after a transform change
+	void UpdateObjectBounds(LEObjectGC* pObject);
+	// Static objects are cached by the render, it must redraw them after any change
+	void InvalidateStaticLayer();
+
+	// Objects whose bounds overlap the rect / contain the point, in pixels
+	void QueryRect(float x, float y, float width, float height, std::vector<IObject*>& outObjects);
+	void QueryPoint(float x, float y, std::vector<IObject*>& outObjects);
+	// Objects on screen, the ones worth passing to Draw
+	void QueryVisible(std::vector<IObject*>& outObjects);
+
+	// Topmost object drawn this frame or the previous one under the pixel, nullptr if none.
+	// Answered on the CPU from the spatial grid, no pixel id render target nor GPU readback needed
+	IObject* GetObjectAt(int x, int y);
+
+private:
+	bool ContainsPoint(LEObjectGC* pObject, float worldX, float worldY);
 };
 
 class LEObjectGC : public IObject
 {
 protected:
-	GCGeometry* mpGeometry;
 	GCMesh* mpMesh;
 	GCMaterial* mpMaterial;
 
-	DirectX::XMMATRIX mWorldMatrix;
-	int mX = 0, mY = 0;
+	// Handle in LEWindowGC transform system, the world matrix is computed there
+	int mTransform;
 	int mWidth = 0, mHeight = 0;
 
+	bool mIsStatic = false;
+
 public:
 	LEObjectGC();
+	~LEObjectGC();
 
 	void SetPosition(float x, float y) override;
-	void ComputeWorldMatrix();
+	void SetRotation(float angle) override;
+	void UpdateScale();
+
+	// Static objects (background, level tiles) are rendered once in a cached layer below the other objects,
+	// they must still be passed to Draw every frame but cost nothing while they don't change
+	void SetStatic(bool isStatic);
+	bool IsStatic() const { return mIsStatic; }
 
 	friend LEWindowGC;
 };
 
 class LETextureGC : public ITexture
 {
-	GCTexture* mpTexture;
-	GCMaterial* mpMaterial;
+	LE_POOLED_OBJECT(LETextureGC)
+
+private:
+	GCTexture* mpTexture = nullptr;
+	GCMaterial* mpMaterial = nullptr;
 
-	int mWidth;
-	int mHeight;
+	int mWidth = 0;
+	int mHeight = 0;
 
 public:
 	void Load(const char* path) override;
@@ -82,7 +154,8 @@ public:
 
 class LESpriteGC : public ISprite, public LEObjectGC
 {
-public:
+	LE_POOLED_OBJECT(LESpriteGC)
+
 	LESpriteGC();
 
 public:
@@ -91,6 +164,9 @@ public:
 
 class LECircleGC : public ICircle, public LEObjectGC
 {
+	LE_POOLED_OBJECT(LECircleGC)
+
+private:
 	float mRadius;
 
 public:
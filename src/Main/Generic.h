@@ -2,18 +2,47 @@
 
 class IObject;
 
+// Counters of the last rendered frame, 0 when the backend can't measure them
+struct LEFrameStats
+{
+	unsigned long long frameIndex = 0;
+
+	int drawCalls = 0;
+	unsigned long long triangles = 0;
+	int culledDraws = 0;
+
+	int pipelineStateChanges = 0;
+	int rootSignatureChanges = 0;
+
+	unsigned long long constantBufferBytes = 0;
+	unsigned long long meshUploadBytes = 0;
+	int descriptorsAllocated = 0;
+	int materialsUsed = 0;
+
+	double cpuFrameMs = 0.0;
+	// Negative while no GPU timing is available
+	double gpuFrameMs = -1.0;
+};
+
 class IWindow
 {
 public:
+	virtual ~IWindow() = default;
+
 	virtual void Initialize(int width, int height, const char* title) = 0;
 	virtual void Clear() = 0;
 	virtual void Draw(IObject* pDrawable) = 0;
 	virtual void Render() = 0;
+
+	// Updated by Render
+	virtual void GetFrameStats(LEFrameStats& outStats) = 0;
 };
 
 class ITexture
 {
 public:
+	virtual ~ITexture() = default;
+
 	virtual void Load(const char* path) = 0;
 	virtual void GetWidth() = 0;
 	virtual void GetHeight() = 0;
@@ -21,18 +50,27 @@ public:
 
 class IObject
 {
+public:
+	virtual ~IObject() = default;
+
+private:
 	virtual void SetPosition(float x, float y) = 0;
+	virtual void SetRotation(float angle) = 0;
 };
 
 class ISprite
 {
 public:
+	virtual ~ISprite() = default;
+
 	virtual void SetTexture(ITexture* pTexture) = 0;
 };
 
 class ICircle
 {
 public:
+	virtual ~ICircle() = default;
+
 	virtual void SetRadius(float radius) = 0;
 	virtual void SetColor(unsigned char r, unsigned char g, unsigned char b) = 0;
 };
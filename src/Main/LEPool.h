@@ -0,0 +1,104 @@
+#pragma once
+
+// Fixed-size slot arena : memory is reserved by contiguous chunks and released slots are recycled
+// through an intrusive free list, so spawning / despawning objects doesn't touch the heap once warm.
+template<typename T, size_t ChunkSize = 256>
+class LEPool
+{
+	union Slot
+	{
+		Slot* pNext;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	std::vector<Slot*> mChunks;
+	Slot* mpFreeList = nullptr;
+
+	size_t mUsedCount = 0;
+
+public:
+	LEPool() = default;
+	LEPool(const LEPool&) = delete;
+	LEPool& operator=(const LEPool&) = delete;
+
+	~LEPool()
+	{
+		for (Slot* pChunk : mChunks)
+			delete[] pChunk;
+	}
+
+	static LEPool& Get()
+	{
+		static LEPool instance;
+		return instance;
+	}
+
+	void* Allocate()
+	{
+		if (mpFreeList == nullptr)
+			Grow();
+
+		Slot* pSlot = mpFreeList;
+		mpFreeList = pSlot->pNext;
+		mUsedCount++;
+
+		return pSlot->storage;
+	}
+
+	void Free(void* p)
+	{
+		if (p == nullptr)
+			return;
+
+		Slot* pSlot = reinterpret_cast<Slot*>(p);
+		pSlot->pNext = mpFreeList;
+		mpFreeList = pSlot;
+		mUsedCount--;
+	}
+
+	template<typename... Args>
+	T* Create(Args&&... args)
+	{
+		return new (Allocate()) T(std::forward<Args>(args)...);
+	}
+
+	void Destroy(T* p)
+	{
+		if (p == nullptr)
+			return;
+
+		p->~T();
+		Free(p);
+	}
+
+	// Pre-allocates enough chunks to hold count objects, so the first spawn wave doesn't grow the pool
+	void Reserve(size_t count)
+	{
+		while (GetCapacity() < count)
+			Grow();
+	}
+
+	size_t GetUsedCount() const { return mUsedCount; }
+	size_t GetCapacity() const { return mChunks.size() * ChunkSize; }
+
+private:
+	void Grow()
+	{
+		Slot* pChunk = new Slot[ChunkSize];
+		mChunks.push_back(pChunk);
+
+		// Link backward so slots are handed out in address order
+		for (size_t i = ChunkSize; i > 0; i--)
+		{
+			pChunk[i - 1].pNext = mpFreeList;
+			mpFreeList = &pChunk[i - 1];
+		}
+	}
+};
+
+// Routes new / delete of a LE type through its pool. Derived types with a different size fall back to the global heap.
+#define LE_POOLED_OBJECT(type) \
+public: \
+	static void* operator new(size_t size) { return size == sizeof(type) ? LEPool<type>::Get().Allocate() : ::operator new(size); } \
+	static void operator delete(void* p, size_t size) { if (size == sizeof(type)) LEPool<type>::Get().Free(p); else ::operator delete(p); } \
+	static void Reserve(size_t count) { LEPool<type>::Get().Reserve(count); }
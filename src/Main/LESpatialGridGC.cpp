@@ -0,0 +1,166 @@
+#include "pch.h"
+#include "LESpatialGridGC.h"
+
+LESpatialGridGC::LESpatialGridGC(float cellSize)
+{
+    mCellSize = cellSize;
+    mInvCellSize = 1.0f / cellSize;
+}
+
+void LESpatialGridGC::Update(int handle, float minX, float minY, float maxX, float maxY)
+{
+    if (handle < 0)
+        return;
+
+    if (handle >= (int)mEntries.size())
+    {
+        mEntries.resize(handle + 1);
+        mQueryStamps.resize(handle + 1, 0);
+    }
+
+    Entry& entry = mEntries[handle];
+
+    int cellMinX = ToCell(minX);
+    int cellMinY = ToCell(minY);
+    int cellMaxX = ToCell(maxX);
+    int cellMaxY = ToCell(maxY);
+
+    bool sameCells = entry.inserted
+        && entry.cellMinX == cellMinX && entry.cellMinY == cellMinY
+        && entry.cellMaxX == cellMaxX && entry.cellMaxY == cellMaxY;
+
+    if (entry.inserted && sameCells == false)
+        RemoveCells(handle, entry);
+
+    entry.minX = minX;
+    entry.minY = minY;
+    entry.maxX = maxX;
+    entry.maxY = maxY;
+
+    if (sameCells)
+        return;
+
+    entry.cellMinX = cellMinX;
+    entry.cellMinY = cellMinY;
+    entry.cellMaxX = cellMaxX;
+    entry.cellMaxY = cellMaxY;
+
+    if (entry.inserted == false)
+    {
+        entry.inserted = true;
+        mCount++;
+    }
+
+    InsertCells(handle, entry);
+}
+
+void LESpatialGridGC::Remove(int handle)
+{
+    if (handle < 0 || handle >= (int)mEntries.size())
+        return;
+
+    Entry& entry = mEntries[handle];
+    if (entry.inserted == false)
+        return;
+
+    RemoveCells(handle, entry);
+    entry.inserted = false;
+    mCount--;
+}
+
+void LESpatialGridGC::QueryRect(float minX, float minY, float maxX, float maxY, std::vector<int>& outHandles) const
+{
+    uint32_t stamp = NextQueryStamp();
+
+    int cellMinX = ToCell(minX);
+    int cellMinY = ToCell(minY);
+    int cellMaxX = ToCell(maxX);
+    int cellMaxY = ToCell(maxY);
+
+    for (int cellY = cellMinY; cellY <= cellMaxY; cellY++)
+    {
+        for (int cellX = cellMinX; cellX <= cellMaxX; cellX++)
+        {
+            auto it = mCells.find(CellKey(cellX, cellY));
+            if (it == mCells.end())
+                continue;
+
+            for (int handle : it->second)
+            {
+                if (mQueryStamps[handle] == stamp)
+                    continue;
+                mQueryStamps[handle] = stamp;
+
+                const Entry& entry = mEntries[handle];
+                if (entry.maxX < minX || entry.minX > maxX || entry.maxY < minY || entry.minY > maxY)
+                    continue;
+
+                outHandles.push_back(handle);
+            }
+        }
+    }
+}
+
+void LESpatialGridGC::QueryPoint(float x, float y, std::vector<int>& outHandles) const
+{
+    auto it = mCells.find(CellKey(ToCell(x), ToCell(y)));
+    if (it == mCells.end())
+        return;
+
+    // A single cell, every handle is listed once
+    for (int handle : it->second)
+    {
+        const Entry& entry = mEntries[handle];
+        if (x < entry.minX || x > entry.maxX || y < entry.minY || y > entry.maxY)
+            continue;
+
+        outHandles.push_back(handle);
+    }
+}
+
+void LESpatialGridGC::InsertCells(int handle, const Entry& entry)
+{
+    for (int cellY = entry.cellMinY; cellY <= entry.cellMaxY; cellY++)
+    {
+        for (int cellX = entry.cellMinX; cellX <= entry.cellMaxX; cellX++)
+            mCells[CellKey(cellX, cellY)].push_back(handle);
+    }
+}
+
+void LESpatialGridGC::RemoveCells(int handle, const Entry& entry)
+{
+    for (int cellY = entry.cellMinY; cellY <= entry.cellMaxY; cellY++)
+    {
+        for (int cellX = entry.cellMinX; cellX <= entry.cellMaxX; cellX++)
+        {
+            auto it = mCells.find(CellKey(cellX, cellY));
+            if (it == mCells.end())
+                continue;
+
+            std::vector<int>& cell = it->second;
+            auto handleIt = std::find(cell.begin(), cell.end(), handle);
+            if (handleIt != cell.end())
+            {
+                *handleIt = cell.back();
+                cell.pop_back();
+            }
+
+            if (cell.empty())
+                mCells.erase(it);
+        }
+    }
+}
+
+uint32_t LESpatialGridGC::NextQueryStamp() const
+{
+    mQueryStamp++;
+
+    // Wrapped around, old stamps could match again
+    if (mQueryStamp == 0)
+    {
+        std::fill(mQueryStamps.begin(), mQueryStamps.end(), 0);
+        mQueryStamp = 1;
+    }
+
+    return mQueryStamp;
+}
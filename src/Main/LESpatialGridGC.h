@@ -0,0 +1,47 @@
+#pragma once
+
+// Uniform grid over the screen space bounds of the LE objects (x right, y down, in pixels).
+// Only the cells of an object whose cell range changed are touched on Update, so moving an
+// object inside its cells costs nothing. Cells are hashed, the world has no fixed size.
+class LESpatialGridGC
+{
+	struct Entry
+	{
+		float minX, minY, maxX, maxY;
+		int cellMinX, cellMinY, cellMaxX, cellMaxY;
+		bool inserted = false;
+	};
+
+	float mCellSize;
+	float mInvCellSize;
+
+	std::unordered_map<int64_t, std::vector<int>> mCells;
+	std::vector<Entry> mEntries;
+	int mCount = 0;
+
+	// An object spanning several cells is reported once per query
+	mutable std::vector<uint32_t> mQueryStamps;
+	mutable uint32_t mQueryStamp = 0;
+
+public:
+	explicit LESpatialGridGC(float cellSize = 256.0f);
+
+	void Update(int handle, float minX, float minY, float maxX, float maxY);
+	void Remove(int handle);
+
+	// Handles whose bounds overlap the rect / contain the point, in no particular order
+	void QueryRect(float minX, float minY, float maxX, float maxY, std::vector<int>& outHandles) const;
+	void QueryPoint(float x, float y, std::vector<int>& outHandles) const;
+
+	int GetCount() const { return mCount; }
+	float GetCellSize() const { return mCellSize; }
+
+private:
+	int ToCell(float value) const { return (int)std::floor(value * mInvCellSize); }
+	static int64_t CellKey(int cellX, int cellY) { return ((int64_t)cellX << 32) | (uint32_t)cellY; }
+
+	void InsertCells(int handle, const Entry& entry);
+	void RemoveCells(int handle, const Entry& entry);
+
+	uint32_t NextQueryStamp() const;
+};
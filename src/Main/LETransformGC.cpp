@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "LETransformGC.h"
+
+using namespace DirectX;
+
+// Objects are processed by blocks of one XMVECTOR lane each
+static constexpr int BLOCK_SIZE = 4;
+
+int LETransformSystemGC::Create()
+{
+    if (mFreeHandles.empty())
+    {
+        // Grow by a whole block so SIMD loads never read past the arrays
+        int first = (int)mX.size();
+        int newSize = first + BLOCK_SIZE;
+
+        mX.resize(newSize, 0.0f);
+        mY.resize(newSize, 0.0f);
+        mScaleX.resize(newSize, 0.0f);
+        mScaleY.resize(newSize, 0.0f);
+        mRotation.resize(newSize, 0.0f);
+        mWorldMatrices.resize(newSize);
+        mBlockDirty.push_back(0);
+
+        for (int i = newSize - 1; i >= first; i--)
+            mFreeHandles.push_back(i);
+    }
+
+    int handle = mFreeHandles.back();
+    mFreeHandles.pop_back();
+
+    mX[handle] = 0.0f;
+    mY[handle] = 0.0f;
+    mScaleX[handle] = 1.0f;
+    mScaleY[handle] = 1.0f;
+    mRotation[handle] = 0.0f;
+    MarkDirty(handle);
+
+    mUsedCount++;
+
+    return handle;
+}
+
+void LETransformSystemGC::Destroy(int handle)
+{
+    if (handle < 0)
+        return;
+
+    // Freed slots stay inside their block, a zero scale keeps them harmless for the batch
+    mScaleX[handle] = 0.0f;
+    mScaleY[handle] = 0.0f;
+
+    mFreeHandles.push_back(handle);
+    mUsedCount--;
+}
+
+void LETransformSystemGC::SetPosition(int handle, float x, float y)
+{
+    mX[handle] = x;
+    mY[handle] = y;
+    MarkDirty(handle);
+}
+
+void LETransformSystemGC::SetScale(int handle, float scaleX, float scaleY)
+{
+    mScaleX[handle] = scaleX;
+    mScaleY[handle] = scaleY;
+    MarkDirty(handle);
+}
+
+void LETransformSystemGC::SetRotation(int handle, float radians)
+{
+    mRotation[handle] = radians;
+    MarkDirty(handle);
+}
+
+void LETransformSystemGC::MarkDirty(int handle)
+{
+    int block = handle / BLOCK_SIZE;
+    if (mBlockDirty[block])
+        return;
+
+    mBlockDirty[block] = 1;
+    mDirtyBlocks.push_back(block);
+}
+
+// World = Scaling(sx, sy, 1) * RotationZ(r) * Translation(x, -y, 0), rows :
+// ( sx * cos, sx * sin, 0, 0 )
+// (-sy * sin, sy * cos, 0, 0 )
+// (        0,        0, 1, 0 )
+// (        x,       -y, 0, 1 )
+// Each row is computed for 4 objects at once, then a transpose turns lanes back into per-object rows.
+void LETransformSystemGC::Update()
+{
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR one = XMVectorSplatOne();
+    const XMVECTOR row2 = g_XMIdentityR2;
+
+    for (int block : mDirtyBlocks)
+    {
+        int i = block * BLOCK_SIZE;
+
+        XMVECTOR x = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mX[i]));
+        XMVECTOR y = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mY[i]));
+        XMVECTOR scaleX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mScaleX[i]));
+        XMVECTOR scaleY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mScaleY[i]));
+        XMVECTOR rotation = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&mRotation[i]));
+
+        XMVECTOR sinR, cosR;
+        XMVectorSinCos(&sinR, &cosR, rotation);
+
+        XMMATRIX rows0 = XMMatrixTranspose(XMMATRIX(XMVectorMultiply(scaleX, cosR), XMVectorMultiply(scaleX, sinR), zero, zero));
+        XMMATRIX rows1 = XMMatrixTranspose(XMMATRIX(XMVectorNegate(XMVectorMultiply(scaleY, sinR)), XMVectorMultiply(scaleY, cosR), zero, zero));
+        XMMATRIX rows3 = XMMatrixTranspose(XMMATRIX(x, XMVectorNegate(y), zero, one));
+
+        for (int k = 0; k < BLOCK_SIZE; k++)
+            XMStoreFloat4x4(&mWorldMatrices[i + k], XMMATRIX(rows0.r[k], rows1.r[k], row2, rows3.r[k]));
+
+        mBlockDirty[block] = 0;
+    }
+
+    mDirtyBlocks.clear();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Transforms of every LE object, stored as SoA arrays. Setters only write the arrays and flag the
+// 4-object block as dirty, world matrices of dirty blocks are rebuilt in one SIMD pass by Update().
+class LETransformSystemGC
+{
+	std::vector<float> mX, mY;
+	std::vector<float> mScaleX, mScaleY;
+	std::vector<float> mRotation;
+
+	std::vector<DirectX::XMFLOAT4X4> mWorldMatrices;
+
+	std::vector<uint8_t> mBlockDirty;
+	std::vector<int> mDirtyBlocks;
+
+	std::vector<int> mFreeHandles;
+	int mUsedCount = 0;
+
+public:
+	int Create();
+	void Destroy(int handle);
+
+	void SetPosition(int handle, float x, float y);
+	void SetScale(int handle, float scaleX, float scaleY);
+	void SetRotation(int handle, float radians);
+
+	float GetX(int handle) const { return mX[handle]; }
+	float GetY(int handle) const { return mY[handle]; }
+	float GetScaleX(int handle) const { return mScaleX[handle]; }
+	float GetScaleY(int handle) const { return mScaleY[handle]; }
+	float GetRotation(int handle) const { return mRotation[handle]; }
+
+	// Valid after Update()
+	const DirectX::XMFLOAT4X4& GetWorldMatrix(int handle) const { return mWorldMatrices[handle]; }
+
+	bool IsDirty() const { return mDirtyBlocks.empty() == false; }
+	int GetCount() const { return mUsedCount; }
+
+	void Update();
+
+private:
+	void MarkDirty(int handle);
+};
@@ -17,11 +17,26 @@ void SFMLWindow::Draw(IObject* pDrawable)
 {
 	SFMLObject* pSFMLDrawable = (SFMLObject*)pDrawable;
 	mpWindow->draw(pSFMLDrawable->Get());
+	mDrawCount++;
 }
 
 void SFMLWindow::Render()
 {
 	mpWindow->display();
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (mFrameIndex > 0)
+		mFrameStats.cpuFrameMs = std::chrono::duration<double, std::milli>(now - mLastRenderTime).count();
+	mLastRenderTime = now;
+
+	mFrameStats.frameIndex = mFrameIndex++;
+	mFrameStats.drawCalls = mDrawCount;
+	mDrawCount = 0;
+}
+
+void SFMLWindow::GetFrameStats(LEFrameStats& outStats)
+{
+	outStats = mFrameStats;
 }
 
 void SFMLObject::SetPosition(float x, float y)
@@ -29,14 +44,24 @@ void SFMLObject::SetPosition(float x, float y)
 	mpTransformable->setPosition(x, y);
 }
 
+void SFMLObject::SetRotation(float angle)
+{
+	mpTransformable->setRotation(angle);
+}
+
 SFMLSprite::SFMLSprite()
 {
-	sf::Sprite* pSprite = new sf::Sprite();
+	sf::Sprite* pSprite = LEPool<sf::Sprite>::Get().Create();
 	
 	mpDrawable = pSprite;
 	mpTransformable = pSprite;
 }
 
+SFMLSprite::~SFMLSprite()
+{
+	LEPool<sf::Sprite>::Get().Destroy((sf::Sprite*)mpDrawable);
+}
+
 void SFMLSprite::SetTexture(ITexture* pTexture)
 {
 	SFMLTexture* pSFMLTexture = (SFMLTexture*)pTexture;
@@ -46,7 +71,12 @@ void SFMLSprite::SetTexture(ITexture* pTexture)
 
 SFMLTexture::SFMLTexture()
 {
-	mpTexture = new sf::Texture();
+	mpTexture = LEPool<sf::Texture>::Get().Create();
+}
+
+SFMLTexture::~SFMLTexture()
+{
+	LEPool<sf::Texture>::Get().Destroy(mpTexture);
 }
 
 void SFMLTexture::Load(const char* path)
@@ -66,12 +96,17 @@ void SFMLTexture::GetHeight()
 
 SFMLCircle::SFMLCircle()
 {
-	sf::CircleShape* pCircle = new sf::CircleShape();
+	sf::CircleShape* pCircle = LEPool<sf::CircleShape>::Get().Create();
 
 	mpDrawable = pCircle;
 	mpTransformable = pCircle;
 }
 
+SFMLCircle::~SFMLCircle()
+{
+	LEPool<sf::CircleShape>::Get().Destroy((sf::CircleShape*)mpDrawable);
+}
+
 void SFMLCircle::SetRadius(float radius)
 {
 	((sf::CircleShape*)mpDrawable)->setRadius(radius);
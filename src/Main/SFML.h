@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Generic.h"
+#include "LEPool.h"
 
 namespace sf 
 {
@@ -17,11 +18,18 @@ class SFMLWindow : public IWindow
 {
 	sf::RenderWindow* mpWindow;
 
+	// SFML batches nothing : one draw call per Draw
+	int mDrawCount = 0;
+	unsigned long long mFrameIndex = 0;
+	LEFrameStats mFrameStats;
+	std::chrono::steady_clock::time_point mLastRenderTime;
+
 public:
 	virtual void Initialize(int width, int height, const char* title) override;
 	virtual void Clear() override;
 	virtual void Draw(IObject* pObject) override;
 	virtual void Render() override;
+	virtual void GetFrameStats(LEFrameStats& outStats) override;
 
 	friend class SFMLSprite;
 };
@@ -35,14 +43,19 @@ protected:
 public:
 	const sf::Drawable& Get() { return *mpDrawable; }
 	void SetPosition(float x, float y);
+	void SetRotation(float angle);
 };
 
 class SFMLTexture : public ITexture
 {
+	LE_POOLED_OBJECT(SFMLTexture)
+
+private:
 	sf::Texture* mpTexture;
 
 public:
 	SFMLTexture();
+	~SFMLTexture();
 
 	void Load(const char* path) override;
 	void GetWidth() override;
@@ -53,16 +66,20 @@ public:
 
 class SFMLSprite : public ISprite, public SFMLObject
 {
-public:
+	LE_POOLED_OBJECT(SFMLSprite)
+
 	SFMLSprite();
+	~SFMLSprite();
 
 	void SetTexture(ITexture* pTexture) override;
 };
 
 class SFMLCircle : public ICircle, public SFMLObject
 {
-public:
+	LE_POOLED_OBJECT(SFMLCircle)
+
 	SFMLCircle();
+	~SFMLCircle();
 
 	void SetRadius(float radius) override;
 	void SetColor(unsigned char r, unsigned char g, unsigned char b) override;
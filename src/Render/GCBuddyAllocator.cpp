@@ -0,0 +1,126 @@
+#include "pch.h"
+
+GCBuddyAllocator::GCBuddyAllocator()
+    : m_capacity(0),
+    m_minBlockSize(0),
+    m_levelCount(0),
+    m_usedBytes(0),
+    m_requestedBytes(0)
+{
+}
+
+void GCBuddyAllocator::Initialize(UINT64 capacity, UINT64 minBlockSize)
+{
+    // Largest power of 2 of a UINT64 at most
+    const UINT64 maxBlockSize = 1ull << 63;
+    m_minBlockSize = RoundUpPowerOf2(std::clamp<UINT64>(minBlockSize, 1, maxBlockSize));
+    m_capacity = std::max(RoundUpPowerOf2(std::min(capacity, maxBlockSize)), m_minBlockSize);
+
+    m_levelCount = 1;
+    while ((m_capacity >> (m_levelCount - 1)) > m_minBlockSize)
+        m_levelCount++;
+
+    m_usedBytes = 0;
+    m_requestedBytes = 0;
+    m_allocations.clear();
+
+    m_freeBlocks.assign(m_levelCount, std::set<UINT64>());
+    m_freeBlocks[0].insert(0);
+}
+
+UINT64 GCBuddyAllocator::RoundUpPowerOf2(UINT64 value)
+{
+    // The shift would overflow to 0 and never reach value
+    if (value > (1ull << 63))
+        return UINT64_MAX;
+
+    UINT64 result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+int GCBuddyAllocator::GetLevel(UINT64 blockSize) const
+{
+    int level = 0;
+    while (level < m_levelCount - 1 && GetBlockSize(level + 1) >= blockSize)
+        level++;
+    return level;
+}
+
+UINT64 GCBuddyAllocator::Allocate(UINT64 size, UINT64 alignment)
+{
+    if (size == 0 || m_levelCount == 0 || size > m_capacity || alignment > m_capacity)
+        return m_invalidOffset;
+
+    UINT64 blockSize = RoundUpPowerOf2(std::max({ size, alignment, m_minBlockSize }));
+    if (blockSize > m_capacity)
+        return m_invalidOffset;
+
+    int level = GetLevel(blockSize);
+
+    // Smallest free block big enough, split down to the level
+    int freeLevel = level;
+    while (freeLevel >= 0 && m_freeBlocks[freeLevel].empty())
+        freeLevel--;
+    if (freeLevel < 0)
+        return m_invalidOffset;
+
+    UINT64 offset = *m_freeBlocks[freeLevel].begin();
+    m_freeBlocks[freeLevel].erase(m_freeBlocks[freeLevel].begin());
+
+    for (int splitLevel = freeLevel + 1; splitLevel <= level; splitLevel++)
+        m_freeBlocks[splitLevel].insert(offset + GetBlockSize(splitLevel));
+
+    m_allocations[offset] = { level, size };
+    m_usedBytes += GetBlockSize(level);
+    m_requestedBytes += size;
+
+    return offset;
+}
+
+void GCBuddyAllocator::Free(UINT64 offset)
+{
+    auto it = m_allocations.find(offset);
+    if (it == m_allocations.end())
+        return;
+
+    int level = it->second.level;
+    m_usedBytes -= GetBlockSize(level);
+    m_requestedBytes -= it->second.requestedSize;
+    m_allocations.erase(it);
+
+    // Merged with its buddy as long as the buddy is free too
+    while (level > 0)
+    {
+        UINT64 buddyOffset = offset ^ GetBlockSize(level);
+        auto buddy = m_freeBlocks[level].find(buddyOffset);
+        if (buddy == m_freeBlocks[level].end())
+            break;
+
+        m_freeBlocks[level].erase(buddy);
+        offset = std::min(offset, buddyOffset);
+        level--;
+    }
+
+    m_freeBlocks[level].insert(offset);
+}
+
+UINT64 GCBuddyAllocator::GetLargestFreeBlock() const
+{
+    for (int level = 0; level < m_levelCount; level++)
+    {
+        if (m_freeBlocks[level].empty() == false)
+            return GetBlockSize(level);
+    }
+    return 0;
+}
+
+float GCBuddyAllocator::GetFragmentation() const
+{
+    UINT64 freeBytes = GetFreeBytes();
+    if (freeBytes == 0)
+        return 0.0f;
+
+    return 1.0f - static_cast<float>(GetLargestFreeBlock()) / static_cast<float>(freeBytes);
+}
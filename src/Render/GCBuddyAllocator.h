@@ -0,0 +1,52 @@
+#pragma once
+
+// Buddy allocator of a range of offsets, nothing GPU specific : GCGpuMemoryAllocator places its resources with it.
+// Blocks are powers of 2 between the min block size and the capacity, a block is aligned on its size :
+// any alignment up to the block size is free. Freed blocks merge back with their buddy
+class GCBuddyAllocator
+{
+public:
+	static constexpr UINT64 m_invalidOffset = UINT64_MAX;
+
+	GCBuddyAllocator();
+
+	// capacity and minBlockSize are rounded up to powers of 2
+	void Initialize(UINT64 capacity, UINT64 minBlockSize);
+
+	// Offset of a block of at least size bytes aligned on alignment, m_invalidOffset when no block is free
+	UINT64 Allocate(UINT64 size, UINT64 alignment = 1);
+	void Free(UINT64 offset);
+
+	inline UINT64 GetCapacity() const { return m_capacity; }
+	inline UINT64 GetUsedBytes() const { return m_usedBytes; } // Block sizes
+	inline UINT64 GetRequestedBytes() const { return m_requestedBytes; } // Sizes asked to Allocate
+	inline UINT64 GetFreeBytes() const { return m_capacity - m_usedBytes; }
+	inline int GetAllocationCount() const { return static_cast<int>(m_allocations.size()); }
+	UINT64 GetLargestFreeBlock() const;
+	// Share of the free bytes outside of the largest free block : 0 when the free space is in one block
+	float GetFragmentation() const;
+
+	// UINT64_MAX above 2^63, the largest power of 2 of a UINT64
+	static UINT64 RoundUpPowerOf2(UINT64 value);
+
+private:
+	inline UINT64 GetBlockSize(int level) const { return m_capacity >> level; }
+	int GetLevel(UINT64 blockSize) const;
+
+	struct GC_BUDDY_ALLOCATION
+	{
+		int level;
+		UINT64 requestedSize;
+	};
+
+	UINT64 m_capacity;
+	UINT64 m_minBlockSize;
+	int m_levelCount; // Level 0 is the whole capacity, the last one the min block size
+
+	UINT64 m_usedBytes;
+	UINT64 m_requestedBytes;
+
+	// Free block offsets per level, ordered : the lowest offset is used first
+	std::vector<std::set<UINT64>> m_freeBlocks;
+	std::unordered_map<UINT64, GC_BUDDY_ALLOCATION> m_allocations;
+};
@@ -0,0 +1,183 @@
+#include "pch.h"
+
+using namespace DirectX;
+
+void GCCuller::SetCamera(const GCVIEWPROJCB& camera)
+{
+    XMMATRIX view = XMMatrixTranspose(XMLoadFloat4x4(&camera.view));
+    XMMATRIX proj = XMMatrixTranspose(XMLoadFloat4x4(&camera.proj));
+
+    SetViewProj(XMMatrixMultiply(view, proj));
+}
+
+void GCCuller::SetViewProj(FXMMATRIX viewProj)
+{
+    // Rows of the transpose are the columns of viewProj (clip = p * viewProj)
+    XMMATRIX columns = XMMatrixTranspose(viewProj);
+
+    XMVECTOR planes[6];
+    planes[0] = XMVectorAdd(columns.r[3], columns.r[0]);        // Left
+    planes[1] = XMVectorSubtract(columns.r[3], columns.r[0]);   // Right
+    planes[2] = XMVectorAdd(columns.r[3], columns.r[1]);        // Bottom
+    planes[3] = XMVectorSubtract(columns.r[3], columns.r[1]);   // Top
+    planes[4] = columns.r[2];                                   // Near, z clip in [0, w]
+    planes[5] = XMVectorSubtract(columns.r[3], columns.r[2]);   // Far
+
+    for (int i = 0; i < 6; i++)
+        XMStoreFloat4(&m_planes[i], XMPlaneNormalize(planes[i]));
+}
+
+void GCCuller::Clear()
+{
+    m_count = 0;
+    m_visibleCount = 0;
+
+    m_vCenterX.clear();
+    m_vCenterY.clear();
+    m_vCenterZ.clear();
+    m_vExtentX.clear();
+    m_vExtentY.clear();
+    m_vExtentZ.clear();
+}
+
+void GCCuller::Reserve(size_t count)
+{
+    count = (count + 3) & ~static_cast<size_t>(3);
+
+    m_vCenterX.reserve(count);
+    m_vCenterY.reserve(count);
+    m_vCenterZ.reserve(count);
+    m_vExtentX.reserve(count);
+    m_vExtentY.reserve(count);
+    m_vExtentZ.reserve(count);
+    m_vVisible.reserve(count);
+}
+
+int GCCuller::Push(const BoundingBox& localBounds, const XMFLOAT4X4& world)
+{
+    XMMATRIX worldMatrix = XMLoadFloat4x4(&world);
+
+    XMVECTOR center = XMVector3Transform(XMLoadFloat3(&localBounds.Center), worldMatrix);
+
+    // Extents of the transformed box : |rotation-scale| * extents
+    XMVECTOR extents = XMLoadFloat3(&localBounds.Extents);
+    XMVECTOR worldExtents = XMVectorMultiply(XMVectorSplatX(extents), XMVectorAbs(worldMatrix.r[0]));
+    worldExtents = XMVectorMultiplyAdd(XMVectorSplatY(extents), XMVectorAbs(worldMatrix.r[1]), worldExtents);
+    worldExtents = XMVectorMultiplyAdd(XMVectorSplatZ(extents), XMVectorAbs(worldMatrix.r[2]), worldExtents);
+
+    XMFLOAT3 c, e;
+    XMStoreFloat3(&c, center);
+    XMStoreFloat3(&e, worldExtents);
+
+    // Keep the arrays a multiple of 4 so Cull can always load full vectors
+    int index = m_count++;
+    if (index % 4 == 0)
+    {
+        m_vCenterX.resize(index + 4, 0.0f);
+        m_vCenterY.resize(index + 4, 0.0f);
+        m_vCenterZ.resize(index + 4, 0.0f);
+        m_vExtentX.resize(index + 4, 0.0f);
+        m_vExtentY.resize(index + 4, 0.0f);
+        m_vExtentZ.resize(index + 4, 0.0f);
+    }
+
+    m_vCenterX[index] = c.x;
+    m_vCenterY[index] = c.y;
+    m_vCenterZ[index] = c.z;
+    m_vExtentX[index] = e.x;
+    m_vExtentY[index] = e.y;
+    m_vExtentZ[index] = e.z;
+
+    return index;
+}
+
+void GCCuller::Cull(GCThreadPool* pThreadPool)
+{
+    m_visibleCount = 0;
+    if (m_count == 0)
+        return;
+
+    m_vVisible.resize(m_count);
+
+    int taskCount = 1;
+    if (pThreadPool)
+        taskCount = std::min(pThreadPool->GetThreadCount(), m_count / m_minBoundsPerTask);
+
+    if (taskCount <= 1)
+    {
+        m_visibleCount = CullRange(0, m_count);
+        return;
+    }
+
+    // Split on 4-bounds blocks, a task never shares a vector with another one
+    int blockCount = (m_count + 3) / 4;
+    GCThreadPool::Partition(blockCount, taskCount, m_vRanges);
+    m_vRangeVisibleCounts.assign(m_vRanges.size(), 0);
+
+    pThreadPool->ParallelFor(static_cast<int>(m_vRanges.size()), [this](int taskIndex, int)
+        {
+            int begin = m_vRanges[taskIndex].first * 4;
+            int end = std::min(m_vRanges[taskIndex].second * 4, m_count);
+            m_vRangeVisibleCounts[taskIndex] = CullRange(begin, end);
+        });
+
+    for (int visibleCount : m_vRangeVisibleCounts)
+        m_visibleCount += visibleCount;
+}
+
+int GCCuller::CullRange(int begin, int end)
+{
+    XMVECTOR planeX[6], planeY[6], planeZ[6], planeD[6];
+    XMVECTOR planeAbsX[6], planeAbsY[6], planeAbsZ[6];
+    for (int p = 0; p < 6; p++)
+    {
+        XMVECTOR plane = XMLoadFloat4(&m_planes[p]);
+        planeX[p] = XMVectorSplatX(plane);
+        planeY[p] = XMVectorSplatY(plane);
+        planeZ[p] = XMVectorSplatZ(plane);
+        planeD[p] = XMVectorSplatW(plane);
+        planeAbsX[p] = XMVectorAbs(planeX[p]);
+        planeAbsY[p] = XMVectorAbs(planeY[p]);
+        planeAbsZ[p] = XMVectorAbs(planeZ[p]);
+    }
+
+    const XMVECTOR zero = XMVectorZero();
+    int visibleCount = 0;
+
+    for (int i = begin; i < end; i += 4)
+    {
+        XMVECTOR centerX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vCenterX[i]));
+        XMVECTOR centerY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vCenterY[i]));
+        XMVECTOR centerZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vCenterZ[i]));
+        XMVECTOR extentX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vExtentX[i]));
+        XMVECTOR extentY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vExtentY[i]));
+        XMVECTOR extentZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vExtentZ[i]));
+
+        // A box is outside as soon as it is fully behind one plane
+        XMVECTOR inside = XMVectorTrueInt();
+        for (int p = 0; p < 6; p++)
+        {
+            XMVECTOR distance = XMVectorMultiplyAdd(centerX, planeX[p], planeD[p]);
+            distance = XMVectorMultiplyAdd(centerY, planeY[p], distance);
+            distance = XMVectorMultiplyAdd(centerZ, planeZ[p], distance);
+
+            XMVECTOR radius = XMVectorMultiply(extentX, planeAbsX[p]);
+            radius = XMVectorMultiplyAdd(extentY, planeAbsY[p], radius);
+            radius = XMVectorMultiplyAdd(extentZ, planeAbsZ[p], radius);
+
+            inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(XMVectorAdd(distance, radius), zero));
+        }
+
+        uint32_t mask[4];
+        XMStoreInt4(mask, inside);
+
+        int count = std::min(4, end - i);
+        for (int k = 0; k < count; k++)
+        {
+            m_vVisible[i + k] = mask[k] != 0 ? 1 : 0;
+            visibleCount += m_vVisible[i + k];
+        }
+    }
+
+    return visibleCount;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+// Frustum culling of the frame draws. Pushed bounds are moved to world space and kept as SoA
+// arrays, Cull() tests them 4 at a time against the 6 camera planes and splits the work on the
+// thread pool for large counts. In 2D the orthographic frustum is the screen rect.
+class GCCuller
+{
+public:
+	// Same matrices as uploaded in GCVIEWPROJCB (transposed)
+	void SetCamera(const GCVIEWPROJCB& camera);
+	// Untransposed view * proj
+	void SetViewProj(DirectX::FXMMATRIX viewProj);
+
+	void Clear();
+	void Reserve(size_t count);
+
+	// localBounds in mesh space, world as uploaded in GCWORLDCB. Returns the index to query after Cull()
+	int Push(const DirectX::BoundingBox& localBounds, const DirectX::XMFLOAT4X4& world);
+
+	// pThreadPool may be null
+	void Cull(GCThreadPool* pThreadPool);
+
+	inline bool IsVisible(int index) const { return m_vVisible[index] != 0; }
+	inline int GetCount() const { return m_count; }
+	inline int GetVisibleCount() const { return m_visibleCount; }
+
+	// Below this amount of bounds per task, splitting costs more than it saves
+	static constexpr int m_minBoundsPerTask = 2048;
+
+private:
+	// Tests [begin, end), begin multiple of 4, returns the visible count
+	int CullRange(int begin, int end);
+
+	// Plane i : dot(normal, p) + d >= 0 inside, stored splatted by component
+	DirectX::XMFLOAT4 m_planes[6];
+
+	// World space AABB, padded to a multiple of 4
+	std::vector<float> m_vCenterX, m_vCenterY, m_vCenterZ;
+	std::vector<float> m_vExtentX, m_vExtentY, m_vExtentZ;
+	std::vector<uint8_t> m_vVisible;
+
+	int m_count = 0;
+	int m_visibleCount = 0;
+
+	std::vector<std::pair<int, int>> m_vRanges;
+	std::vector<int> m_vRangeVisibleCounts;
+};
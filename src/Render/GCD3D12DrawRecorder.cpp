@@ -0,0 +1,46 @@
+#include "pch.h"
+
+GCD3D12DrawRecorder::GCD3D12DrawRecorder(ID3D12GraphicsCommandList* pCommandList)
+    : m_pCommandList(pCommandList)
+{
+}
+
+void GCD3D12DrawRecorder::SetPipelineState(ID3D12PipelineState* pPso)
+{
+    m_pCommandList->SetPipelineState(pPso);
+}
+
+void GCD3D12DrawRecorder::SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature)
+{
+    m_pCommandList->SetGraphicsRootSignature(pRootSignature);
+}
+
+void GCD3D12DrawRecorder::SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology)
+{
+    m_pCommandList->IASetPrimitiveTopology(topology);
+}
+
+void GCD3D12DrawRecorder::SetVertexBuffer(const D3D12_VERTEX_BUFFER_VIEW& view)
+{
+    m_pCommandList->IASetVertexBuffers(0, 1, &view);
+}
+
+void GCD3D12DrawRecorder::SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view)
+{
+    m_pCommandList->IASetIndexBuffer(&view);
+}
+
+void GCD3D12DrawRecorder::SetGraphicsRootDescriptorTable(UINT rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor)
+{
+    m_pCommandList->SetGraphicsRootDescriptorTable(rootIndex, descriptor);
+}
+
+void GCD3D12DrawRecorder::SetGraphicsRootConstantBufferView(UINT rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address)
+{
+    m_pCommandList->SetGraphicsRootConstantBufferView(rootIndex, address);
+}
+
+void GCD3D12DrawRecorder::DrawIndexedInstanced(UINT indexCount, UINT instanceCount)
+{
+    m_pCommandList->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
+}
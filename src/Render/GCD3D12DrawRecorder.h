@@ -0,0 +1,23 @@
+#pragma once
+
+// Draw recording on a D3D12 graphics command list
+class GCD3D12DrawRecorder : public GCDrawRecorder
+{
+public:
+	explicit GCD3D12DrawRecorder(ID3D12GraphicsCommandList* pCommandList);
+
+	inline ID3D12GraphicsCommandList* GetCommandList() const { return m_pCommandList; }
+
+protected:
+	void SetPipelineState(ID3D12PipelineState* pPso) override;
+	void SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature) override;
+	void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) override;
+	void SetVertexBuffer(const D3D12_VERTEX_BUFFER_VIEW& view) override;
+	void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view) override;
+	void SetGraphicsRootDescriptorTable(UINT rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor) override;
+	void SetGraphicsRootConstantBufferView(UINT rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void DrawIndexedInstanced(UINT indexCount, UINT instanceCount) override;
+
+private:
+	ID3D12GraphicsCommandList* m_pCommandList;
+};
@@ -0,0 +1,119 @@
+#include "pch.h"
+
+void GCDrawRecorder::ResetState()
+{
+    m_state = GC_COMMAND_LIST_STATE();
+}
+
+void GCDrawRecorder::RecordDraw(const GC_DRAW_BINDINGS& draw, GC_STATE_CHANGE_STATS& stats)
+{
+    if (draw.pPso != m_state.pPso) {
+        SetPipelineState(draw.pPso);
+        m_state.pPso = draw.pPso;
+        stats.psoChanges++;
+        stats.issued++;
+    }
+    else stats.skipped++;
+
+    if (draw.pRootSignature != m_state.pRootSignature) {
+        SetGraphicsRootSignature(draw.pRootSignature);
+        m_state.pRootSignature = draw.pRootSignature;
+        m_state.InvalidateRootArguments();
+        stats.rootSignatureChanges++;
+        stats.issued++;
+    }
+    else stats.skipped++;
+
+    if (m_state.isTopologySet == false) {
+        SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        m_state.isTopologySet = true;
+        stats.issued++;
+    }
+    else stats.skipped++;
+
+    const D3D12_VERTEX_BUFFER_VIEW& vertexBufferView = draw.vertexBufferView;
+    if (vertexBufferView.BufferLocation != m_state.vertexBufferAddress || vertexBufferView.SizeInBytes != m_state.vertexBufferSize) {
+        SetVertexBuffer(vertexBufferView);
+        m_state.vertexBufferAddress = vertexBufferView.BufferLocation;
+        m_state.vertexBufferSize = vertexBufferView.SizeInBytes;
+        stats.issued++;
+    }
+    else stats.skipped++;
+
+    const D3D12_INDEX_BUFFER_VIEW& indexBufferView = draw.indexBufferView;
+    if (indexBufferView.BufferLocation != m_state.indexBufferAddress || indexBufferView.SizeInBytes != m_state.indexBufferSize) {
+        SetIndexBuffer(indexBufferView);
+        m_state.indexBufferAddress = indexBufferView.BufferLocation;
+        m_state.indexBufferSize = indexBufferView.SizeInBytes;
+        stats.issued++;
+    }
+    else stats.skipped++;
+
+    if (draw.textureRootIndex >= 0) {
+        if (draw.texture.ptr != m_state.textureDescriptor) {
+            SetGraphicsRootDescriptorTable(draw.textureRootIndex, draw.texture);
+            m_state.textureDescriptor = draw.texture.ptr;
+            stats.issued++;
+        }
+        else stats.skipped++;
+    }
+
+    if (draw.instanceRootIndex >= 0) {
+        if (draw.instances.ptr != m_state.instanceDescriptor) {
+            SetGraphicsRootDescriptorTable(draw.instanceRootIndex, draw.instances);
+            m_state.instanceDescriptor = draw.instances.ptr;
+            stats.issued++;
+        }
+        else stats.skipped++;
+    }
+
+    for (int cb = 0; cb < 4; cb++)
+    {
+        if (draw.constantBufferRootIndices[cb] < 0)
+            continue;
+
+        if (draw.constantBuffers[cb] != m_state.constantBuffers[cb]) {
+            SetGraphicsRootConstantBufferView(draw.constantBufferRootIndices[cb], draw.constantBuffers[cb]);
+            m_state.constantBuffers[cb] = draw.constantBuffers[cb];
+            stats.issued++;
+        }
+        else stats.skipped++;
+    }
+
+    DrawIndexedInstanced(draw.indexCount, draw.instanceCount);
+    stats.drawCalls++;
+    stats.triangles += static_cast<UINT64>(draw.indexCount / 3) * draw.instanceCount;
+}
+
+int GCParallelDrawRecording::GetListCount(int drawCount, int maxListCount, int minDrawsPerList)
+{
+    return std::min(maxListCount, drawCount / minDrawsPerList);
+}
+
+bool GCParallelDrawRecording::Record(GCThreadPool* pThreadPool, int drawCount, int listCount, const std::function<bool(int, int, int, GC_STATE_CHANGE_STATS&)>& recordChunk, GC_STATE_CHANGE_STATS& outStats)
+{
+    GCThreadPool::Partition(drawCount, listCount, m_vRanges);
+
+    int chunkCount = static_cast<int>(m_vRanges.size());
+    m_vStats.assign(chunkCount, GC_STATE_CHANGE_STATS());
+
+    std::atomic<bool> recordingFailed = false;
+    auto recordTask = [&](int listIndex, int)
+    {
+        if (recordChunk(listIndex, m_vRanges[listIndex].first, m_vRanges[listIndex].second, m_vStats[listIndex]) == false)
+            recordingFailed = true;
+    };
+
+    if (pThreadPool)
+        pThreadPool->ParallelFor(chunkCount, recordTask);
+    else
+    {
+        for (int listIndex = 0; listIndex < chunkCount; listIndex++)
+            recordTask(listIndex, 0);
+    }
+
+    for (const GC_STATE_CHANGE_STATS& stats : m_vStats)
+        outStats.Add(stats);
+
+    return recordingFailed == false;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+// Bindings last issued on a command list, a draw only sets what differs from it
+struct GC_COMMAND_LIST_STATE
+{
+	ID3D12PipelineState* pPso = nullptr;
+	ID3D12RootSignature* pRootSignature = nullptr;
+	bool isTopologySet = false;
+
+	D3D12_GPU_VIRTUAL_ADDRESS vertexBufferAddress = 0;
+	UINT vertexBufferSize = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS indexBufferAddress = 0;
+	UINT indexBufferSize = 0;
+
+	// Root arguments, lost when the root signature changes
+	UINT64 textureDescriptor = 0;
+	UINT64 instanceDescriptor = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS constantBuffers[4] = {};
+
+	void InvalidateRootArguments()
+	{
+		textureDescriptor = 0;
+		instanceDescriptor = 0;
+		for (D3D12_GPU_VIRTUAL_ADDRESS& address : constantBuffers)
+			address = 0;
+	}
+};
+
+// Draws and state changes counters of the last recorded frame
+struct GC_STATE_CHANGE_STATS
+{
+	int issued = 0;
+	int skipped = 0;
+
+	int psoChanges = 0;
+	int rootSignatureChanges = 0;
+
+	int drawCalls = 0;
+	UINT64 triangles = 0; // Every instance counted
+
+	void Add(const GC_STATE_CHANGE_STATS& other)
+	{
+		issued += other.issued;
+		skipped += other.skipped;
+		psoChanges += other.psoChanges;
+		rootSignatureChanges += other.rootSignatureChanges;
+		drawCalls += other.drawCalls;
+		triangles += other.triangles;
+	}
+};
+
+// Everything a draw binds, resolved from its GC_DRAW_COMMAND by the render context. Root index -1 : slot unused by the shader
+struct GC_DRAW_BINDINGS
+{
+	ID3D12PipelineState* pPso = nullptr;
+	ID3D12RootSignature* pRootSignature = nullptr;
+
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+	D3D12_INDEX_BUFFER_VIEW indexBufferView = {};
+
+	int textureRootIndex = -1;
+	D3D12_GPU_DESCRIPTOR_HANDLE texture = {};
+	int instanceRootIndex = -1;
+	D3D12_GPU_DESCRIPTOR_HANDLE instances = {};
+
+	// cb0 object, cb1 camera, cb2 material properties, cb3 lights
+	int constantBufferRootIndices[4] = { -1, -1, -1, -1 };
+	D3D12_GPU_VIRTUAL_ADDRESS constantBuffers[4] = {};
+
+	UINT indexCount = 0;
+	UINT instanceCount = 1;
+};
+
+// Destination of the draw recording. RecordDraw filters the bindings against the last ones recorded and only
+// issues the changes, the implementation writes them : GCD3D12DrawRecorder on a command list, a mock in the tests
+class GCDrawRecorder
+{
+public:
+	virtual ~GCDrawRecorder() {}
+
+	// Nothing is known about the list state anymore (freshly reset or bound list) : the next draw sets everything
+	void ResetState();
+	void RecordDraw(const GC_DRAW_BINDINGS& draw, GC_STATE_CHANGE_STATS& stats);
+
+	inline const GC_COMMAND_LIST_STATE& GetState() const { return m_state; }
+
+protected:
+	virtual void SetPipelineState(ID3D12PipelineState* pPso) = 0;
+	virtual void SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature) = 0;
+	virtual void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) = 0;
+	virtual void SetVertexBuffer(const D3D12_VERTEX_BUFFER_VIEW& view) = 0;
+	virtual void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view) = 0;
+	virtual void SetGraphicsRootDescriptorTable(UINT rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor) = 0;
+	virtual void SetGraphicsRootConstantBufferView(UINT rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+	virtual void DrawIndexedInstanced(UINT indexCount, UINT instanceCount) = 0;
+
+private:
+	GC_COMMAND_LIST_STATE m_state;
+};
+
+// Frame draws split in ordered chunks recorded in parallel, one chunk per recording list : chunk i holds the draws
+// following chunk i - 1 and is recorded on list i. Executing the lists in index order keeps the draw order
+class GCParallelDrawRecording
+{
+public:
+	// Lists worth recording drawCount draws on, below 2 the draws are recorded on a single list
+	static int GetListCount(int drawCount, int maxListCount, int minDrawsPerList);
+
+	// Calls recordChunk(listIndex, begin, end, stats) for every chunk on the pool (may be null), recordChunk returns false
+	// when its list failed. Stats of the lists are added to outStats in list order. False when a chunk failed
+	bool Record(GCThreadPool* pThreadPool, int drawCount, int listCount, const std::function<bool(int, int, int, GC_STATE_CHANGE_STATS&)>& recordChunk, GC_STATE_CHANGE_STATS& outStats);
+
+	// Draw range of each list of the last Record
+	inline const std::vector<std::pair<int, int>>& GetRanges() const { return m_vRanges; }
+
+private:
+	std::vector<std::pair<int, int>> m_vRanges;
+	std::vector<GC_STATE_CHANGE_STATS> m_vStats;
+};
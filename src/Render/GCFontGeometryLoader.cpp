@@ -10,6 +10,7 @@ void GCFontGeometryLoader::Initialize(const std::string& metadataFile) {
 }
 
 void GCFontGeometryLoader::LoadMetadata(const std::string& metadataFile) {
+    GC_PROFILE_FUNCTION();
     GCGraphicsLogger& logger = GCGraphicsLogger::GetInstance();
 
     logger.LogInfo("Attempting to open metadata file: " + metadataFile);
@@ -50,6 +51,7 @@ void GCFontGeometryLoader::LoadMetadata(const std::string& metadataFile) {
 }
 
 GCGeometry* GCFontGeometryLoader::CreateText(const std::string& text, DirectX::XMFLOAT4 textColor) {
+    GC_PROFILE_FUNCTION();
     GCGeometry* pGeometry = new GCGeometry;
     m_textColor = textColor;
     GenerateMesh(pGeometry, text);
@@ -155,10 +157,13 @@ void GCFontGeometryLoader::GenerateMesh(GCGeometry* pGeometry, const std::string
 
     pGeometry->vertexNumber = pGeometry->pos.size();
     pGeometry->indiceNumber = pGeometry->indices.size();
+
+    pGeometry->ComputeBounds();
 }
 
 void GCFontGeometryLoader::GenerateFontMetadata(std::string filePath) 
 {
+    GC_PROFILE_FUNCTION();
     std::ofstream outputFile;
 
     if(std::ifstream(filePath).good() == false)
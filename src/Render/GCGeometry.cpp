@@ -1 +1,17 @@
 #include "pch.h"
+
+void GCGeometry::ComputeBounds()
+{
+    if (pos.empty())
+    {
+        boundingBox = DirectX::BoundingBox(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
+        boundingSphere = DirectX::BoundingSphere(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), 0.0f);
+    }
+    else
+    {
+        DirectX::BoundingBox::CreateFromPoints(boundingBox, pos.size(), pos.data(), sizeof(DirectX::XMFLOAT3));
+        DirectX::BoundingSphere::CreateFromBoundingBox(boundingSphere, boundingBox);
+    }
+
+    hasBounds = true;
+}
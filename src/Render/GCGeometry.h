@@ -19,6 +19,13 @@ public:
 	std::vector<DirectX::XMFLOAT3> normals; 
 	std::vector<DirectX::XMFLOAT3> tangents;   
 	std::vector<DirectX::XMFLOAT3> binormals;
+
+	// Local space bounds, refreshed by ComputeBounds once the positions are built
+	DirectX::BoundingBox boundingBox;
+	DirectX::BoundingSphere boundingSphere;
+	bool hasBounds = false;
+
+	void ComputeBounds();
 };
 
 
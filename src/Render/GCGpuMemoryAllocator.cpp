@@ -0,0 +1,303 @@
+#include "pch.h"
+
+GCGpuMemoryAllocator::GCGpuMemoryAllocator()
+    : m_pDevice(nullptr),
+    m_pMemoryTracker(nullptr),
+    m_dedicatedBytes(),
+    m_dedicatedCount()
+{
+}
+
+GCGpuMemoryAllocator::~GCGpuMemoryAllocator()
+{
+    Release();
+}
+
+void GCGpuMemoryAllocator::Initialize(ID3D12Device* pDevice, GCMemoryTracker* pMemoryTracker)
+{
+    Release();
+
+    m_pDevice = pDevice;
+    m_pMemoryTracker = pMemoryTracker;
+}
+
+void GCGpuMemoryAllocator::Release()
+{
+    for (int pool = 0; pool < GC_GPU_POOL_COUNT; pool++)
+    {
+        for (GC_GPU_PAGE* pPage : m_vPages[pool])
+        {
+            if (pPage->allocator.GetAllocationCount() > 0)
+                GCGraphicsLogger::GetInstance().LogWarning("Gpu memory page released with " + std::to_string(pPage->allocator.GetAllocationCount()) + " allocations still in use");
+
+            if (pPage->pBuffer)
+            {
+                if (pPage->pMappedData)
+                    pPage->pBuffer->Unmap(0, nullptr);
+                pPage->pBuffer->Release();
+            }
+            if (pPage->pHeap)
+                pPage->pHeap->Release();
+
+            GC_DELETE(pPage);
+        }
+        m_vPages[pool].clear();
+
+        m_dedicatedBytes[pool] = 0;
+        m_dedicatedCount[pool] = 0;
+    }
+
+    m_pDevice = nullptr;
+    m_pMemoryTracker = nullptr;
+}
+
+GC_MEMORY_CATEGORY GCGpuMemoryAllocator::GetMemoryCategory(GC_GPU_POOL pool)
+{
+    switch (pool)
+    {
+    case GC_GPU_POOL_UPLOAD_BUFFER:
+        return GC_MEMORY_CATEGORY_CONSTANT_BUFFERS;
+    case GC_GPU_POOL_DEFAULT_BUFFER:
+        return GC_MEMORY_CATEGORY_MESHES;
+    case GC_GPU_POOL_RT_DS_TEXTURE:
+        return GC_MEMORY_CATEGORY_RENDER_TARGETS;
+    default:
+        return GC_MEMORY_CATEGORY_TEXTURES;
+    }
+}
+
+void GCGpuMemoryAllocator::TrackAllocation(const GC_GPU_ALLOCATION& allocation, bool isAdded)
+{
+    // Allocation sizes : the page reserve itself is reported by GetStats
+    if (m_pMemoryTracker == nullptr)
+        return;
+
+    if (isAdded)
+        m_pMemoryTracker->Add(GetMemoryCategory(allocation.pool), allocation.size);
+    else
+        m_pMemoryTracker->Remove(GetMemoryCategory(allocation.pool), allocation.size);
+}
+
+bool GCGpuMemoryAllocator::CreatePage(GC_GPU_POOL pool)
+{
+    GC_GPU_PAGE* pPage = new GC_GPU_PAGE();
+    UINT64 pageSize = GetPageSize(pool);
+    HRESULT hr;
+
+    if (IsBufferPool(pool))
+    {
+        bool isUpload = pool == GC_GPU_POOL_UPLOAD_BUFFER;
+        CD3DX12_HEAP_PROPERTIES heapProps(isUpload ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT);
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(pageSize);
+        hr = m_pDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, isUpload ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&pPage->pBuffer));
+        if (GC_CHECK_HRESULT(hr, "Gpu memory buffer page creation") == false)
+        {
+            GC_DELETE(pPage);
+            return false;
+        }
+
+        if (isUpload)
+            pPage->pBuffer->Map(0, nullptr, reinterpret_cast<void**>(&pPage->pMappedData));
+    }
+    else
+    {
+        D3D12_HEAP_DESC heapDesc = {};
+        heapDesc.SizeInBytes = pageSize;
+        heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+        heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        heapDesc.Flags = pool == GC_GPU_POOL_RT_DS_TEXTURE ? D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+        hr = m_pDevice->CreateHeap(&heapDesc, IID_PPV_ARGS(&pPage->pHeap));
+        if (GC_CHECK_HRESULT(hr, "Gpu memory texture heap creation") == false)
+        {
+            GC_DELETE(pPage);
+            return false;
+        }
+    }
+
+    pPage->allocator.Initialize(pageSize, IsBufferPool(pool) ? m_minBufferBlockSize : m_minTextureBlockSize);
+    m_vPages[pool].push_back(pPage);
+
+    return true;
+}
+
+bool GCGpuMemoryAllocator::AllocateBlock(GC_GPU_POOL pool, UINT64 size, UINT64 alignment, int& outPageIndex, UINT64& outOffset)
+{
+    std::vector<GC_GPU_PAGE*>& pages = m_vPages[pool];
+
+    for (int i = 0; i < static_cast<int>(pages.size()); i++)
+    {
+        outOffset = pages[i]->allocator.Allocate(size, alignment);
+        if (outOffset != GCBuddyAllocator::m_invalidOffset)
+        {
+            outPageIndex = i;
+            return true;
+        }
+    }
+
+    if (CreatePage(pool) == false)
+        return false;
+
+    outPageIndex = static_cast<int>(pages.size()) - 1;
+    outOffset = pages.back()->allocator.Allocate(size, alignment);
+
+    return outOffset != GCBuddyAllocator::m_invalidOffset;
+}
+
+bool GCGpuMemoryAllocator::AllocateDedicated(GC_GPU_POOL pool, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* pClearValue, GC_GPU_ALLOCATION& outAllocation)
+{
+    CD3DX12_HEAP_PROPERTIES heapProps(pool == GC_GPU_POOL_UPLOAD_BUFFER ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT);
+    HRESULT hr = m_pDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, initialState, pClearValue, IID_PPV_ARGS(&outAllocation.pResource));
+    if (GC_CHECK_HRESULT(hr, "Gpu memory dedicated resource creation") == false)
+        return false;
+
+    outAllocation.offset = 0;
+    outAllocation.size = m_pDevice->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+    outAllocation.pool = pool;
+    outAllocation.pageIndex = -1;
+    if (pool == GC_GPU_POOL_UPLOAD_BUFFER)
+        outAllocation.pResource->Map(0, nullptr, reinterpret_cast<void**>(&outAllocation.pMappedData));
+
+    m_dedicatedBytes[pool] += outAllocation.size;
+    m_dedicatedCount[pool]++;
+    TrackAllocation(outAllocation, true);
+
+    return true;
+}
+
+bool GCGpuMemoryAllocator::AllocateBuffer(GC_GPU_POOL pool, UINT64 size, UINT64 alignment, GC_GPU_ALLOCATION& outAllocation)
+{
+    outAllocation = GC_GPU_ALLOCATION();
+    if (m_pDevice == nullptr || IsBufferPool(pool) == false || size == 0)
+        return false;
+
+    if (size > m_bufferPageSize)
+    {
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+        return AllocateDedicated(pool, bufferDesc, pool == GC_GPU_POOL_UPLOAD_BUFFER ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COMMON, nullptr, outAllocation);
+    }
+
+    int pageIndex = -1;
+    UINT64 offset = 0;
+    if (AllocateBlock(pool, size, alignment, pageIndex, offset) == false)
+        return false;
+
+    GC_GPU_PAGE* pPage = m_vPages[pool][pageIndex];
+    outAllocation.pResource = pPage->pBuffer;
+    outAllocation.offset = offset;
+    outAllocation.size = GCBuddyAllocator::RoundUpPowerOf2(std::max({ size, alignment, m_minBufferBlockSize }));
+    outAllocation.pMappedData = pPage->pMappedData ? pPage->pMappedData + offset : nullptr;
+    outAllocation.pool = pool;
+    outAllocation.pageIndex = pageIndex;
+    TrackAllocation(outAllocation, true);
+
+    return true;
+}
+
+bool GCGpuMemoryAllocator::CreateTexture(const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* pClearValue, GC_GPU_ALLOCATION& outAllocation)
+{
+    outAllocation = GC_GPU_ALLOCATION();
+    if (m_pDevice == nullptr || desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        return false;
+
+    bool isRenderTarget = (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0;
+    GC_GPU_POOL pool = isRenderTarget ? GC_GPU_POOL_RT_DS_TEXTURE : GC_GPU_POOL_TEXTURE;
+
+    D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = m_pDevice->GetResourceAllocationInfo(0, 1, &desc);
+    if (allocationInfo.SizeInBytes > m_texturePageSize)
+        return AllocateDedicated(pool, desc, initialState, pClearValue, outAllocation);
+
+    int pageIndex = -1;
+    UINT64 offset = 0;
+    if (AllocateBlock(pool, allocationInfo.SizeInBytes, allocationInfo.Alignment, pageIndex, offset) == false)
+        return false;
+
+    GC_GPU_PAGE* pPage = m_vPages[pool][pageIndex];
+    HRESULT hr = m_pDevice->CreatePlacedResource(pPage->pHeap, offset, &desc, initialState, pClearValue, IID_PPV_ARGS(&outAllocation.pResource));
+    if (GC_CHECK_HRESULT(hr, "Gpu memory placed texture creation") == false)
+    {
+        pPage->allocator.Free(offset);
+        return false;
+    }
+
+    outAllocation.offset = offset;
+    outAllocation.size = GCBuddyAllocator::RoundUpPowerOf2(std::max({ allocationInfo.SizeInBytes, allocationInfo.Alignment, m_minTextureBlockSize }));
+    outAllocation.pool = pool;
+    outAllocation.pageIndex = pageIndex;
+    TrackAllocation(outAllocation, true);
+
+    return true;
+}
+
+void GCGpuMemoryAllocator::Free(GC_GPU_ALLOCATION& allocation)
+{
+    if (allocation.IsValid() == false)
+        return;
+
+    TrackAllocation(allocation, false);
+
+    if (allocation.pageIndex < 0)
+    {
+        if (allocation.pMappedData)
+            allocation.pResource->Unmap(0, nullptr);
+        allocation.pResource->Release();
+
+        m_dedicatedBytes[allocation.pool] -= allocation.size;
+        m_dedicatedCount[allocation.pool]--;
+    }
+    else
+    {
+        // Placed textures are their own resource, page buffers are shared
+        if (IsBufferPool(allocation.pool) == false)
+            allocation.pResource->Release();
+
+        m_vPages[allocation.pool][allocation.pageIndex]->allocator.Free(allocation.offset);
+    }
+
+    allocation = GC_GPU_ALLOCATION();
+}
+
+GC_GPU_MEMORY_STATS GCGpuMemoryAllocator::GetStats(GC_GPU_POOL pool) const
+{
+    GC_GPU_MEMORY_STATS stats;
+    UINT64 freeBytes = 0;
+    UINT64 largestFreeBytes = 0;
+
+    for (const GC_GPU_PAGE* pPage : m_vPages[pool])
+    {
+        const GCBuddyAllocator& allocator = pPage->allocator;
+
+        stats.reservedBytes += allocator.GetCapacity();
+        stats.usedBytes += allocator.GetUsedBytes();
+        stats.requestedBytes += allocator.GetRequestedBytes();
+        stats.largestFreeBlock = std::max(stats.largestFreeBlock, allocator.GetLargestFreeBlock());
+        stats.allocationCount += allocator.GetAllocationCount();
+
+        freeBytes += allocator.GetFreeBytes();
+        largestFreeBytes += allocator.GetLargestFreeBlock();
+    }
+
+    stats.pageCount = static_cast<int>(m_vPages[pool].size());
+    stats.dedicatedBytes = m_dedicatedBytes[pool];
+    stats.dedicatedCount = m_dedicatedCount[pool];
+    stats.fragmentation = freeBytes > 0 ? 1.0f - static_cast<float>(largestFreeBytes) / static_cast<float>(freeBytes) : 0.0f;
+
+    return stats;
+}
+
+void GCGpuMemoryAllocator::LogStats() const
+{
+    static const char* poolNames[GC_GPU_POOL_COUNT] = { "Upload buffers", "Default buffers", "Render targets", "Textures" };
+
+    for (int pool = 0; pool < GC_GPU_POOL_COUNT; pool++)
+    {
+        GC_GPU_MEMORY_STATS stats = GetStats(static_cast<GC_GPU_POOL>(pool));
+
+        GCGraphicsLogger::GetInstance().LogInfo(std::string(poolNames[pool])
+            + " : " + std::to_string(stats.pageCount) + " pages, reserved " + std::to_string(stats.reservedBytes)
+            + " B, used " + std::to_string(stats.usedBytes) + " B (requested " + std::to_string(stats.requestedBytes)
+            + " B) in " + std::to_string(stats.allocationCount) + " allocations, largest free block " + std::to_string(stats.largestFreeBlock)
+            + " B, fragmentation " + std::to_string(static_cast<int>(stats.fragmentation * 100.0f))
+            + "%, dedicated " + std::to_string(stats.dedicatedBytes) + " B in " + std::to_string(stats.dedicatedCount));
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// Memory pools, resource heap tier 1 keeps buffers, render targets / depth stencils and other textures apart
+enum GC_GPU_POOL
+{
+	GC_GPU_POOL_UPLOAD_BUFFER, // Sub-allocated ranges of mapped upload buffers : constant buffers
+	GC_GPU_POOL_DEFAULT_BUFFER, // Sub-allocated ranges of default heap buffers : static meshes
+	GC_GPU_POOL_RT_DS_TEXTURE, // Resources placed in default heaps : render targets, depth stencils
+	GC_GPU_POOL_TEXTURE, // Resources placed in default heaps : other textures (uav targets)
+
+	GC_GPU_POOL_COUNT
+};
+
+struct GC_GPU_ALLOCATION
+{
+	// Buffers : the page buffer shared with other allocations. Textures : the placed resource.
+	// Dedicated allocations (larger than a page) : their own committed resource
+	ID3D12Resource* pResource = nullptr;
+	UINT64 offset = 0; // In pResource for buffers, in the page heap for textures
+	UINT64 size = 0; // Block size, what the allocation really costs
+	BYTE* pMappedData = nullptr; // Upload buffers only, at offset
+
+	GC_GPU_POOL pool = GC_GPU_POOL_COUNT;
+	int pageIndex = -1; // -1 : dedicated
+
+	inline bool IsValid() const { return pResource != nullptr; }
+	inline D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress() const { return pResource->GetGPUVirtualAddress() + offset; }
+};
+
+struct GC_GPU_MEMORY_STATS
+{
+	UINT64 reservedBytes = 0; // Pages
+	UINT64 usedBytes = 0; // Blocks in the pages
+	UINT64 requestedBytes = 0; // Sizes asked for, the rest of usedBytes is lost in the power of 2 rounding
+	UINT64 largestFreeBlock = 0;
+	UINT64 dedicatedBytes = 0; // Committed resources larger than a page
+	int pageCount = 0;
+	int allocationCount = 0;
+	int dedicatedCount = 0;
+
+	// Share of the free bytes outside of the largest free block of a page
+	float fragmentation = 0.0f;
+};
+
+// Reserves large pages of GPU memory and places the resources in them with a GCBuddyAllocator per page :
+// thousands of small buffers stop costing a 64KB committed resource each.
+// Pages are kept until the allocator is released, freed blocks are reused by the next allocations
+class GCGpuMemoryAllocator
+{
+public:
+	static constexpr UINT64 m_bufferPageSize = 4 * 1024 * 1024;
+	static constexpr UINT64 m_texturePageSize = 64 * 1024 * 1024;
+	static constexpr UINT64 m_minBufferBlockSize = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT; // 256
+	static constexpr UINT64 m_minTextureBlockSize = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT; // 64KB
+
+	GCGpuMemoryAllocator();
+	~GCGpuMemoryAllocator();
+
+	// pMemoryTracker is optional, the allocations are reported to it in the category of their pool
+	void Initialize(ID3D12Device* pDevice, GCMemoryTracker* pMemoryTracker = nullptr);
+	void Release();
+
+	// Range of a page buffer, alignment up to the block size. Upload ranges are mapped, default ones are COMMON
+	bool AllocateBuffer(GC_GPU_POOL pool, UINT64 size, UINT64 alignment, GC_GPU_ALLOCATION& outAllocation);
+	// Texture placed in a page heap of its pool (render target / depth stencil flags or not)
+	bool CreateTexture(const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* pClearValue, GC_GPU_ALLOCATION& outAllocation);
+	// Releases what the allocation created : its block, and its resource if it isn't a shared page buffer.
+	// The GPU must be done with it (the frames are flushed)
+	void Free(GC_GPU_ALLOCATION& allocation);
+
+	GC_GPU_MEMORY_STATS GetStats(GC_GPU_POOL pool) const;
+	// One line per pool
+	void LogStats() const;
+
+private:
+	struct GC_GPU_PAGE
+	{
+		ID3D12Heap* pHeap = nullptr; // Texture pools
+		ID3D12Resource* pBuffer = nullptr; // Buffer pools
+		BYTE* pMappedData = nullptr; // Upload pool
+		GCBuddyAllocator allocator;
+	};
+
+	bool CreatePage(GC_GPU_POOL pool);
+	bool AllocateDedicated(GC_GPU_POOL pool, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* pClearValue, GC_GPU_ALLOCATION& outAllocation);
+	// Page and offset of a free block, a page is added when none has one
+	bool AllocateBlock(GC_GPU_POOL pool, UINT64 size, UINT64 alignment, int& outPageIndex, UINT64& outOffset);
+
+	static bool IsBufferPool(GC_GPU_POOL pool) { return pool == GC_GPU_POOL_UPLOAD_BUFFER || pool == GC_GPU_POOL_DEFAULT_BUFFER; }
+	static UINT64 GetPageSize(GC_GPU_POOL pool) { return IsBufferPool(pool) ? m_bufferPageSize : m_texturePageSize; }
+	static GC_MEMORY_CATEGORY GetMemoryCategory(GC_GPU_POOL pool);
+	void TrackAllocation(const GC_GPU_ALLOCATION& allocation, bool isAdded);
+
+	ID3D12Device* m_pDevice;
+	GCMemoryTracker* m_pMemoryTracker;
+
+	std::vector<GC_GPU_PAGE*> m_vPages[GC_GPU_POOL_COUNT];
+	UINT64 m_dedicatedBytes[GC_GPU_POOL_COUNT];
+	int m_dedicatedCount[GC_GPU_POOL_COUNT];
+};
@@ -0,0 +1,226 @@
+#include "pch.h"
+
+GCGpuTimer::GCGpuTimer()
+    : m_pQueue(nullptr),
+    m_pQueryHeap(nullptr),
+    m_pReadbackBuffer(nullptr),
+    m_pReadbackData(nullptr),
+    m_timestampFrequency(0),
+    m_calibrationGpuTimestamp(0),
+    m_calibrationProfilerNs(0),
+    m_isCalibrated(false),
+    m_hasResult(false),
+    m_resultFrameIndex(0),
+    m_resultFrameMs(0.0)
+{
+}
+
+GCGpuTimer::~GCGpuTimer()
+{
+    Release();
+}
+
+bool GCGpuTimer::Initialize(ID3D12Device* pDevice, ID3D12CommandQueue* pQueue, UINT32 frameCount, UINT32 maxZonesPerFrame)
+{
+    Release();
+
+    if (GC_CHECK_POINTERSNULL("Gpu timer device and queue are valid", "Can't create gpu timer, device or queue is null", pDevice, pQueue) == false)
+        return false;
+
+    m_pQueue = pQueue;
+    m_ring.Initialize(std::max<UINT32>(frameCount, 2), std::max<UINT32>(maxZonesPerFrame, 1));
+
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    queryHeapDesc.Count = m_ring.GetQueryCount();
+    HRESULT hr = pDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&m_pQueryHeap));
+    if (GC_CHECK_HRESULT(hr, "Timestamp query heap creation") == false)
+    {
+        Release();
+        return false;
+    }
+
+    CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_READBACK);
+    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(static_cast<UINT64>(m_ring.GetQueryCount()) * sizeof(UINT64));
+    hr = pDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&m_pReadbackBuffer));
+    if (GC_CHECK_HRESULT(hr, "Timestamp readback buffer creation") == false)
+    {
+        Release();
+        return false;
+    }
+    m_pReadbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&m_pReadbackData));
+
+    hr = m_pQueue->GetTimestampFrequency(&m_timestampFrequency);
+    if (GC_CHECK_HRESULT(hr, "Timestamp frequency") == false || m_timestampFrequency == 0)
+    {
+        Release();
+        return false;
+    }
+
+    return true;
+}
+
+void GCGpuTimer::Release()
+{
+    if (m_pReadbackBuffer)
+    {
+        m_pReadbackBuffer->Unmap(0, nullptr);
+        m_pReadbackBuffer->Release();
+        m_pReadbackBuffer = nullptr;
+    }
+    m_pReadbackData = nullptr;
+
+    if (m_pQueryHeap)
+    {
+        m_pQueryHeap->Release();
+        m_pQueryHeap = nullptr;
+    }
+
+    m_ring.Initialize(0, 0);
+    m_pQueue = nullptr;
+    m_timestampFrequency = 0;
+    m_isCalibrated = false;
+
+    m_hasResult = false;
+    m_resultFrameMs = 0.0;
+    m_vResultZones.clear();
+}
+
+void GCGpuTimer::BeginFrame(UINT64 frameIndex)
+{
+    if (m_pQueryHeap)
+        m_ring.BeginFrame(frameIndex);
+}
+
+UINT32 GCGpuTimer::BeginZone(ID3D12GraphicsCommandList* pCommandList, const char* name)
+{
+    UINT32 zone = m_ring.BeginZone(name);
+    if (zone != GCGpuTimestampRing::m_invalidZone)
+        pCommandList->EndQuery(m_pQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, m_ring.GetBeginQuery(zone));
+
+    return zone;
+}
+
+void GCGpuTimer::EndZone(ID3D12GraphicsCommandList* pCommandList, UINT32 zone)
+{
+    if (zone == GCGpuTimestampRing::m_invalidZone || m_ring.IsRecording() == false)
+        return;
+
+    pCommandList->EndQuery(m_pQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, m_ring.GetEndQuery(zone));
+    m_ring.EndZone(zone);
+}
+
+void GCGpuTimer::EndFrame(ID3D12GraphicsCommandList* pCommandList)
+{
+    if (m_ring.IsRecording() == false)
+        return;
+
+    // Zones left open end with the frame : every resolved query is written
+    UINT32 zone;
+    while ((zone = m_ring.GetOpenZone()) != GCGpuTimestampRing::m_invalidZone)
+        EndZone(pCommandList, zone);
+
+    UINT32 firstQuery = 0;
+    UINT32 queryCount = 0;
+    if (m_ring.EndFrame(firstQuery, queryCount))
+        pCommandList->ResolveQueryData(m_pQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, firstQuery, queryCount, m_pReadbackBuffer, static_cast<UINT64>(firstQuery) * sizeof(UINT64));
+}
+
+void GCGpuTimer::OnSubmitted(UINT64 fenceValue)
+{
+    m_ring.Submit(fenceValue);
+}
+
+void GCGpuTimer::Update(ID3D12Fence* pFence)
+{
+    if (m_pQueryHeap == nullptr)
+        return;
+
+    UINT64 completedValue = pFence->GetCompletedValue();
+
+    // Calibrated once per update, only the profiler track needs it
+    m_isCalibrated = false;
+
+    int slot;
+    while ((slot = m_ring.GetReadySlot(completedValue)) >= 0)
+    {
+        ReadSlot(slot);
+        m_ring.Retire(slot);
+    }
+}
+
+void GCGpuTimer::ReadSlot(int slot)
+{
+    const std::vector<GCGpuTimestampRing::GC_GPU_TIMESTAMP_ZONE>& zones = m_ring.GetSlotZones(slot);
+    const UINT64* pTimestamps = m_pReadbackData + m_ring.GetFirstQuery(slot);
+
+    UINT64 frameStart = UINT64_MAX;
+    UINT64 frameEnd = 0;
+    for (size_t i = 0; i < zones.size(); i++)
+    {
+        frameStart = std::min(frameStart, pTimestamps[i * 2]);
+        frameEnd = std::max(frameEnd, pTimestamps[i * 2 + 1]);
+    }
+    if (zones.empty() || frameEnd < frameStart)
+        return;
+
+    double msPerTick = 1000.0 / static_cast<double>(m_timestampFrequency);
+
+    m_vResultZones.clear();
+    for (size_t i = 0; i < zones.size(); i++)
+    {
+        UINT64 begin = pTimestamps[i * 2];
+        UINT64 end = std::max(pTimestamps[i * 2 + 1], begin);
+        m_vResultZones.push_back({ zones[i].name, zones[i].depth, (begin - frameStart) * msPerTick, (end - begin) * msPerTick });
+    }
+
+    m_hasResult = true;
+    m_resultFrameIndex = m_ring.GetSlotFrameIndex(slot);
+    m_resultFrameMs = (frameEnd - frameStart) * msPerTick;
+
+    GCProfiler& profiler = GCProfiler::GetInstance();
+    if (profiler.IsCapturing() == false || CalibrateClocks() == false)
+        return;
+
+    for (size_t i = 0; i < zones.size(); i++)
+    {
+        UINT64 begin = pTimestamps[i * 2];
+        UINT64 end = std::max(pTimestamps[i * 2 + 1], begin);
+        profiler.AddZone("GPU", zones[i].name, ToProfilerTimeNs(begin), ToProfilerTimeNs(end), zones[i].depth);
+    }
+}
+
+bool GCGpuTimer::CalibrateClocks()
+{
+    if (m_isCalibrated)
+        return true;
+
+    // Same instant on the GPU clock and on QueryPerformanceCounter, then QueryPerformanceCounter to profiler time
+    UINT64 gpuTimestamp = 0;
+    UINT64 cpuTimestamp = 0;
+    HRESULT hr = m_pQueue->GetClockCalibration(&gpuTimestamp, &cpuTimestamp);
+    if (FAILED(hr))
+        return false;
+
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    INT64 profilerNs = static_cast<INT64>(GCProfiler::GetInstance().GetTimeNs());
+
+    double elapsedNs = static_cast<double>(counter.QuadPart - static_cast<INT64>(cpuTimestamp)) * 1e9 / static_cast<double>(frequency.QuadPart);
+
+    m_calibrationGpuTimestamp = gpuTimestamp;
+    m_calibrationProfilerNs = profilerNs - static_cast<INT64>(elapsedNs);
+    m_isCalibrated = true;
+
+    return true;
+}
+
+UINT64 GCGpuTimer::ToProfilerTimeNs(UINT64 gpuTimestamp) const
+{
+    double deltaNs = static_cast<double>(static_cast<INT64>(gpuTimestamp - m_calibrationGpuTimestamp)) * 1e9 / static_cast<double>(m_timestampFrequency);
+    INT64 timeNs = m_calibrationProfilerNs + static_cast<INT64>(deltaNs);
+
+    return timeNs > 0 ? static_cast<UINT64>(timeNs) : 0;
+}
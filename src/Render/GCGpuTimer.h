@@ -0,0 +1,66 @@
+#pragma once
+
+struct GC_GPU_ZONE_TIMING
+{
+	const char* name;
+	UINT32 depth;
+	double startMs; // From the first zone of the frame
+	double durationMs;
+};
+
+// GPU time of the passes of a frame : timestamps written around them on the direct queue, resolved in a readback
+// buffer and read frames later once their fence is reached. Never waits for the GPU
+class GCGpuTimer
+{
+public:
+	static constexpr UINT32 m_defaultFrameCount = 3;
+	static constexpr UINT32 m_defaultMaxZonesPerFrame = 32;
+
+	GCGpuTimer();
+	~GCGpuTimer();
+
+	bool Initialize(ID3D12Device* pDevice, ID3D12CommandQueue* pQueue, UINT32 frameCount = m_defaultFrameCount, UINT32 maxZonesPerFrame = m_defaultMaxZonesPerFrame);
+	void Release();
+
+	void BeginFrame(UINT64 frameIndex);
+	// Zone index for EndZone, ignored (m_invalidZone) when the frame isn't timed
+	UINT32 BeginZone(ID3D12GraphicsCommandList* pCommandList, const char* name);
+	void EndZone(ID3D12GraphicsCommandList* pCommandList, UINT32 zone);
+	// Records the resolve of the frame queries, on the last command list of the frame
+	void EndFrame(ID3D12GraphicsCommandList* pCommandList);
+	void OnSubmitted(UINT64 fenceValue);
+
+	// Reads every finished frame, the latest one is the result. Zones are sent to the profiler GPU track
+	void Update(ID3D12Fence* pFence);
+
+	inline bool HasResult() const { return m_hasResult; }
+	inline UINT64 GetResultFrame() const { return m_resultFrameIndex; }
+	inline const std::vector<GC_GPU_ZONE_TIMING>& GetResultZones() const { return m_vResultZones; }
+	// First zone start to last zone end of the result frame
+	inline double GetResultFrameMs() const { return m_resultFrameMs; }
+	inline bool HasPendingFrame() const { return m_ring.IsRecording(); }
+
+private:
+	void ReadSlot(int slot);
+	// Profiler time (ns) of a GPU timestamp, from the queue clock calibration
+	bool CalibrateClocks();
+	UINT64 ToProfilerTimeNs(UINT64 gpuTimestamp) const;
+
+	ID3D12CommandQueue* m_pQueue;
+	ID3D12QueryHeap* m_pQueryHeap;
+	ID3D12Resource* m_pReadbackBuffer;
+	UINT64* m_pReadbackData; // Persistently mapped
+
+	GCGpuTimestampRing m_ring;
+	UINT64 m_timestampFrequency; // Ticks per second
+
+	// GPU timestamp / QueryPerformanceCounter pair and the profiler time at the calibration
+	UINT64 m_calibrationGpuTimestamp;
+	INT64 m_calibrationProfilerNs;
+	bool m_isCalibrated;
+
+	bool m_hasResult;
+	UINT64 m_resultFrameIndex;
+	double m_resultFrameMs;
+	std::vector<GC_GPU_ZONE_TIMING> m_vResultZones;
+};
@@ -0,0 +1,160 @@
+#include "pch.h"
+
+GCGpuTimestampRing::GCGpuTimestampRing()
+    : m_frameCount(0),
+    m_maxZonesPerFrame(0),
+    m_nextSlot(0),
+    m_recordingSlot(-1),
+    m_closedSlot(-1),
+    m_openDepth(0),
+    m_skippedFrameCount(0)
+{
+}
+
+void GCGpuTimestampRing::Initialize(UINT32 frameCount, UINT32 maxZonesPerFrame)
+{
+    m_frameCount = frameCount;
+    m_maxZonesPerFrame = maxZonesPerFrame;
+
+    m_vSlots.assign(m_frameCount, GC_TIMESTAMP_SLOT());
+    for (GC_TIMESTAMP_SLOT& slot : m_vSlots)
+        slot.vZones.reserve(m_maxZonesPerFrame);
+
+    m_submittedSlots.clear();
+    m_nextSlot = 0;
+    m_recordingSlot = -1;
+    m_closedSlot = -1;
+    m_openDepth = 0;
+    m_skippedFrameCount = 0;
+}
+
+bool GCGpuTimestampRing::BeginFrame(UINT64 frameIndex)
+{
+    if (m_vSlots.empty())
+        return false;
+
+    // Ended but never submitted : its queries are never read
+    if (m_closedSlot >= 0)
+    {
+        m_vSlots[m_closedSlot].state = GC_TIMESTAMP_SLOT_FREE;
+        m_vSlots[m_closedSlot].vZones.clear();
+        m_closedSlot = -1;
+    }
+
+    // Previous frame never ended : its slot is reused
+    if (m_recordingSlot < 0)
+    {
+        if (m_vSlots[m_nextSlot].state != GC_TIMESTAMP_SLOT_FREE)
+        {
+            m_skippedFrameCount++;
+            return false;
+        }
+
+        m_recordingSlot = m_nextSlot;
+        m_nextSlot = (m_nextSlot + 1) % static_cast<int>(m_frameCount);
+    }
+
+    GC_TIMESTAMP_SLOT& slot = m_vSlots[m_recordingSlot];
+    slot.state = GC_TIMESTAMP_SLOT_RECORDING;
+    slot.frameIndex = frameIndex;
+    slot.vZones.clear();
+    m_openDepth = 0;
+
+    return true;
+}
+
+UINT32 GCGpuTimestampRing::BeginZone(const char* name)
+{
+    if (m_recordingSlot < 0)
+        return m_invalidZone;
+
+    std::vector<GC_GPU_TIMESTAMP_ZONE>& zones = m_vSlots[m_recordingSlot].vZones;
+    if (zones.size() >= m_maxZonesPerFrame)
+        return m_invalidZone;
+
+    zones.push_back({ name, m_openDepth, false });
+    m_openDepth++;
+
+    return static_cast<UINT32>(zones.size() - 1);
+}
+
+void GCGpuTimestampRing::EndZone(UINT32 zone)
+{
+    if (m_recordingSlot < 0)
+        return;
+
+    std::vector<GC_GPU_TIMESTAMP_ZONE>& zones = m_vSlots[m_recordingSlot].vZones;
+    if (zone >= zones.size() || zones[zone].isEnded)
+        return;
+
+    zones[zone].isEnded = true;
+    if (m_openDepth > 0)
+        m_openDepth--;
+}
+
+UINT32 GCGpuTimestampRing::GetOpenZone() const
+{
+    if (m_recordingSlot < 0)
+        return m_invalidZone;
+
+    const std::vector<GC_GPU_TIMESTAMP_ZONE>& zones = m_vSlots[m_recordingSlot].vZones;
+    for (UINT32 zone = static_cast<UINT32>(zones.size()); zone-- > 0;)
+    {
+        if (zones[zone].isEnded == false)
+            return zone;
+    }
+
+    return m_invalidZone;
+}
+
+bool GCGpuTimestampRing::EndFrame(UINT32& outFirstQuery, UINT32& outQueryCount)
+{
+    if (m_recordingSlot < 0)
+        return false;
+
+    int slot = m_recordingSlot;
+    m_recordingSlot = -1;
+
+    // Nothing to resolve, the slot is free again
+    if (m_vSlots[slot].vZones.empty())
+    {
+        m_vSlots[slot].state = GC_TIMESTAMP_SLOT_FREE;
+        return false;
+    }
+
+    m_vSlots[slot].state = GC_TIMESTAMP_SLOT_CLOSED;
+    m_closedSlot = slot;
+
+    outFirstQuery = GetFirstQuery(slot);
+    outQueryCount = static_cast<UINT32>(m_vSlots[slot].vZones.size()) * 2;
+
+    return true;
+}
+
+void GCGpuTimestampRing::Submit(UINT64 fenceValue)
+{
+    if (m_closedSlot < 0)
+        return;
+
+    m_vSlots[m_closedSlot].state = GC_TIMESTAMP_SLOT_SUBMITTED;
+    m_vSlots[m_closedSlot].fenceValue = fenceValue;
+    m_submittedSlots.push_back(m_closedSlot);
+    m_closedSlot = -1;
+}
+
+int GCGpuTimestampRing::GetReadySlot(UINT64 completedFenceValue) const
+{
+    if (m_submittedSlots.empty() || m_vSlots[m_submittedSlots.front()].fenceValue > completedFenceValue)
+        return -1;
+
+    return m_submittedSlots.front();
+}
+
+void GCGpuTimestampRing::Retire(int slot)
+{
+    if (m_submittedSlots.empty() == false && m_submittedSlots.front() == slot)
+        m_submittedSlots.pop_front();
+
+    m_vSlots[slot].state = GC_TIMESTAMP_SLOT_FREE;
+    m_vSlots[slot].vZones.clear();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+// Timestamp query slots of the frames in flight, pure bookkeeping : no device object, GCGpuTimer maps it
+// on its query heap and readback buffer. Frame slot s owns the queries [s * 2 * maxZones, (s + 1) * 2 * maxZones),
+// zone z of a frame its begin query 2z and end query 2z + 1
+class GCGpuTimestampRing
+{
+public:
+	static constexpr UINT32 m_invalidZone = UINT32_MAX;
+
+	struct GC_GPU_TIMESTAMP_ZONE
+	{
+		const char* name; // String literal
+		UINT32 depth;
+		bool isEnded;
+	};
+
+	GCGpuTimestampRing();
+
+	void Initialize(UINT32 frameCount, UINT32 maxZonesPerFrame);
+
+	// Opens the next free slot, false when every slot still waits for the GPU : the frame isn't timed.
+	// A frame ended but never submitted is dropped, its slot is free again
+	bool BeginFrame(UINT64 frameIndex);
+	// m_invalidZone when no frame is open or the frame is full
+	UINT32 BeginZone(const char* name);
+	void EndZone(UINT32 zone);
+	// Innermost zone of the open frame still open, m_invalidZone when none. EndFrame resolves every zone : they are ended first
+	UINT32 GetOpenZone() const;
+	// Queries to resolve, the slot waits for Submit
+	bool EndFrame(UINT32& outFirstQuery, UINT32& outQueryCount);
+	// Fence value signaled after the command list of the last EndFrame
+	void Submit(UINT64 fenceValue);
+
+	// Oldest submitted slot reached by completedFenceValue, -1 when none. Read it, then Retire it
+	int GetReadySlot(UINT64 completedFenceValue) const;
+	void Retire(int slot);
+
+	inline bool IsRecording() const { return m_recordingSlot >= 0; }
+	inline int GetRecordingSlot() const { return m_recordingSlot; }
+	inline UINT32 GetQueryCount() const { return m_frameCount * m_maxZonesPerFrame * 2; }
+	inline UINT32 GetFirstQuery(int slot) const { return static_cast<UINT32>(slot) * m_maxZonesPerFrame * 2; }
+	inline UINT32 GetBeginQuery(UINT32 zone) const { return GetFirstQuery(m_recordingSlot) + zone * 2; }
+	inline UINT32 GetEndQuery(UINT32 zone) const { return GetBeginQuery(zone) + 1; }
+
+	inline UINT64 GetSlotFrameIndex(int slot) const { return m_vSlots[slot].frameIndex; }
+	inline const std::vector<GC_GPU_TIMESTAMP_ZONE>& GetSlotZones(int slot) const { return m_vSlots[slot].vZones; }
+	inline UINT64 GetSkippedFrameCount() const { return m_skippedFrameCount; }
+
+private:
+	enum GC_TIMESTAMP_SLOT_STATE
+	{
+		GC_TIMESTAMP_SLOT_FREE,
+		GC_TIMESTAMP_SLOT_RECORDING,
+		GC_TIMESTAMP_SLOT_CLOSED, // Resolve recorded, waiting for Submit
+		GC_TIMESTAMP_SLOT_SUBMITTED,
+	};
+
+	struct GC_TIMESTAMP_SLOT
+	{
+		GC_TIMESTAMP_SLOT_STATE state = GC_TIMESTAMP_SLOT_FREE;
+		UINT64 frameIndex = 0;
+		UINT64 fenceValue = 0;
+		std::vector<GC_GPU_TIMESTAMP_ZONE> vZones;
+	};
+
+	UINT32 m_frameCount;
+	UINT32 m_maxZonesPerFrame;
+
+	std::vector<GC_TIMESTAMP_SLOT> m_vSlots;
+	std::deque<int> m_submittedSlots; // Submission order
+	int m_nextSlot;
+	int m_recordingSlot;
+	int m_closedSlot;
+	UINT32 m_openDepth;
+
+	UINT64 m_skippedFrameCount;
+};
@@ -4,18 +4,24 @@ GCGraphics::GCGraphics()
     : m_pRender(nullptr),
     m_pPrimitiveFactory(nullptr),
     m_pModelParserFactory(nullptr),
-    m_pCbLightPropertiesInstance(nullptr)
+    m_pCbLightPropertiesInstance(nullptr),
+    m_pShaderColorTemplate(nullptr),
+    m_pShaderTextureTemplate(nullptr),
+    m_hasEndedFrame(false)
 {
     m_lTextureActiveFlags.clear();
     m_lTextures.clear();
     m_vShaders.clear();
     m_vMaterials.clear();
     m_vMeshes.clear();
+    m_primitiveMeshes.clear();
     m_cbCameraInstances.clear();
 }
 
 GCGraphics::~GCGraphics()
 {
+    ReleaseRetiredConstantBuffers(true);
+
     for (auto shader : m_vShaders)
     {
         GC_DELETE(shader);
@@ -34,6 +40,9 @@ GCGraphics::~GCGraphics()
     }
     m_vMeshes.clear();
 
+    // Meshes are in m_vMeshes
+    m_primitiveMeshes.clear();
+
     for (auto texture : m_lTextures)
     {
         GC_DELETE(texture);
@@ -56,6 +65,8 @@ bool GCGraphics::Initialize(Window* pWindow, int renderWidth,int renderHeight)
     if (GC_CHECK_POINTERSNULL("Graphics Initialized with window sucessfully", "Can't initialize Graphics, Window is empty", pWindow) == false)
         return false;
 
+    GC_PROFILE_THREAD_NAME("Main");
+
     //Creates Primitive and parser instances
     m_pPrimitiveFactory = new GCPrimitiveFactory();
     m_pModelParserFactory = new GCModelParserObj();
@@ -68,7 +79,7 @@ bool GCGraphics::Initialize(Window* pWindow, int renderWidth,int renderHeight)
     m_pRender = new GCRenderContext();
     m_pRender->Initialize(pWindow, renderWidth, renderHeight, this);
 
-	GCShaderUploadBufferBase* pCbInstance = new GCShaderUploadBuffer<GCVIEWPROJCB>(m_pRender->GetRenderResources()->Getmd3dDevice(), 1, true);
+	GCShaderUploadBufferBase* pCbInstance = new GCShaderUploadBuffer<GCVIEWPROJCB>(m_pRender->GetRenderResources()->GetGpuAllocator(), 1, true);
     m_cbCameraInstances.push_back(pCbInstance);
 
     return true;
@@ -76,7 +87,8 @@ bool GCGraphics::Initialize(Window* pWindow, int renderWidth,int renderHeight)
 
 bool GCGraphics::StartFrame()
 {
-    m_pRender->m_materialsUsedInFrame.clear();
+    GC_PROFILE_FRAME(m_pRender->GetFrameIndex());
+    GC_PROFILE_FUNCTION();
 
     for (auto& material : m_vMaterials)
     {
@@ -91,11 +103,23 @@ bool GCGraphics::StartFrame()
 };
 bool GCGraphics::EndFrame()
 {
+    GC_PROFILE_FUNCTION();
     GCGraphicsLogger& profiler = GCGraphicsLogger::GetInstance();
 
     m_pRender->CompleteDraw();
 
+    m_frameStats = m_pRender->GetFrameStats();
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (m_hasEndedFrame)
+        m_frameStats.cpuFrameMs = std::chrono::duration<double, std::milli>(now - m_lastEndFrameTime).count();
+    m_lastEndFrameTime = now;
+    m_hasEndedFrame = true;
+
+    // The cb count of a material is its draws of the frame
     for (int i = 0; i < m_vMaterials.size(); i++) {
+        if (m_vMaterials[i]->GetCount() > 0)
+            m_frameStats.materialsUsed++;
         m_vMaterials[i]->ResetCBCount();
     }
 
@@ -106,17 +130,17 @@ bool GCGraphics::EndFrame()
         {
             if (cbObject->m_isUsed)
                 cbObject->m_framesSinceLastUse = 0;
-            if (!cbObject->m_isUsed)
-            {
+            else
                 cbObject->m_framesSinceLastUse++;
-                if (cbObject->m_framesSinceLastUse > 180)
-                {
-                    profiler.LogInfo("Constant buffer inutilisé trouvé dans le matériau : ");
-                }
-            }
         }
     }
 
+    TrimConstantBuffers();
+    ReleaseRetiredConstantBuffers(false);
+
+    if (m_memoryReportFile.is_open())
+        m_memoryReportFile << GetMemoryReportJson() << '\n';
+
     return true;
 };
 
@@ -144,6 +168,7 @@ bool GCGraphics::InitializeGraphicsResourcesEnd() {
 
 
 GC_RESOURCE_CREATION_RESULT<GCTexture*> GCGraphics::CreateTexture(const std::string& filePath) {
+    GC_PROFILE_FUNCTION();
     GCGraphicsLogger& profiler = GCGraphicsLogger::GetInstance();
 
     // Creates and initializes a texture using a path
@@ -184,6 +209,10 @@ GC_RESOURCE_CREATION_RESULT<GCTexture*> GCGraphics::CreateTexture(const std::str
         return GC_RESOURCE_CREATION_RESULT<GCTexture*>(false, nullptr, errorState);
     }
 
+    // The upload copy is kept as long as the texture
+    GCRenderResources* pResources = m_pRender->GetRenderResources();
+    pResources->GetMemoryTracker()->Add(GC_MEMORY_CATEGORY_TEXTURES, pResources->GetResourceSize(texture->GetTextureBuffer()) + pResources->GetResourceSize(texture->GetUploadTexture()));
+
     // Return the result of the creation operation
     return GC_RESOURCE_CREATION_RESULT<GCTexture*>(true, texture, errorState);
 }
@@ -238,6 +267,33 @@ GC_RESOURCE_CREATION_RESULT<GCShader*> GCGraphics::CreateShaderTexture()
     return GC_RESOURCE_CREATION_RESULT<GCShader*>(true, pShader, errorState);
 }
 
+GC_RESOURCE_CREATION_RESULT<GCShader*> GCGraphics::CreateShaderParticle()
+{
+    GCShader* pShader = new GCShader();
+
+    int vertexFlags = 0;
+    GC_SET_FLAG(vertexFlags, GC_VERTEX_POSITION);
+    GC_SET_FLAG(vertexFlags, GC_VERTEX_UV);
+
+    // t0 texture, t1 particles
+    int rootParametersFlag = 0;
+    GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_CB0);
+    GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_CB1);
+    GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT1);
+    GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT2);
+
+    GC_GRAPHICS_ERROR errorState = pShader->Initialize(m_pRender, "../../../res/Shaders/particle.hlsl", "../../../res/CsoCompiled/particle", vertexFlags, D3D12_CULL_MODE_BACK, rootParametersFlag);
+    if (errorState != 0)
+        return GC_RESOURCE_CREATION_RESULT<GCShader*>(false, nullptr, errorState);
+    errorState = pShader->Load();
+    if (errorState != 0)
+        return GC_RESOURCE_CREATION_RESULT<GCShader*>(false, nullptr, errorState);
+
+    m_vShaders.push_back(pShader);
+
+    return GC_RESOURCE_CREATION_RESULT<GCShader*>(true, pShader, errorState);
+}
+
 // Specify the path, with the name of the shader at the file creation , example : CsoCompiled/texture, texture is the name of the file in Cso Compiled Folder
 GC_RESOURCE_CREATION_RESULT<GCShader*> GCGraphics::CreateShaderCustom(std::string& filePath, std::string& compiledShaderDestinationPath, int& flagEnabledBits, D3D12_CULL_MODE cullMode, int flagRootParameters)
 {
@@ -255,7 +311,7 @@ GC_RESOURCE_CREATION_RESULT<GCShader*> GCGraphics::CreateShaderCustom(std::strin
     return GC_RESOURCE_CREATION_RESULT<GCShader*>(true, pShader, errorState);
 }
 
-GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshCustom(GCGeometry* pGeometry, int& flagEnabledBits)
+GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshCustom(GCGeometry* pGeometry, int& flagEnabledBits, GC_MESH_STORAGE storage)
 {
     if (GC_CHECK_POINTERSNULL("Geometry loaded successfully for mesh", "Can't create mesh, Geometry is empty", pGeometry) == false)
     {
@@ -264,7 +320,7 @@ GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshCustom(GCGeometry* pG
 
     GCMesh* pMesh = new GCMesh();
 
-    GC_GRAPHICS_ERROR errorState = pMesh->Initialize(m_pRender, pGeometry, flagEnabledBits);
+    GC_GRAPHICS_ERROR errorState = pMesh->Initialize(m_pRender, pGeometry, flagEnabledBits, storage);
     if (errorState != 0)
         return GC_RESOURCE_CREATION_RESULT<GCMesh*>(false, nullptr, errorState);
 
@@ -274,7 +330,7 @@ GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshCustom(GCGeometry* pG
 
 }
 
-GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshColor(GCGeometry* pGeometry)
+GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshColor(GCGeometry* pGeometry, GC_MESH_STORAGE storage)
 {
     int flagsLightColor = 0;
     GC_SET_FLAG(flagsLightColor, GC_VERTEX_POSITION);
@@ -286,7 +342,7 @@ GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshColor(GCGeometry* pGe
 
     GCMesh* pMesh = new GCMesh();
 
-    GC_GRAPHICS_ERROR errorState = pMesh->Initialize(m_pRender, pGeometry, flagsLightColor);
+    GC_GRAPHICS_ERROR errorState = pMesh->Initialize(m_pRender, pGeometry, flagsLightColor, storage);
     if (errorState != 0)
         return GC_RESOURCE_CREATION_RESULT<GCMesh*>(false, nullptr, errorState);
 
@@ -295,7 +351,7 @@ GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshColor(GCGeometry* pGe
     return GC_RESOURCE_CREATION_RESULT<GCMesh*>(true, pMesh, errorState);
 }
 
-GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshTexture(GCGeometry* pGeometry)
+GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshTexture(GCGeometry* pGeometry, GC_MESH_STORAGE storage)
 {
     int flagsLightTexture = 0;
     GC_SET_FLAG(flagsLightTexture, GC_VERTEX_POSITION);
@@ -307,7 +363,7 @@ GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshTexture(GCGeometry* p
 
     GCMesh* pMesh = new GCMesh();
 
-    GC_GRAPHICS_ERROR errorState = pMesh->Initialize(m_pRender, pGeometry, flagsLightTexture);
+    GC_GRAPHICS_ERROR errorState = pMesh->Initialize(m_pRender, pGeometry, flagsLightTexture, storage);
     if (errorState != 0)
         return GC_RESOURCE_CREATION_RESULT<GCMesh*>(false, nullptr, errorState);
 
@@ -316,6 +372,62 @@ GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::CreateMeshTexture(GCGeometry* p
     return GC_RESOURCE_CREATION_RESULT<GCMesh*>(true, pMesh, errorState);
 }
 
+GC_RESOURCE_CREATION_RESULT<GCMesh*> GCGraphics::GetPrimitiveMesh(const GC_PRIMITIVE_ID primitiveIndex, int flagEnabledBits, const DirectX::XMFLOAT4& color)
+{
+    // Color only matters when the mesh carries it, a textured quad is the same whatever the color asked
+    uint32_t packedColor = 0;
+    if (GC_HAS_FLAG(flagEnabledBits, GC_VERTEX_COLOR))
+    {
+        DirectX::PackedVector::XMCOLOR colorPacked;
+        DirectX::PackedVector::XMStoreColor(&colorPacked, DirectX::XMLoadFloat4(&color));
+        packedColor = colorPacked.c;
+    }
+
+    uint64_t key = (static_cast<uint64_t>(primitiveIndex) << 48) | (static_cast<uint64_t>(flagEnabledBits & 0xFFFF) << 32) | packedColor;
+
+    auto it = m_primitiveMeshes.find(key);
+    if (it != m_primitiveMeshes.end())
+        return GC_RESOURCE_CREATION_RESULT<GCMesh*>(true, it->second, GCRENDER_SUCCESS_OK);
+
+    auto geometry = CreateGeometryPrimitive(primitiveIndex, color);
+    if (geometry.success == false)
+        return GC_RESOURCE_CREATION_RESULT<GCMesh*>(false, nullptr, geometry.errorState);
+
+    // Gpu only : the mesh doesn't keep the geometry once its buffers are filled
+    auto mesh = CreateMeshCustom(geometry.resource, flagEnabledBits, GC_MESH_STORAGE_GPU_ONLY);
+    delete geometry.resource;
+    if (mesh.success == false)
+        return GC_RESOURCE_CREATION_RESULT<GCMesh*>(false, nullptr, mesh.errorState);
+
+    m_primitiveMeshes.emplace(key, mesh.resource);
+
+    return mesh;
+}
+
+GC_RESOURCE_CREATION_RESULT<GCShader*> GCGraphics::GetShaderColor()
+{
+    if (m_pShaderColorTemplate)
+        return GC_RESOURCE_CREATION_RESULT<GCShader*>(true, m_pShaderColorTemplate, GCRENDER_SUCCESS_OK);
+
+    auto shader = CreateShaderColor();
+    if (shader.success)
+        m_pShaderColorTemplate = shader.resource;
+
+    return shader;
+}
+
+GC_RESOURCE_CREATION_RESULT<GCShader*> GCGraphics::GetShaderTexture()
+{
+    if (m_pShaderTextureTemplate)
+        return GC_RESOURCE_CREATION_RESULT<GCShader*>(true, m_pShaderTextureTemplate, GCRENDER_SUCCESS_OK);
+
+    auto shader = CreateShaderTexture();
+    if (shader.success)
+        m_pShaderTextureTemplate = shader.resource;
+
+    return shader;
+}
+
 GC_RESOURCE_CREATION_RESULT<GCGeometry*> GCGraphics::CreateGeometryPrimitive(const GC_PRIMITIVE_ID primitiveIndex, const DirectX::XMFLOAT4& color)
 {
     GCGeometry* pGeometry = new GCGeometry();
@@ -362,6 +474,8 @@ GC_RESOURCE_CREATION_RESULT<GCMaterial*> GCGraphics::CreateMaterial(GCShader* pS
     material->m_materialId = static_cast<float>(m_vMaterials.size());
     m_vMaterials.push_back(material);
 
+    m_pRender->UpdateMaterialDsl(material);
+
     return GC_RESOURCE_CREATION_RESULT<GCMaterial*>(true, material, errorState);
 }
 
@@ -380,6 +494,156 @@ std::vector<GCMesh*> GCGraphics::GetMeshes()
     return m_vMeshes;
 }
 
+GC_MESH_MEMORY GCGraphics::LogMeshMemoryReport()
+{
+    GCGraphicsLogger& logger = GCGraphicsLogger::GetInstance();
+    GC_MESH_MEMORY total;
+
+    for (size_t i = 0; i < m_vMeshes.size(); i++)
+    {
+        GC_MESH_MEMORY memory = m_vMeshes[i]->GetMemoryUsage();
+        total.Add(memory);
+
+        logger.LogInfo("Mesh " + std::to_string(i)
+            + (m_vMeshes[i]->IsEditable() ? " (editable)" : "")
+            + (m_vMeshes[i]->HasStaticBuffers() ? " (static)" : "")
+            + " : vertices " + std::to_string(memory.vertexBufferBytes)
+            + " B, indices " + std::to_string(memory.indexBufferBytes)
+            + " B, gpu allocated " + std::to_string(memory.gpuAllocatedBytes)
+            + " B, cpu copy " + std::to_string(memory.cpuCopyBytes)
+            + " B, geometry " + std::to_string(memory.geometryBytes) + " B");
+    }
+
+    logger.LogInfo(std::to_string(m_vMeshes.size()) + " meshes : vertices " + std::to_string(total.vertexBufferBytes)
+        + " B, indices " + std::to_string(total.indexBufferBytes)
+        + " B, gpu allocated " + std::to_string(total.gpuAllocatedBytes)
+        + " B, cpu copy " + std::to_string(total.cpuCopyBytes)
+        + " B, geometry " + std::to_string(total.geometryBytes) + " B");
+
+    return total;
+}
+
+void GCGraphics::SetConstantBufferTrimPolicy(const GC_CB_TRIM_POLICY& policy)
+{
+    m_cbTrimPolicy = policy;
+    m_cbTrimPolicy.unusedFrameThreshold = std::max(m_cbTrimPolicy.unusedFrameThreshold, 1);
+    m_cbTrimPolicy.minKeptCount = std::max(m_cbTrimPolicy.minKeptCount, 0);
+    m_cbTrimPolicy.maxTrimCountPerFrame = std::max(m_cbTrimPolicy.maxTrimCountPerFrame, 1);
+}
+
+void GCGraphics::TrimConstantBuffers()
+{
+    m_cbTrimStats.lastFrameTrimmedCount = 0;
+
+    if (m_cbTrimPolicy.isEnabled)
+    {
+        // Every submission that drew with them is signaled : CompleteDraw is done
+        UINT64 fenceValue = m_pRender->GetRenderResources()->GetCurrentFenceValue();
+        std::vector<GCShaderUploadBufferBase*> vTrimmed;
+
+        for (GCMaterial* pMaterial : m_vMaterials)
+        {
+            int maxTrimCount = m_cbTrimPolicy.maxTrimCountPerFrame - m_cbTrimStats.lastFrameTrimmedCount;
+            if (maxTrimCount <= 0)
+                break;
+
+            m_cbTrimStats.lastFrameTrimmedCount += pMaterial->TrimCbPerObject(m_cbTrimPolicy.unusedFrameThreshold, m_cbTrimPolicy.minKeptCount, maxTrimCount, vTrimmed);
+        }
+
+        for (GCShaderUploadBufferBase* pBuffer : vTrimmed)
+        {
+            m_retiredConstantBuffers.push_back({ fenceValue, pBuffer });
+            m_cbTrimStats.pendingCount++;
+            m_cbTrimStats.pendingBytes += pBuffer->GetAllocatedSize();
+        }
+        m_cbTrimStats.totalTrimmedCount += vTrimmed.size();
+    }
+
+    m_cbTrimStats.liveCount = 0;
+    m_cbTrimStats.liveBytes = 0;
+    for (GCMaterial* pMaterial : m_vMaterials)
+    {
+        for (GCShaderUploadBufferBase* pBuffer : pMaterial->GetCbObjectInstance())
+        {
+            m_cbTrimStats.liveCount++;
+            m_cbTrimStats.liveBytes += pBuffer->GetAllocatedSize();
+        }
+    }
+}
+
+void GCGraphics::ReleaseRetiredConstantBuffers(bool isForced)
+{
+    if (m_retiredConstantBuffers.empty())
+        return;
+
+    UINT64 completedValue = isForced ? UINT64_MAX : m_pRender->GetRenderResources()->GetFence()->GetCompletedValue();
+
+    while (m_retiredConstantBuffers.empty() == false && m_retiredConstantBuffers.front().first <= completedValue)
+    {
+        GCShaderUploadBufferBase* pBuffer = m_retiredConstantBuffers.front().second;
+        UINT64 allocatedSize = pBuffer->GetAllocatedSize();
+
+        m_cbTrimStats.pendingCount--;
+        m_cbTrimStats.pendingBytes -= allocatedSize;
+        m_cbTrimStats.totalReclaimedBytes += allocatedSize;
+
+        GC_DELETE(pBuffer);
+        m_retiredConstantBuffers.pop_front();
+    }
+}
+
+GC_MEMORY_USAGE GCGraphics::GetMemoryUsage()
+{
+    GCRenderResources* pResources = m_pRender->GetRenderResources();
+
+    // Descriptors are measured, the other categories are kept up to date by the resources
+    int textureDescriptorCount = static_cast<int>(std::count(m_lTextureActiveFlags.begin(), m_lTextureActiveFlags.end(), true));
+    pResources->UpdateDescriptorMemory(textureDescriptorCount);
+
+    return pResources->GetMemoryTracker()->GetUsage();
+}
+
+void GCGraphics::SetMemoryBudget(GC_MEMORY_CATEGORY category, UINT64 budgetBytes)
+{
+    GCMemoryTracker* pTracker = m_pRender->GetRenderResources()->GetMemoryTracker();
+
+    if (category == GC_MEMORY_CATEGORY_COUNT)
+        pTracker->SetTotalBudget(budgetBytes);
+    else
+        pTracker->SetBudget(category, budgetBytes);
+}
+
+void GCGraphics::ResetMemoryHighWater()
+{
+    m_pRender->GetRenderResources()->GetMemoryTracker()->ResetHighWater();
+}
+
+std::string GCGraphics::GetMemoryReportJson()
+{
+    GetMemoryUsage();
+
+    return m_pRender->GetRenderResources()->GetMemoryTracker()->ToJson(m_pRender->GetFrameIndex());
+}
+
+bool GCGraphics::ActiveMemoryReportDump(const std::string& filePath)
+{
+    DesactiveMemoryReportDump();
+
+    m_memoryReportFile.open(filePath, std::ios::out | std::ios::trunc);
+    if (m_memoryReportFile.is_open() == false)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Can't open memory report file : " + filePath);
+        return false;
+    }
+    return true;
+}
+
+void GCGraphics::DesactiveMemoryReportDump()
+{
+    if (m_memoryReportFile.is_open())
+        m_memoryReportFile.close();
+}
+
 std::list<GCTexture*> GCGraphics::GetTextures() 
 {
     return m_lTextures;
@@ -395,6 +659,11 @@ GC_GRAPHICS_ERROR GCGraphics::RemoveShader(GCShader* pShader)
 
     if (GC_LOG_REMOVE_RESOURCE(it, "Shader", m_vShaders))
     {
+        if (pShader == m_pShaderColorTemplate)
+            m_pShaderColorTemplate = nullptr;
+        if (pShader == m_pShaderTextureTemplate)
+            m_pShaderTextureTemplate = nullptr;
+
         m_vShaders.erase(it);
         delete pShader;
         return GCRENDER_SUCCESS_OK;
@@ -412,6 +681,7 @@ GC_GRAPHICS_ERROR GCGraphics::RemoveMaterial(GCMaterial* pMaterial)
     if (GC_LOG_REMOVE_RESOURCE(it, "Material", m_vMaterials))
     {
         m_vMaterials.erase(it);
+        m_pRender->OnMaterialRemoved(pMaterial);
         delete pMaterial;
         return GCRENDER_SUCCESS_OK;
     }
@@ -428,6 +698,16 @@ GC_GRAPHICS_ERROR GCGraphics::RemoveMesh(GCMesh* pMesh)
 
     if (GC_LOG_REMOVE_RESOURCE(it, "Mesh", m_vMeshes))
     {
+        // Drop it from the cache if it was a shared primitive mesh
+        for (auto primitiveIt = m_primitiveMeshes.begin(); primitiveIt != m_primitiveMeshes.end(); ++primitiveIt)
+        {
+            if (primitiveIt->second == pMesh)
+            {
+                m_primitiveMeshes.erase(primitiveIt);
+                break;
+            }
+        }
+
         m_vMeshes.erase(it);
         delete pMesh;
         return GCRENDER_SUCCESS_OK;
@@ -454,6 +734,9 @@ GC_GRAPHICS_ERROR GCGraphics::RemoveTexture(GCTexture* pTexture) {
             *flagIt = false;
         }
 
+        GCRenderResources* pResources = m_pRender->GetRenderResources();
+        pResources->GetMemoryTracker()->Remove(GC_MEMORY_CATEGORY_TEXTURES, pResources->GetResourceSize(pTexture->GetTextureBuffer()) + pResources->GetResourceSize(pTexture->GetUploadTexture()));
+
         delete pTexture;
         m_lTextures.erase(it);
 
@@ -470,6 +753,7 @@ bool GCGraphics::UpdateViewProjConstantBuffer(DirectX::XMMATRIX& projectionMatri
     DirectX::XMStoreFloat4x4( &cameraData.proj,projectionMatrix);
 
     UpdateConstantBuffer(cameraData, m_cbCameraInstances[0]);
+    m_pRender->SetFrameCamera(cameraData);
 
     m_pRender->m_pCbCurrentViewProjInstance = m_cbCameraInstances[0];
 
@@ -515,6 +799,7 @@ bool GCGraphics::CreateViewProjConstantBuffer(const DirectX::XMFLOAT3& cameraPos
     DirectX::XMStoreFloat4x4(&cameraData.view, viewMatrix);
     DirectX::XMStoreFloat4x4(&cameraData.proj, projectionMatrix);
     UpdateConstantBuffer(cameraData, m_cbCameraInstances[0]);
+    m_pRender->SetFrameCamera(cameraData);
 
     m_pRender->m_pCbCurrentViewProjInstance = m_cbCameraInstances[0];
 
@@ -549,6 +834,7 @@ bool GCGraphics::UpdateWorldConstantBuffer(GCMaterial* pMaterial, DirectX::XMMAT
 
     // Update 
     pMaterial->UpdateConstantBuffer(worldData, pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]);
+    m_pRender->AddConstantBufferBytes(pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]->GetElementByteSize());
 
     return true;
 }
@@ -556,6 +842,7 @@ bool GCGraphics::UpdateWorldConstantBuffer(GCMaterial* pMaterial, DirectX::XMMAT
 void GCGraphics::UpdateConstantBuffer(const GCSHADERCB& objectData, GCShaderUploadBufferBase* uploadBufferInstance)
 {
     uploadBufferInstance->CopyData(0, objectData);
+    m_pRender->AddConstantBufferBytes(uploadBufferInstance->GetElementByteSize());
 }
 
 DirectX::XMFLOAT4X4 GCGraphics::ToPixel(int pixelX, int pixelY, DirectX::XMFLOAT4X4& proj, DirectX::XMFLOAT4X4& view) {
@@ -586,6 +873,7 @@ bool GCGraphics::UpdateMaterialProperties(GCMaterial* pMaterial, GCMATERIALPROPE
     pMaterial->shininess = objectData.shininess;
 
     UpdateConstantBuffer(objectData, pMaterial->GetCbMaterialPropertiesInstance());
+    m_pRender->UpdateMaterialDsl(pMaterial);
     return true;
 }
 
@@ -608,12 +896,14 @@ bool GCGraphics::UpdateMaterialProperties(GCMaterial* pMaterial, DirectX::XMFLOA
     pMaterial->shininess = shininess;
 
     UpdateConstantBuffer(materialData, pMaterial->GetCbMaterialPropertiesInstance());
+    m_pRender->UpdateMaterialDsl(pMaterial);
     return true;
 }
 
 bool GCGraphics::UpdateLights(std::vector<GCLIGHT>& objectData) {
     size_t count = objectData.size();
     m_pRender->m_pCbLightPropertiesInstance->CopyData(0, objectData.data(), sizeof(GCLIGHT)*count);
+    m_pRender->AddConstantBufferBytes(sizeof(GCLIGHT) * count);
 
     return true;
 }
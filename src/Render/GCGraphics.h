@@ -92,6 +92,14 @@ public:
 	************************************************************************************************/
 	GC_RESOURCE_CREATION_RESULT<GCShader*> CreateShaderTexture();
 
+	/************************************************************************************************
+	* @brief Creates the particle shader using particle.hlsl, used by GCParticleSystem materials.
+	* Draws one textured quad per particle, read from the instance buffer (t1).
+	*
+	* @return GC_RESOURCE_CREATION_RESULT -> bool(success), GCShader(particle), errorState
+	************************************************************************************************/
+	GC_RESOURCE_CREATION_RESULT<GCShader*> CreateShaderParticle();
+
 
 	/************************************************************************************************
 	* @brief Creates a shader custom using your custom shader hlsl with your custom shader entry, custom parameter.
@@ -108,6 +116,7 @@ public:
 
 	/************************************************************************************************
 	* @brief Creates a material using a shader.
+	* The deferred light pass knows the first 65536 materials (material id on 16 bits in the pixel id map).
 	* 
 	* @param[in] GCShader*, shader that'll be used by the material
 	*
@@ -153,28 +162,53 @@ public:
 	*
 	* @param[in] GCGeometry pGeometry
 	* @param[in] int& flagEnabledBits, set your flag to chose which entry you want to describe the mesh
+	* @param[in] GC_MESH_STORAGE storage, gpu only by default : the geometry can be released once the mesh is created, the mesh can't be edited
 	*
 	* @return GC_RESOURCE_CREATION_RESULT -> bool(success), GCMesh, errorState
 	************************************************************************************************/
-	GC_RESOURCE_CREATION_RESULT<GCMesh*> CreateMeshCustom(GCGeometry* pGeometry, int& flagEnabledBits);
+	GC_RESOURCE_CREATION_RESULT<GCMesh*> CreateMeshCustom(GCGeometry* pGeometry, int& flagEnabledBits, GC_MESH_STORAGE storage = GC_MESH_STORAGE_GPU_ONLY);
 
 	/************************************************************************************************
 	* @brief Creates mesh color from a geometry, color template
 	*
 	* @param[in] GCGeometry pGeometry
+	* @param[in] GC_MESH_STORAGE storage, editable to keep the geometry for the instance edits (AddGeometry...) and UpdateGeometryData
 	*
 	* @return GC_RESOURCE_CREATION_RESULT -> bool(success), GCMesh, errorState
 	************************************************************************************************/
-	GC_RESOURCE_CREATION_RESULT<GCMesh*> CreateMeshColor(GCGeometry* pGeometry);
+	GC_RESOURCE_CREATION_RESULT<GCMesh*> CreateMeshColor(GCGeometry* pGeometry, GC_MESH_STORAGE storage = GC_MESH_STORAGE_GPU_ONLY);
 
 	/************************************************************************************************
 	* @brief Creates mesh texture from a geometry, texture template
 	*
 	* @param[in] GCGeometry pGeometry
+	* @param[in] GC_MESH_STORAGE storage, editable to keep the geometry for the instance edits (AddGeometry...) and UpdateGeometryData
 	*
 	* @return GC_RESOURCE_CREATION_RESULT -> bool(success), GCMesh, errorState
 	************************************************************************************************/
-	GC_RESOURCE_CREATION_RESULT<GCMesh*> CreateMeshTexture(GCGeometry* pGeometry);
+	GC_RESOURCE_CREATION_RESULT<GCMesh*> CreateMeshTexture(GCGeometry* pGeometry, GC_MESH_STORAGE storage = GC_MESH_STORAGE_GPU_ONLY);
+
+	/************************************************************************************************
+	* @brief Gets a shared primitive mesh, the gpu only mesh is created once per (primitive, flags, color) and the same GCMesh is returned after,
+	-> ex : every sprite can draw the same Plane mesh, their size and position only live in the world matrix
+	*
+	* @param[in] const GC_PRIMITIVE_ID primitiveIndex, define the primitive need be loaded
+	* @param[in] int flagEnabledBits, set your flag to chose which entry you want to describe the mesh
+	* @param[in] const DirectX::XMFLOAT4& color, only part of the key if GC_VERTEX_COLOR is set
+	*
+	* @return GC_RESOURCE_CREATION_RESULT -> bool(success), GCMesh, errorState
+	*
+	* @note the mesh is owned by GCGraphics, don't edit it, RemoveMesh release it from the cache too
+	************************************************************************************************/
+	GC_RESOURCE_CREATION_RESULT<GCMesh*> GetPrimitiveMesh(const GC_PRIMITIVE_ID primitiveIndex, int flagEnabledBits, const DirectX::XMFLOAT4& color = DirectX::XMFLOAT4(DirectX::Colors::Black));
+
+	/************************************************************************************************
+	* @brief Gets the shared color / texture template shaders, compiled on the first call and reused after, unlike CreateShaderColor / CreateShaderTexture
+	*
+	* @return GC_RESOURCE_CREATION_RESULT -> bool(success), GCShader(color / texture), errorState
+	************************************************************************************************/
+	GC_RESOURCE_CREATION_RESULT<GCShader*> GetShaderColor();
+	GC_RESOURCE_CREATION_RESULT<GCShader*> GetShaderTexture();
 
 	/************************************************************************************************
 	* @brief Update View & Projection Matrix using GCVIEWPROJCB derived from GCSHADERCB, -> using for Camera, you can update at any moment, each frame if you want make move camera, 
@@ -330,6 +364,63 @@ public:
 	std::vector<GCMesh*> GetMeshes();
 	std::list<GCTexture*> GetTextures();
 
+	/************************************************************************************************
+	* @brief Logs the memory of every mesh, one line per mesh then the totals
+	*
+	* @return GC_MESH_MEMORY, totals of every mesh
+	************************************************************************************************/
+	GC_MESH_MEMORY LogMeshMemoryReport();
+
+	/************************************************************************************************
+	* @brief Memory used by the resources, per category, with the high water marks and budgets
+	*
+	* @return GC_MEMORY_USAGE
+	************************************************************************************************/
+	GC_MEMORY_USAGE GetMemoryUsage();
+
+	/************************************************************************************************
+	* @brief Budget of a category, a warning is logged when it is exceeded. 0 removes it
+	*
+	* @param category, GC_MEMORY_CATEGORY_COUNT for the total
+	* @param budgetBytes
+	************************************************************************************************/
+	void SetMemoryBudget(GC_MEMORY_CATEGORY category, UINT64 budgetBytes);
+	void ResetMemoryHighWater();
+
+	/************************************************************************************************
+	* @brief Memory usage as a one line JSON object, tagged with the current frame index
+	*
+	* @return std::string
+	************************************************************************************************/
+	std::string GetMemoryReportJson();
+
+	/************************************************************************************************
+	* @brief Appends the JSON memory report to filePath at the end of every frame, one line per frame
+	*
+	* @param filePath, the file is truncated
+	* @return false if the file can't be opened
+	************************************************************************************************/
+	bool ActiveMemoryReportDump(const std::string& filePath);
+	void DesactiveMemoryReportDump();
+
+	/************************************************************************************************
+	* @brief Trimming of the per object constant buffers unused for several frames, done in EndFrame.
+	* Trimmed buffers are released once the GPU is done with them
+	*
+	* @param policy
+	************************************************************************************************/
+	void SetConstantBufferTrimPolicy(const GC_CB_TRIM_POLICY& policy);
+	const GC_CB_TRIM_POLICY& GetConstantBufferTrimPolicy() const { return m_cbTrimPolicy; }
+	const GC_CB_TRIM_STATS& GetConstantBufferTrimStats() const { return m_cbTrimStats; }
+
+	/************************************************************************************************
+	* @brief Counters of the last frame ended by EndFrame : draw calls, triangles, state changes,
+	* bytes uploaded, descriptors, materials drawn, CPU frame time and GPU time when the GPU timer is active
+	*
+	* @return GC_FRAME_STATS
+	************************************************************************************************/
+	const GC_FRAME_STATS& GetFrameStats() const { return m_frameStats; }
+
 	/************************************************************************************************
 	* @brief Get Render for no encapsulate Render functions
 	*
@@ -369,6 +460,12 @@ private:
 	std::vector<GCMaterial*> m_vMaterials;
 	std::vector<GCMesh*> m_vMeshes;
 
+	// Interned primitive meshes (gpu only, also in m_vMeshes), key -> (primitive id, vertex flags, packed color)
+	std::unordered_map<uint64_t, GCMesh*> m_primitiveMeshes;
+
+	GCShader* m_pShaderColorTemplate;
+	GCShader* m_pShaderTextureTemplate;
+
 	// Scene properties
 	std::vector<GCShaderUploadBufferBase*> m_cbCameraInstances;
 	GCShaderUploadBufferBase* m_pCbLightPropertiesInstance;
@@ -377,6 +474,23 @@ private:
 	GCPrimitiveFactory* m_pPrimitiveFactory;
 	GCModelParserFactory* m_pModelParserFactory;
 
+	// Memory report dump, one JSON line per frame
+	std::ofstream m_memoryReportFile;
+
+	// Per object constant buffers trimming
+	void TrimConstantBuffers();
+	// Buffers trimmed before the completed fence value, every one when isForced
+	void ReleaseRetiredConstantBuffers(bool isForced);
+
+	GC_CB_TRIM_POLICY m_cbTrimPolicy;
+	GC_CB_TRIM_STATS m_cbTrimStats;
+	// Fence value of the last submission that may use them
+	std::deque<std::pair<UINT64, GCShaderUploadBufferBase*>> m_retiredConstantBuffers;
+
+	// Last ended frame, read through GetFrameStats
+	GC_FRAME_STATS m_frameStats;
+	std::chrono::steady_clock::time_point m_lastEndFrameTime;
+	bool m_hasEndedFrame;
 };
 
 template<typename ShaderTypeConstantBuffer>
@@ -390,5 +504,6 @@ bool GCGraphics::UpdateCustomCbPerObject(GCMaterial* pMaterial, const GCSHADERCB
 
 	// Update 
 	pMaterial->UpdateConstantBuffer(objectData, pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]);
+	m_pRender->AddConstantBufferBytes(pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]->GetElementByteSize());
 }
 
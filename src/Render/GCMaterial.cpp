@@ -2,6 +2,7 @@
 
 GCMaterial::GCMaterial()
     : m_iCount(0),
+    m_isPropertiesDirty(false),
     
     m_pRender(nullptr),
     
@@ -29,7 +30,7 @@ GC_GRAPHICS_ERROR GCMaterial::Initialize(GCShader* pShader)
 	m_pShader = pShader;
     m_pRender = m_pShader->m_pRender;
 
-    m_pCbMaterialPropertiesInstance = new GCShaderUploadBuffer<GCMATERIALPROPERTIES>(m_pRender->GetRenderResources()->Getmd3dDevice(), 1, true);
+    m_pCbMaterialPropertiesInstance = new GCShaderUploadBuffer<GCMATERIALPROPERTIES>(m_pRender->GetRenderResources()->GetGpuAllocator(), 1, true);
 
     GCMATERIALPROPERTIES materialProperties;
     materialProperties.ambientLightColor = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
@@ -38,6 +39,12 @@ GC_GRAPHICS_ERROR GCMaterial::Initialize(GCShader* pShader)
     materialProperties.specular = DirectX::XMFLOAT4(0.8f, 0.8f, 0.8f, 1.0f);
     materialProperties.shininess = 5.0f;                                    
 
+    ambientLightColor = materialProperties.ambientLightColor;
+    ambient = materialProperties.ambient;
+    diffuse = materialProperties.diffuse;
+    specular = materialProperties.specular;
+    shininess = materialProperties.shininess;
+
     UpdateConstantBuffer(materialProperties, m_pCbMaterialPropertiesInstance);
 
     return GCRENDER_SUCCESS_OK;
@@ -50,18 +57,38 @@ bool GCMaterial::SetTexture(GCTexture* pTexture) {
     return true;
 }
 
+int GCMaterial::TrimCbPerObject(int unusedFrameThreshold, int minKeptCount, int maxTrimCount, std::vector<GCShaderUploadBufferBase*>& outTrimmed)
+{
+    int trimmedCount = 0;
+
+    while (trimmedCount < maxTrimCount
+        && static_cast<int>(m_pCbObjectInstances.size()) > std::max(minKeptCount, m_iCount)
+        && m_pCbObjectInstances.back()->m_framesSinceLastUse > unusedFrameThreshold)
+    {
+        outTrimmed.push_back(m_pCbObjectInstances.back());
+        m_pCbObjectInstances.pop_back();
+        trimmedCount++;
+    }
+
+    // The vector of a spike holds its capacity otherwise
+    if (trimmedCount > 0 && m_pCbObjectInstances.capacity() > 2 * m_pCbObjectInstances.size())
+        m_pCbObjectInstances.shrink_to_fit();
+
+    return trimmedCount;
+}
+
 void GCMaterial::UpdateConstantBuffer(const GCSHADERCB& objectData, GCShaderUploadBufferBase* uploadBufferInstance)
 {
 	uploadBufferInstance->CopyData(0, objectData);
 }
 
-bool GCMaterial::UpdateTexture()
+bool GCMaterial::UpdateTexture(ID3D12GraphicsCommandList* pCommandList)
 {
     if (GC_HAS_FLAG(m_pShader->GetFlagEnabledBits(), GC_VERTEX_UV))
     {
         if (m_pTexture)
         {
-            m_pRender->GetRenderResources()->GetCommandList()->SetGraphicsRootDescriptorTable(m_pShader->m_rootParameter_DescriptorTable_1, m_pTexture->GetTextureAddress());
+            pCommandList->SetGraphicsRootDescriptorTable(m_pShader->m_rootParameter_DescriptorTable_1, m_pTexture->GetTextureAddress());
             return true;
         }
         else
@@ -1,4 +1,26 @@
 #pragma once
+
+// Per object constant buffers not used by the last frames are released, from the end of the material list :
+// the draws of a frame use the first ones, the unused ones are always the last
+struct GC_CB_TRIM_POLICY
+{
+	bool isEnabled = true;
+	int unusedFrameThreshold = 180; // Frames without a draw before a buffer is trimmed
+	int minKeptCount = 0; // Per material, never trimmed below
+	int maxTrimCountPerFrame = 1024; // Every material, spreads the release of a spike over several frames
+};
+
+struct GC_CB_TRIM_STATS
+{
+	int liveCount = 0; // Per object buffers of every material
+	UINT64 liveBytes = 0;
+	int pendingCount = 0; // Trimmed, waiting for the GPU to be done with them
+	UINT64 pendingBytes = 0;
+	int lastFrameTrimmedCount = 0;
+	UINT64 totalTrimmedCount = 0;
+	UINT64 totalReclaimedBytes = 0; // Released once the GPU was done with them
+};
+
 class GCMaterial
 {
 public:
@@ -21,14 +43,17 @@ public:
 
 	template<typename ShaderTypeConstantBuffer>
 	void AddCbPerObject();
+	// Moves the last buffers unused for more than unusedFrameThreshold frames to outTrimmed (at most maxTrimCount),
+	// the caller releases them once the GPU is done. Returns the trimmed count
+	int TrimCbPerObject(int unusedFrameThreshold, int minKeptCount, int maxTrimCount, std::vector<GCShaderUploadBufferBase*>& outTrimmed);
 
 	void UpdateConstantBuffer(const GCSHADERCB& objectData, GCShaderUploadBufferBase* uploadBufferInstance);
 
-	// Check texture and apply if exist
-	bool UpdateTexture();
+	// Check texture and apply if exist, on the command list recording the draw
+	bool UpdateTexture(ID3D12GraphicsCommandList* pCommandList);
 
 	// Object
-	std::vector<GCShaderUploadBufferBase*> GetCbObjectInstance() { return m_pCbObjectInstances; }
+	const std::vector<GCShaderUploadBufferBase*>& GetCbObjectInstance() const { return m_pCbObjectInstances; }
 	GCShaderUploadBufferBase* GetCbMaterialPropertiesInstance() { return m_pCbMaterialPropertiesInstance; }
 
 	// Draw Count
@@ -45,8 +70,13 @@ public:
 	// Material Id
 	float m_materialId;
 
+	// Properties changed since the deferred light pass material table got them, set by GCRenderContext::UpdateMaterialDsl
+	bool IsPropertiesDirty() const { return m_isPropertiesDirty; }
+	void SetPropertiesDirty(bool isDirty) { m_isPropertiesDirty = isDirty; }
+
 private:
 	int m_iCount;
+	bool m_isPropertiesDirty;
 
 	GCRenderContext* m_pRender;
 
@@ -63,6 +93,6 @@ private:
 template<typename ShaderTypeConstantBuffer>
 void GCMaterial::AddCbPerObject()
 {
-	GCShaderUploadBufferBase* pObjectCB = new GCShaderUploadBuffer<ShaderTypeConstantBuffer>(m_pRender->GetRenderResources()->Getmd3dDevice(), 1, true);
+	GCShaderUploadBufferBase* pObjectCB = new GCShaderUploadBuffer<ShaderTypeConstantBuffer>(m_pRender->GetRenderResources()->GetGpuAllocator(), 1, true);
 	m_pCbObjectInstances.push_back(pObjectCB);
 }
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "pch.h"
+
+bool GC_MEMORY_USAGE::IsOverBudget() const
+{
+    if (totalBudgetBytes > 0 && totalBytes > totalBudgetBytes)
+        return true;
+
+    for (const GC_MEMORY_CATEGORY_USAGE& category : categories)
+    {
+        if (category.IsOverBudget())
+            return true;
+    }
+    return false;
+}
+
+GCMemoryTracker::GCMemoryTracker()
+    : m_isCategoryOverBudget(),
+    m_isTotalOverBudget(false)
+{
+}
+
+const char* GCMemoryTracker::GetCategoryName(GC_MEMORY_CATEGORY category)
+{
+    static const char* categoryNames[GC_MEMORY_CATEGORY_COUNT] = { "textures", "renderTargets", "meshes", "uploadBuffers", "constantBuffers", "descriptors", "cpuBlobs" };
+
+    if (category < 0 || category >= GC_MEMORY_CATEGORY_COUNT)
+        return "unknown";
+    return categoryNames[category];
+}
+
+void GCMemoryTracker::Add(GC_MEMORY_CATEGORY category, UINT64 bytes, int count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_usage.categories[category].bytes += bytes;
+    m_usage.categories[category].count += count;
+    m_usage.totalBytes += bytes;
+
+    UpdateHighWater(category);
+    CheckBudgets(category);
+}
+
+void GCMemoryTracker::Remove(GC_MEMORY_CATEGORY category, UINT64 bytes, int count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    GC_MEMORY_CATEGORY_USAGE& usage = m_usage.categories[category];
+
+    // More removed than added is a bookkeeping bug : clamped so the report stays readable
+    if (bytes > usage.bytes || count > usage.count)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning(std::string("Memory tracker : more ") + GetCategoryName(category) + " removed than added");
+        bytes = std::min(bytes, usage.bytes);
+        count = std::min(count, usage.count);
+    }
+
+    usage.bytes -= bytes;
+    usage.count -= count;
+    m_usage.totalBytes -= bytes;
+
+    CheckBudgets(category);
+}
+
+void GCMemoryTracker::Set(GC_MEMORY_CATEGORY category, UINT64 bytes, int count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    GC_MEMORY_CATEGORY_USAGE& usage = m_usage.categories[category];
+    m_usage.totalBytes = m_usage.totalBytes - usage.bytes + bytes;
+    usage.bytes = bytes;
+    usage.count = count;
+
+    UpdateHighWater(category);
+    CheckBudgets(category);
+}
+
+void GCMemoryTracker::SetBudget(GC_MEMORY_CATEGORY category, UINT64 budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_usage.categories[category].budgetBytes = budgetBytes;
+    m_isCategoryOverBudget[category] = false;
+    CheckBudgets(category);
+}
+
+void GCMemoryTracker::SetTotalBudget(UINT64 budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_usage.totalBudgetBytes = budgetBytes;
+    m_isTotalOverBudget = false;
+    CheckBudgets(GC_MEMORY_CATEGORY_COUNT);
+}
+
+void GCMemoryTracker::ResetHighWater()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (GC_MEMORY_CATEGORY_USAGE& usage : m_usage.categories)
+    {
+        usage.highWaterBytes = usage.bytes;
+        usage.highWaterCount = usage.count;
+    }
+    m_usage.totalHighWaterBytes = m_usage.totalBytes;
+}
+
+GC_MEMORY_USAGE GCMemoryTracker::GetUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_usage;
+}
+
+void GCMemoryTracker::UpdateHighWater(GC_MEMORY_CATEGORY category)
+{
+    GC_MEMORY_CATEGORY_USAGE& usage = m_usage.categories[category];
+
+    usage.highWaterBytes = std::max(usage.highWaterBytes, usage.bytes);
+    usage.highWaterCount = std::max(usage.highWaterCount, usage.count);
+    m_usage.totalHighWaterBytes = std::max(m_usage.totalHighWaterBytes, m_usage.totalBytes);
+}
+
+void GCMemoryTracker::CheckBudgets(GC_MEMORY_CATEGORY category)
+{
+    // Warned when the budget is crossed, again only after going back under it
+    if (category < GC_MEMORY_CATEGORY_COUNT)
+    {
+        bool isOverBudget = m_usage.categories[category].IsOverBudget();
+        if (isOverBudget && m_isCategoryOverBudget[category] == false)
+        {
+            GCGraphicsLogger::GetInstance().LogWarning(std::string("Memory budget exceeded for ") + GetCategoryName(category) + " : "
+                + std::to_string(m_usage.categories[category].bytes) + " B used, budget " + std::to_string(m_usage.categories[category].budgetBytes) + " B");
+        }
+        m_isCategoryOverBudget[category] = isOverBudget;
+    }
+
+    bool isTotalOverBudget = m_usage.totalBudgetBytes > 0 && m_usage.totalBytes > m_usage.totalBudgetBytes;
+    if (isTotalOverBudget && m_isTotalOverBudget == false)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Total memory budget exceeded : " + std::to_string(m_usage.totalBytes)
+            + " B used, budget " + std::to_string(m_usage.totalBudgetBytes) + " B");
+    }
+    m_isTotalOverBudget = isTotalOverBudget;
+}
+
+std::string GCMemoryTracker::ToJson(UINT64 frameIndex) const
+{
+    GC_MEMORY_USAGE usage = GetUsage();
+
+    std::ostringstream json;
+    json << "{\"frame\":" << frameIndex
+        << ",\"totalBytes\":" << usage.totalBytes
+        << ",\"totalHighWaterBytes\":" << usage.totalHighWaterBytes
+        << ",\"totalBudgetBytes\":" << usage.totalBudgetBytes
+        << ",\"overBudget\":" << (usage.IsOverBudget() ? "true" : "false")
+        << ",\"categories\":{";
+
+    for (int i = 0; i < GC_MEMORY_CATEGORY_COUNT; i++)
+    {
+        const GC_MEMORY_CATEGORY_USAGE& category = usage.categories[i];
+        if (i > 0)
+            json << ",";
+
+        json << "\"" << GetCategoryName(static_cast<GC_MEMORY_CATEGORY>(i)) << "\":{"
+            << "\"bytes\":" << category.bytes
+            << ",\"highWaterBytes\":" << category.highWaterBytes
+            << ",\"count\":" << category.count
+            << ",\"highWaterCount\":" << category.highWaterCount
+            << ",\"budgetBytes\":" << category.budgetBytes
+            << "}";
+    }
+    json << "}}";
+
+    return json.str();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+enum GC_MEMORY_CATEGORY
+{
+	GC_MEMORY_CATEGORY_TEXTURES, // Loaded textures and their upload copy
+	GC_MEMORY_CATEGORY_RENDER_TARGETS, // Render targets, depth stencils
+	GC_MEMORY_CATEGORY_MESHES, // Vertex / index buffers, particle buffers
+	GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, // Staging ring, per frame tables, particle uploads
+	GC_MEMORY_CATEGORY_CONSTANT_BUFFERS, // Camera, material, per object and light constant buffers
+	GC_MEMORY_CATEGORY_DESCRIPTORS, // Descriptor heaps, count is the descriptors in use
+	GC_MEMORY_CATEGORY_CPU_BLOBS, // Mesh CPU copies (GC_MESH_STORAGE_CPU_COPY)
+
+	GC_MEMORY_CATEGORY_COUNT
+};
+
+struct GC_MEMORY_CATEGORY_USAGE
+{
+	UINT64 bytes = 0;
+	UINT64 highWaterBytes = 0;
+	int count = 0;
+	int highWaterCount = 0;
+	UINT64 budgetBytes = 0; // 0 : no budget
+
+	inline bool IsOverBudget() const { return budgetBytes > 0 && bytes > budgetBytes; }
+};
+
+struct GC_MEMORY_USAGE
+{
+	GC_MEMORY_CATEGORY_USAGE categories[GC_MEMORY_CATEGORY_COUNT];
+
+	UINT64 totalBytes = 0;
+	UINT64 totalHighWaterBytes = 0; // Highest total reached, not the sum of the category high water marks
+	UINT64 totalBudgetBytes = 0; // 0 : no budget
+
+	inline const GC_MEMORY_CATEGORY_USAGE& Get(GC_MEMORY_CATEGORY category) const { return categories[category]; }
+	bool IsOverBudget() const;
+};
+
+// Bytes and resource count per category, kept up to date by the resources on creation / release.
+// GPU sizes are the real allocation sizes (page blocks, GetResourceAllocationInfo), not the requested ones.
+// Budgets only warn, once per crossing : a soak test reads IsOverBudget / the high water marks
+class GCMemoryTracker
+{
+public:
+	GCMemoryTracker();
+
+	void Add(GC_MEMORY_CATEGORY category, UINT64 bytes, int count = 1);
+	void Remove(GC_MEMORY_CATEGORY category, UINT64 bytes, int count = 1);
+	// Categories measured rather than accumulated (descriptors)
+	void Set(GC_MEMORY_CATEGORY category, UINT64 bytes, int count);
+
+	void SetBudget(GC_MEMORY_CATEGORY category, UINT64 budgetBytes);
+	void SetTotalBudget(UINT64 budgetBytes);
+	// High water marks restart from the current usage
+	void ResetHighWater();
+
+	GC_MEMORY_USAGE GetUsage() const;
+	// One line object : {"frame":N,"totalBytes":..,"categories":{"textures":{..},..}}
+	std::string ToJson(UINT64 frameIndex) const;
+
+	static const char* GetCategoryName(GC_MEMORY_CATEGORY category);
+
+private:
+	void UpdateHighWater(GC_MEMORY_CATEGORY category);
+	void CheckBudgets(GC_MEMORY_CATEGORY category);
+
+	// Resources may be created from the worker threads
+	mutable std::mutex m_mutex;
+
+	GC_MEMORY_USAGE m_usage;
+	bool m_isCategoryOverBudget[GC_MEMORY_CATEGORY_COUNT];
+	bool m_isTotalOverBudget;
+};
@@ -6,23 +6,53 @@ GCMesh::GCMesh()
     m_pBufferGeometryData(nullptr),
     m_pMeshGeometry(nullptr),
     m_flagEnabledBits(0),
+    m_storage(GC_MESH_STORAGE_GPU_ONLY),
+    m_isStaticBuffer(false),
 
     m_currentVertexUploadBufferSize(0),
     m_currentIndexUploadBufferSize(0),
 
-    m_geoAmount(0)
+    m_geoAmount(0),
+
+    m_pVertexBuffer(nullptr),
+    m_pIndexBuffer(nullptr)
 {
 }
 
 GCMesh::~GCMesh()
+{
+    ReleaseBufferData();
+}
+
+void GCMesh::ReleaseBufferData()
 {
     if (m_pBufferGeometryData)
     {
-        m_pBufferGeometryData->pVertexBufferCPU->Release();
-        m_pBufferGeometryData->pIndexBufferCPU->Release();
-
-        m_pBufferGeometryData->pVertexBufferGPU->Release();
-        m_pBufferGeometryData->pIndexBufferGPU->Release();
+        TrackBufferMemory(false);
+
+        if (m_pBufferGeometryData->pVertexBufferCPU)
+            m_pBufferGeometryData->pVertexBufferCPU->Release();
+        if (m_pBufferGeometryData->pIndexBufferCPU)
+            m_pBufferGeometryData->pIndexBufferCPU->Release();
+
+        // Unmapped before the release of their resource
+        GC_DELETE(m_pVertexBuffer);
+        GC_DELETE(m_pIndexBuffer);
+
+        if (m_isStaticBuffer)
+        {
+            // A copy still staged keeps the page buffer alive, the range can be reused right away :
+            // the copies are executed in order
+            GCGpuMemoryAllocator* pAllocator = m_pRender->GetRenderResources()->GetGpuAllocator();
+            pAllocator->Free(m_vertexAllocation);
+            pAllocator->Free(m_indexAllocation);
+            m_isStaticBuffer = false;
+        }
+        else
+        {
+            m_pBufferGeometryData->pVertexBufferGPU->Release();
+            m_pBufferGeometryData->pIndexBufferGPU->Release();
+        }
 
         m_pBufferGeometryData->VertexByteStride = 0;
         m_pBufferGeometryData->VertexBufferByteSize = 0;
@@ -34,7 +64,7 @@ GCMesh::~GCMesh()
     }
 }
 
-GC_GRAPHICS_ERROR GCMesh::Initialize(GCRenderContext* pRender, GCGeometry* pGeometry, int& flagEnabledBits)
+GC_GRAPHICS_ERROR GCMesh::Initialize(GCRenderContext* pRender, GCGeometry* pGeometry, int& flagEnabledBits, GC_MESH_STORAGE storage)
 {
 
     if (!GC_CHECK_POINTERSNULL("Pointers pRender & pGeometry Valid", "Pointers pRender & pGeometry Not valid", pRender, pGeometry)) {
@@ -46,14 +76,14 @@ GC_GRAPHICS_ERROR GCMesh::Initialize(GCRenderContext* pRender, GCGeometry* pGeom
 
     m_pMeshGeometry = pGeometry;
     m_pRender = pRender;
+    m_storage = storage;
 
     UploadGeometryData(flagEnabledBits);
+    ComputeBounds();
 
     if (!GC_CHECK_POINTERSNULL(
         "All mesh buffer data pointers are valid",
         "One or more mesh buffer data pointers are null",
-        m_pBufferGeometryData->pVertexBufferCPU,
-        m_pBufferGeometryData->pIndexBufferCPU,
         m_pBufferGeometryData->pVertexBufferGPU,
         m_pBufferGeometryData->pIndexBufferGPU
     )) 
@@ -61,177 +91,274 @@ GC_GRAPHICS_ERROR GCMesh::Initialize(GCRenderContext* pRender, GCGeometry* pGeom
         return GCRENDER_ERROR_POINTER_NULL;
     };
 
+    // Everything the mesh needs is in its buffers and bounds now
+    if (m_storage == GC_MESH_STORAGE_GPU_ONLY)
+        m_pMeshGeometry = nullptr;
+
     return GCRENDER_SUCCESS_OK;
 }
 
 void GCMesh::UploadGeometryData(int& flagEnabledBits) {
     m_flagEnabledBits = flagEnabledBits;
 
-    std::vector<float> vertexData;
-    size_t vertexSize = 0;
+    CreateBuffers();
+}
 
-    // Manage offset bits size for reserve vector
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_POSITION)) vertexSize += 3;
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_COLOR)) vertexSize += 4;
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_UV)) vertexSize += 2;
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_NORMAL)) vertexSize += 3;
+void GCMesh::CreateBuffers()
+{
+    GC_PROFILE_FUNCTION();
+    GC_VERTEX_LAYOUT layout = GCVertexLayout::Make(m_flagEnabledBits);
 
-    vertexData.reserve(m_pMeshGeometry->pos.size() * vertexSize);
+    const UINT vbByteSize = static_cast<UINT>(m_pMeshGeometry->pos.size() * layout.stride * m_geoAmount);
+    const UINT indexCount = static_cast<UINT>(m_pMeshGeometry->indices.size() * m_geoAmount);
+    const UINT ibByteSize = indexCount * sizeof(std::uint16_t);
 
-    for (size_t i = 0; i < m_pMeshGeometry->pos.size(); ++i) {
-        if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_POSITION)) {
-            vertexData.push_back(m_pMeshGeometry->pos[i].x);
-            vertexData.push_back(m_pMeshGeometry->pos[i].y);
-            vertexData.push_back(m_pMeshGeometry->pos[i].z);
-        }
-        if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_COLOR)) {
-            vertexData.push_back(m_pMeshGeometry->color[i].x);
-            vertexData.push_back(m_pMeshGeometry->color[i].y);
-            vertexData.push_back(m_pMeshGeometry->color[i].z);
-            vertexData.push_back(m_pMeshGeometry->color[i].w);
-        }
-        if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_UV)) {
-            vertexData.push_back(m_pMeshGeometry->uv[i].x);
-            vertexData.push_back(m_pMeshGeometry->uv[i].y);
-        }
-        if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_NORMAL)) {
-            vertexData.push_back(m_pMeshGeometry->normals[i].x);
-            vertexData.push_back(m_pMeshGeometry->normals[i].y);
-            vertexData.push_back(m_pMeshGeometry->normals[i].z);
-        }
+    m_pBufferGeometryData = new GC_MESH_BUFFER_DATA();
+
+    // Editable meshes are rebuilt by UpdateGeometryData : they stay on upload memory.
+    // A mesh larger than the staging ring falls back on it too
+    m_isStaticBuffer = IsEditable() == false && CreateStaticBuffers(vbByteSize, ibByteSize);
+    if (m_isStaticBuffer == false)
+        CreateUploadBuffers(vbByteSize, indexCount);
+
+    // Picking copy packed again rather than read back from the write combined upload memory
+    if (m_storage == GC_MESH_STORAGE_CPU_COPY)
+    {
+        D3DCreateBlob(vbByteSize, &m_pBufferGeometryData->pVertexBufferCPU);
+        D3DCreateBlob(ibByteSize, &m_pBufferGeometryData->pIndexBufferCPU);
+
+        PackVertices(static_cast<BYTE*>(m_pBufferGeometryData->pVertexBufferCPU->GetBufferPointer()));
+        PackIndices(static_cast<std::uint16_t*>(m_pBufferGeometryData->pIndexBufferCPU->GetBufferPointer()));
     }
 
-    const UINT vbByteSize = static_cast<UINT>(vertexData.size() * sizeof(float));
-    const UINT ibByteSize = static_cast<UINT>(m_pMeshGeometry->indices.size() * sizeof(std::uint16_t));
+    m_currentVertexUploadBufferSize = static_cast<int>(vbByteSize);
+    m_currentIndexUploadBufferSize = static_cast<int>(indexCount);
 
-    m_pBufferGeometryData = new GC_MESH_BUFFER_DATA();
+    m_pBufferGeometryData->VertexByteStride = layout.stride;
+    m_pBufferGeometryData->VertexBufferByteSize = vbByteSize;
+    m_pBufferGeometryData->IndexFormat = DXGI_FORMAT_R16_UINT;
+    m_pBufferGeometryData->IndexBufferByteSize = ibByteSize;
+
+    m_pBufferGeometryData->IndexCount = indexCount;
+
+    m_pRender->AddMeshUploadBytes(static_cast<UINT64>(vbByteSize) + ibByteSize);
+    TrackBufferMemory(true);
+}
+
+void GCMesh::TrackBufferMemory(bool isAdded)
+{
+    GCMemoryTracker* pTracker = m_pRender->GetRenderResources()->GetMemoryTracker();
+    GC_MESH_MEMORY memory = GetMemoryUsage();
+
+    if (isAdded)
+    {
+        if (m_isStaticBuffer == false)
+            pTracker->Add(GC_MEMORY_CATEGORY_MESHES, memory.gpuAllocatedBytes, 2);
+        if (memory.cpuCopyBytes > 0)
+            pTracker->Add(GC_MEMORY_CATEGORY_CPU_BLOBS, memory.cpuCopyBytes, 2);
+    }
+    else
+    {
+        if (m_isStaticBuffer == false)
+            pTracker->Remove(GC_MEMORY_CATEGORY_MESHES, memory.gpuAllocatedBytes, 2);
+        if (memory.cpuCopyBytes > 0)
+            pTracker->Remove(GC_MEMORY_CATEGORY_CPU_BLOBS, memory.cpuCopyBytes, 2);
+    }
+}
 
-    D3DCreateBlob(vbByteSize, &m_pBufferGeometryData->pVertexBufferCPU);
-    CopyMemory(m_pBufferGeometryData->pVertexBufferCPU->GetBufferPointer(), vertexData.data(), vbByteSize);
-    D3DCreateBlob(ibByteSize, &m_pBufferGeometryData->pIndexBufferCPU);
-    CopyMemory(m_pBufferGeometryData->pIndexBufferCPU->GetBufferPointer(), m_pMeshGeometry->indices.data(), ibByteSize);
+bool GCMesh::CreateStaticBuffers(UINT vbByteSize, UINT ibByteSize)
+{
+    GCGpuMemoryAllocator* pAllocator = m_pRender->GetRenderResources()->GetGpuAllocator();
+    GCStagingRing* pStagingRing = m_pRender->GetStagingRing();
 
-    auto vertexBuffer = std::make_unique<GCUploadBuffer<float>>(
-        m_pRender->GetRenderResources()->Getmd3dDevice(),
-        static_cast<UINT>(vertexData.size()),
-        false); 
+    if (pStagingRing == nullptr
+        || pAllocator->AllocateBuffer(GC_GPU_POOL_DEFAULT_BUFFER, vbByteSize, m_bufferAlignment, m_vertexAllocation) == false
+        || pAllocator->AllocateBuffer(GC_GPU_POOL_DEFAULT_BUFFER, ibByteSize, m_bufferAlignment, m_indexAllocation) == false)
+    {
+        pAllocator->Free(m_vertexAllocation);
+        return false;
+    }
 
-    auto indexBuffer = std::make_unique<GCUploadBuffer<std::uint16_t>>(
-        m_pRender->GetRenderResources()->Getmd3dDevice(),
-        static_cast<UINT>(m_pMeshGeometry->indices.size()),
-        false); 
+    // Each staging is written before the next one : a full ring submits what was staged before
+    BYTE* pIndexStaging = nullptr;
+    BYTE* pVertexStaging = pStagingRing->StageBufferCopy(m_vertexAllocation.pResource, m_vertexAllocation.offset, vbByteSize);
+    if (pVertexStaging)
+    {
+        PackVertices(pVertexStaging);
+        pIndexStaging = pStagingRing->StageBufferCopy(m_indexAllocation.pResource, m_indexAllocation.offset, ibByteSize);
+    }
 
-    m_currentIndexUploadBufferSize = static_cast<int>(m_pMeshGeometry->indices.size());
-    m_currentVertexUploadBufferSize = static_cast<int>(vertexData.size());
+    if (pIndexStaging == nullptr)
+    {
+        pAllocator->Free(m_vertexAllocation);
+        pAllocator->Free(m_indexAllocation);
+        return false;
+    }
 
-    vertexBuffer->CopyData(0, vertexData.data(), vbByteSize);
-    indexBuffer->CopyData(0, m_pMeshGeometry->indices.data(), ibByteSize);
+    PackIndices(reinterpret_cast<std::uint16_t*>(pIndexStaging));
 
-    m_pBufferGeometryData->pVertexBufferGPU = vertexBuffer->Resource();
-    m_pBufferGeometryData->pIndexBufferGPU = indexBuffer->Resource();
-    m_pBufferGeometryData->pVertexBufferUploader = vertexBuffer.release()->Resource();
-    m_pBufferGeometryData->pIndexBufferUploader = indexBuffer.release()->Resource();
+    // Filled by the copy queue before the next frame draws (GCRenderContext::SubmitDraws)
+    m_pBufferGeometryData->pVertexBufferGPU = m_vertexAllocation.pResource;
+    m_pBufferGeometryData->pIndexBufferGPU = m_indexAllocation.pResource;
+    m_pBufferGeometryData->VertexBufferOffset = m_vertexAllocation.offset;
+    m_pBufferGeometryData->IndexBufferOffset = m_indexAllocation.offset;
 
-    m_pBufferGeometryData->VertexByteStride = static_cast<UINT>(vertexSize * sizeof(float));
-    m_pBufferGeometryData->VertexBufferByteSize = vbByteSize;
-    m_pBufferGeometryData->IndexFormat = DXGI_FORMAT_R16_UINT;
-    m_pBufferGeometryData->IndexBufferByteSize = ibByteSize;
+    return true;
+}
+
+void GCMesh::CreateUploadBuffers(UINT vbByteSize, UINT indexCount)
+{
+    GCUploadBuffer<BYTE>* pVertexBuffer = new GCUploadBuffer<BYTE>(m_pRender->GetRenderResources()->Getmd3dDevice(), vbByteSize, false);
+    GCUploadBuffer<std::uint16_t>* pIndexBuffer = new GCUploadBuffer<std::uint16_t>(m_pRender->GetRenderResources()->Getmd3dDevice(), indexCount, false);
+    m_pVertexBuffer = pVertexBuffer;
+    m_pIndexBuffer = pIndexBuffer;
+
+    // Packed straight into the mapped upload memory, never read back from it
+    PackVertices(pVertexBuffer->GetMappedData());
+    PackIndices(reinterpret_cast<std::uint16_t*>(pIndexBuffer->GetMappedData()));
+
+    // Upload heap buffers read by the draws directly
+    m_pBufferGeometryData->pVertexBufferGPU = pVertexBuffer->Resource();
+    m_pBufferGeometryData->pIndexBufferGPU = pIndexBuffer->Resource();
+    m_pBufferGeometryData->pVertexBufferUploader = pVertexBuffer->Resource();
+    m_pBufferGeometryData->pIndexBufferUploader = pIndexBuffer->Resource();
+}
+
+void GCMesh::PackVertices(BYTE* pDestination)
+{
+    // Each geometry instance is a copy of the geometry moved by its position
+    size_t geometryVertexBytes = m_pMeshGeometry->pos.size() * GCVertexLayout::Make(m_flagEnabledBits).stride;
+
+    for (int instance = 0; instance < m_geoAmount; ++instance)
+        GCVertexLayout::Pack(m_flagEnabledBits, *m_pMeshGeometry, m_geometryPositions[instance], pDestination + instance * geometryVertexBytes);
+}
+
+void GCMesh::PackIndices(std::uint16_t* pDestination)
+{
+    // Indices of each geometry instance shifted to its vertices
+    size_t geometryVertexCount = m_pMeshGeometry->pos.size();
+    size_t geometryIndexCount = m_pMeshGeometry->indices.size();
+
+    for (int instance = 0; instance < m_geoAmount; ++instance)
+    {
+        std::uint16_t baseIndex = static_cast<std::uint16_t>(instance * geometryVertexCount);
+        std::uint16_t* pInstanceIndices = pDestination + instance * geometryIndexCount;
+        for (size_t i = 0; i < geometryIndexCount; ++i)
+            pInstanceIndices[i] = m_pMeshGeometry->indices[i] + baseIndex;
+    }
+}
+
+void GCMesh::ComputeBounds()
+{
+    // Geometries built outside the factories/loaders may not have their bounds yet
+    if (m_pMeshGeometry->hasBounds == false)
+        m_pMeshGeometry->ComputeBounds();
+
+    const DirectX::BoundingBox& geometryBox = m_pMeshGeometry->boundingBox;
 
-    m_pBufferGeometryData->IndexCount = static_cast<UINT>(m_pMeshGeometry->indices.size());
+    for (int instance = 0; instance < m_geoAmount; ++instance)
+    {
+        DirectX::BoundingBox instanceBox = geometryBox;
+        instanceBox.Center.x += m_geometryPositions[instance].x;
+        instanceBox.Center.y += m_geometryPositions[instance].y;
+        instanceBox.Center.z += m_geometryPositions[instance].z;
+
+        if (instance == 0)
+            m_boundingBox = instanceBox;
+        else
+            DirectX::BoundingBox::CreateMerged(m_boundingBox, m_boundingBox, instanceBox);
+    }
 }
 
+bool GCMesh::CheckEditable(const char* operation) const
+{
+    if (IsEditable())
+        return true;
+
+    GCGraphicsLogger::GetInstance().LogWarning(std::string("Can't ") + operation + ", the mesh isn't editable (GC_MESH_STORAGE_GPU_ONLY)");
+    return false;
+}
 
-void GCMesh::AddGeometry(DirectX::XMFLOAT3 position)
+bool GCMesh::AddGeometry(DirectX::XMFLOAT3 position)
 {
+    // A gpu only mesh couldn't rebuild its buffers with the new instance
+    if (CheckEditable("add a mesh geometry") == false)
+        return false;
+
     m_geometryPositions.push_back(position);
     m_geoAmount += 1;
+    return true;
 }
 
-void GCMesh::DeleteGeometryAt(int index)
+bool GCMesh::DeleteGeometryAt(int index)
 {
+    if (CheckEditable("delete a mesh geometry") == false)
+        return false;
+
     m_geometryPositions.erase(m_geometryPositions.begin() + index);
     m_geoAmount -= 1;
+    return true;
 }
 
-void GCMesh::EditGeometryPositionAt(int index, DirectX::XMFLOAT3 newPosition)
+bool GCMesh::EditGeometryPositionAt(int index, DirectX::XMFLOAT3 newPosition)
 {
+    if (CheckEditable("move a mesh geometry") == false)
+        return false;
+
     m_geometryPositions[index] = newPosition;
+    return true;
 }
 
-void GCMesh::UpdateGeometryData()
-{
-    std::vector<float> vertexData;
-    size_t vertexSize = 0;
-
-    // Manage offset bits size for reserve vector
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_POSITION)) vertexSize += 3;
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_COLOR)) vertexSize += 4;
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_UV)) vertexSize += 2;
-    if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_NORMAL)) vertexSize += 3;
-
-    vertexData.reserve(m_pMeshGeometry->pos.size() * vertexSize * m_geoAmount);
-
-    for (int instance = 0; instance < m_geoAmount; ++instance) {
-
-        for (size_t i = 0; i < m_pMeshGeometry->pos.size(); ++i) {
-            if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_POSITION)) {
-                vertexData.push_back(m_pMeshGeometry->pos[i].x + m_geometryPositions[instance].x);
-                vertexData.push_back(m_pMeshGeometry->pos[i].y + m_geometryPositions[instance].y);
-                vertexData.push_back(m_pMeshGeometry->pos[i].z + m_geometryPositions[instance].z);
-            }
-            if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_COLOR)) {
-                vertexData.push_back(m_pMeshGeometry->color[i].x);
-                vertexData.push_back(m_pMeshGeometry->color[i].y);
-                vertexData.push_back(m_pMeshGeometry->color[i].z);
-                vertexData.push_back(m_pMeshGeometry->color[i].w);
-            }
-            if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_UV)) {
-                vertexData.push_back(m_pMeshGeometry->uv[i].x);
-                vertexData.push_back(m_pMeshGeometry->uv[i].y);
-            }
-            if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_NORMAL)) {
-                vertexData.push_back(m_pMeshGeometry->normals[i].x);
-                vertexData.push_back(m_pMeshGeometry->normals[i].y);
-                vertexData.push_back(m_pMeshGeometry->normals[i].z);
-            }
-        }
-    }
-
-    // Duplicate the index data for 2 instances
-    std::vector<std::uint16_t> indices;
-    indices.reserve(m_pMeshGeometry->indices.size() * 20);
-    for (int instance = 0; instance < m_geoAmount; ++instance) {
-        std::uint16_t baseIndex = static_cast<std::uint16_t>(instance * m_pMeshGeometry->pos.size());
-        for (auto index : m_pMeshGeometry->indices) {
-            indices.push_back(index + baseIndex);
-        }
-    }
+bool GCMesh::UpdateGeometryData()
+{
+    if (CheckEditable("update mesh geometry") == false)
+        return false;
 
-    const UINT vbByteSize = static_cast<UINT>(vertexData.size() * sizeof(float));
-    const UINT ibByteSize = static_cast<UINT>(indices.size() * sizeof(std::uint16_t));
+    // Buffers of the previous data, the last frame is flushed so the GPU is done with them
+    ReleaseBufferData();
 
-    m_pBufferGeometryData = new GC_MESH_BUFFER_DATA();
+    CreateBuffers();
+    ComputeBounds();
+    return true;
+}
 
-    D3DCreateBlob(vbByteSize, &m_pBufferGeometryData->pVertexBufferCPU);
-    CopyMemory(m_pBufferGeometryData->pVertexBufferCPU->GetBufferPointer(), vertexData.data(), vbByteSize);
-    D3DCreateBlob(ibByteSize, &m_pBufferGeometryData->pIndexBufferCPU);
-    CopyMemory(m_pBufferGeometryData->pIndexBufferCPU->GetBufferPointer(), indices.data(), ibByteSize);
+GC_MESH_MEMORY GCMesh::GetMemoryUsage() const
+{
+    GC_MESH_MEMORY memory;
+    if (m_pBufferGeometryData == nullptr)
+        return memory;
 
-    auto vertexBuffer = std::make_unique<GCUploadBuffer<float>>(m_pRender->GetRenderResources()->Getmd3dDevice(), static_cast<UINT>(vertexData.size()), false);
-    auto indexBuffer = std::make_unique<GCUploadBuffer<std::uint16_t>>(m_pRender->GetRenderResources()->Getmd3dDevice(), static_cast<UINT>(indices.size()), false);
+    memory.vertexBufferBytes = m_pBufferGeometryData->VertexBufferByteSize;
+    memory.indexBufferBytes = m_pBufferGeometryData->IndexBufferByteSize;
 
-    vertexBuffer->CopyData(0, vertexData.data(), vbByteSize);
-    indexBuffer->CopyData(0, indices.data(), ibByteSize);
+    if (m_isStaticBuffer)
+    {
+        memory.gpuAllocatedBytes = m_vertexAllocation.size + m_indexAllocation.size;
+    }
+    else
+    {
+        ID3D12Device* pDevice = m_pRender->GetRenderResources()->Getmd3dDevice();
+        ID3D12Resource* buffers[] = { m_pBufferGeometryData->pVertexBufferGPU, m_pBufferGeometryData->pIndexBufferGPU };
+        for (ID3D12Resource* pBuffer : buffers)
+        {
+            D3D12_RESOURCE_DESC desc = pBuffer->GetDesc();
+            memory.gpuAllocatedBytes += pDevice->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+        }
+    }
 
-    m_pBufferGeometryData->pVertexBufferGPU = vertexBuffer->Resource();
-    m_pBufferGeometryData->pIndexBufferGPU = indexBuffer->Resource();
-    m_pBufferGeometryData->pVertexBufferUploader = vertexBuffer.release()->Resource();
-    m_pBufferGeometryData->pIndexBufferUploader = indexBuffer.release()->Resource();
+    if (m_pBufferGeometryData->pVertexBufferCPU)
+        memory.cpuCopyBytes += m_pBufferGeometryData->pVertexBufferCPU->GetBufferSize();
+    if (m_pBufferGeometryData->pIndexBufferCPU)
+        memory.cpuCopyBytes += m_pBufferGeometryData->pIndexBufferCPU->GetBufferSize();
 
-    m_pBufferGeometryData->VertexByteStride = static_cast<UINT>(vertexSize * sizeof(float));
-    m_pBufferGeometryData->VertexBufferByteSize = vbByteSize;
-    m_pBufferGeometryData->IndexFormat = DXGI_FORMAT_R16_UINT;
-    m_pBufferGeometryData->IndexBufferByteSize = ibByteSize;
+    if (m_pMeshGeometry)
+    {
+        memory.geometryBytes = m_pMeshGeometry->pos.size() * sizeof(DirectX::XMFLOAT3)
+            + m_pMeshGeometry->color.size() * sizeof(DirectX::XMFLOAT4)
+            + m_pMeshGeometry->uv.size() * sizeof(DirectX::XMFLOAT2)
+            + m_pMeshGeometry->normals.size() * sizeof(DirectX::XMFLOAT3)
+            + m_pMeshGeometry->indices.size() * sizeof(std::uint16_t);
+    }
 
-    m_pBufferGeometryData->IndexCount = static_cast<UINT>(indices.size());
+    return memory;
 }
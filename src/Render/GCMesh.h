@@ -1,24 +1,75 @@
 #pragma once
 
+// What GCMesh keeps in system memory once its buffers are uploaded
+enum GC_MESH_STORAGE
+{
+	GC_MESH_STORAGE_GPU_ONLY, // DEFAULT heap buffers, the geometry is only read by Initialize : the caller can release it after
+	GC_MESH_STORAGE_EDITABLE, // Keeps the geometry pointer : UpdateGeometryData packs it again
+	GC_MESH_STORAGE_CPU_COPY, // Editable, and keeps the packed vertices / indices in the buffer data blobs (picking)
+};
+
+// Bytes held by a mesh, GCGraphics::LogMeshMemoryReport sums them
+struct GC_MESH_MEMORY
+{
+	UINT64 vertexBufferBytes = 0;
+	UINT64 indexBufferBytes = 0;
+	UINT64 gpuAllocatedBytes = 0; // Real cost : 64KB aligned committed buffers, power of 2 blocks of the gpu allocator
+	UINT64 cpuCopyBytes = 0; // Blobs, GC_MESH_STORAGE_CPU_COPY only
+	UINT64 geometryBytes = 0; // Geometry referenced by an editable mesh, owned by the caller
+
+	void Add(const GC_MESH_MEMORY& other)
+	{
+		vertexBufferBytes += other.vertexBufferBytes;
+		indexBufferBytes += other.indexBufferBytes;
+		gpuAllocatedBytes += other.gpuAllocatedBytes;
+		cpuCopyBytes += other.cpuCopyBytes;
+		geometryBytes += other.geometryBytes;
+	}
+};
+
 class GCMesh
 {
 public:
 	GCMesh();
     ~GCMesh();
 
-    GC_GRAPHICS_ERROR Initialize(GCRenderContext* pRender, GCGeometry* pGeometry, int& flagEnabledBits);
+    GC_GRAPHICS_ERROR Initialize(GCRenderContext* pRender, GCGeometry* pGeometry, int& flagEnabledBits, GC_MESH_STORAGE storage = GC_MESH_STORAGE_GPU_ONLY);
 
-    void UpdateGeometryData();
+    // Editable meshes only, a gpu only mesh doesn't have its geometry anymore. False (warning logged) on a gpu only mesh
+    bool UpdateGeometryData();
 
     inline GC_MESH_BUFFER_DATA* GetBufferGeometryData() { return  m_pBufferGeometryData; }
     inline int GetFlagEnabledBits() const { return m_flagEnabledBits; }
+    inline GC_MESH_STORAGE GetStorage() const { return m_storage; }
+    inline bool IsEditable() const { return m_storage != GC_MESH_STORAGE_GPU_ONLY; }
+    // DEFAULT heap buffers : gpu only meshes, unless they didn't fit in the staging ring
+    inline bool HasStaticBuffers() const { return m_isStaticBuffer; }
+
+    GC_MESH_MEMORY GetMemoryUsage() const;
+
+    // Local bounds of every geometry instance of the mesh
+    inline const DirectX::BoundingBox& GetBoundingBox() const { return m_boundingBox; }
 
-    void AddGeometry(DirectX::XMFLOAT3 position);
-    void DeleteGeometryAt(int index);
-    void EditGeometryPositionAt(int index, DirectX::XMFLOAT3 newPosition);
+    // Geometry instances, applied by the next UpdateGeometryData : editable meshes only, false on a gpu only mesh
+    bool AddGeometry(DirectX::XMFLOAT3 position);
+    bool DeleteGeometryAt(int index);
+    bool EditGeometryPositionAt(int index, DirectX::XMFLOAT3 newPosition);
 
 private:
     void UploadGeometryData(int& flagEnabledBits);
+    // Vertex / index buffers of every geometry instance, laid out by GCVertexLayout
+    void CreateBuffers();
+    // Ranges of the gpu allocator default buffers filled through the staging ring, false when they can't be staged
+    bool CreateStaticBuffers(UINT vbByteSize, UINT ibByteSize);
+    void CreateUploadBuffers(UINT vbByteSize, UINT indexCount);
+    void PackVertices(BYTE* pDestination);
+    void PackIndices(std::uint16_t* pDestination);
+    void ReleaseBufferData();
+    // Upload buffers and CPU copies reported to the memory tracker, static buffers are by the gpu allocator
+    void TrackBufferMemory(bool isAdded);
+    void ComputeBounds();
+    // Logs a warning when the mesh is gpu only
+    bool CheckEditable(const char* operation) const;
 
     GCRenderContext* m_pRender;
     GC_MESH_BUFFER_DATA* m_pBufferGeometryData;
@@ -26,13 +77,24 @@ private:
     GCGeometry* m_pMeshGeometry;
     std::vector<DirectX::XMFLOAT3> m_geometryPositions;
 
+    DirectX::BoundingBox m_boundingBox;
+
     int m_flagEnabledBits;
+    GC_MESH_STORAGE m_storage;
+    bool m_isStaticBuffer;
     int m_geoAmount;
 
-    int m_currentVertexUploadBufferSize;
-    int m_currentIndexUploadBufferSize;
+    int m_currentVertexUploadBufferSize; // Bytes
+    int m_currentIndexUploadBufferSize; // Indices
 
+    // Own the mapping of the buffer data resources, upload heap buffers only
     GCUploadBufferBase* m_pVertexBuffer;
     GCUploadBufferBase* m_pIndexBuffer;
+
+    // Static buffers
+    GC_GPU_ALLOCATION m_vertexAllocation;
+    GC_GPU_ALLOCATION m_indexAllocation;
+
+    static constexpr UINT64 m_bufferAlignment = 4;
 };
 
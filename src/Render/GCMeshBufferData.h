@@ -12,6 +12,9 @@ struct GC_MESH_BUFFER_DATA
     ID3D12Resource* pIndexBufferUploader = nullptr;
 
     // Data about the buffers.
+    // Offsets in the resources, the gpu allocator places several buffers in one
+    UINT64 VertexBufferOffset = 0;
+    UINT64 IndexBufferOffset = 0;
     UINT VertexByteStride = 0;
     UINT VertexBufferByteSize = 0;
     DXGI_FORMAT IndexFormat = DXGI_FORMAT_R16_UINT;
@@ -22,7 +25,7 @@ struct GC_MESH_BUFFER_DATA
     D3D12_VERTEX_BUFFER_VIEW VertexBufferView()const
     {
         D3D12_VERTEX_BUFFER_VIEW vbv;
-        vbv.BufferLocation = pVertexBufferGPU->GetGPUVirtualAddress();
+        vbv.BufferLocation = pVertexBufferGPU->GetGPUVirtualAddress() + VertexBufferOffset;
         vbv.StrideInBytes = VertexByteStride;
         vbv.SizeInBytes = VertexBufferByteSize;
 
@@ -32,7 +35,7 @@ struct GC_MESH_BUFFER_DATA
     D3D12_INDEX_BUFFER_VIEW IndexBufferView() const
     {
         D3D12_INDEX_BUFFER_VIEW ibv;
-        ibv.BufferLocation = pIndexBufferGPU->GetGPUVirtualAddress();
+        ibv.BufferLocation = pIndexBufferGPU->GetGPUVirtualAddress() + IndexBufferOffset;
         ibv.Format = IndexFormat;
         ibv.SizeInBytes = IndexBufferByteSize;
 
@@ -27,6 +27,7 @@ bool GCModelParserFactory::Parse(std::string fileName, GC_EXTENSIONS fileExtensi
 
 GC_GRAPHICS_ERROR GCModelParserFactory::BuildModel(std::string fileName, DirectX::XMFLOAT4 color, GC_EXTENSIONS fileExtension, GCGeometry* pGeometry)
 {
+	GC_PROFILE_FUNCTION();
 	if (GC_CHECK_POINTERSNULL("Model geometry loaded successfully", "Model Geometry is empty", pGeometry) == false)
 		return GCRENDER_ERROR_POINTER_NULL;
 	if (GC_CHECK_FILE(fileName, ("Model file not found: " + fileName), ("Model file:" + fileName + " loaded successfully")) == false)
@@ -55,6 +56,8 @@ GC_GRAPHICS_ERROR GCModelParserFactory::BuildModel(std::string fileName, DirectX
 		pGeometry->indices.push_back(i);
 	}
 
+	pGeometry->ComputeBounds();
+
 	return GCRENDER_SUCCESS_OK;
 }
 
@@ -49,6 +49,7 @@ GCModelParserObj::~GCModelParserObj()
 
 GC_MODELINFOS* GCModelParserObj::Parse(std::string filePath)
 {
+	GC_PROFILE_FUNCTION();
 	//Parses the file into a vector with the coordinates, the triangles and the uvs
 	std::ifstream objFile(filePath);
 	std::string line;
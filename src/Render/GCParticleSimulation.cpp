@@ -0,0 +1,238 @@
+#include "pch.h"
+
+GCParticleSimulation::GCParticleSimulation()
+    : m_count(0),
+    m_capacity(0),
+    m_spawnAccumulator(0.0f)
+{
+}
+
+void GCParticleSimulation::Initialize(const GC_PARTICLE_EMITTER_DESC& desc, uint32_t seed)
+{
+    m_desc = desc;
+    m_desc.maxParticles = std::max(desc.maxParticles, 0);
+
+    m_random.seed(seed != 0 ? seed : std::random_device()());
+
+    // Rounded up so the last SIMD lane group never reads past the arrays
+    m_capacity = (m_desc.maxParticles + m_simdWidth - 1) / m_simdWidth * m_simdWidth;
+
+    std::vector<float>* arrays[] = { &m_vPositionX, &m_vPositionY, &m_vPositionZ, &m_vVelocityX, &m_vVelocityY, &m_vVelocityZ, &m_vAge, &m_vLifetime };
+    for (std::vector<float>* pArray : arrays)
+        pArray->assign(m_capacity, 0.0f);
+
+    Clear();
+}
+
+void GCParticleSimulation::SetDesc(const GC_PARTICLE_EMITTER_DESC& desc)
+{
+    int maxParticles = m_desc.maxParticles;
+    m_desc = desc;
+    m_desc.maxParticles = maxParticles;
+}
+
+void GCParticleSimulation::Clear()
+{
+    m_count = 0;
+    m_spawnAccumulator = 0.0f;
+}
+
+void GCParticleSimulation::Update(float deltaTime, GCThreadPool* pThreadPool)
+{
+    if (m_count > 0)
+    {
+        int paddedCount = (m_count + m_simdWidth - 1) / m_simdWidth * m_simdWidth;
+        ForEachRange(paddedCount, pThreadPool, [&](int begin, int end) { Integrate(begin, end, deltaTime); });
+
+        Compact();
+    }
+
+    Burst(ConsumeSpawnCount(deltaTime));
+}
+
+void GCParticleSimulation::Integrate(int begin, int end, float deltaTime)
+{
+    using namespace DirectX;
+
+    // Same steps as particleSimulation.hlsl
+    const XMVECTOR dt = XMVectorReplicate(deltaTime);
+    const XMVECTOR gravityX = XMVectorReplicate(m_desc.gravity.x * deltaTime);
+    const XMVECTOR gravityY = XMVectorReplicate(m_desc.gravity.y * deltaTime);
+    const XMVECTOR gravityZ = XMVectorReplicate(m_desc.gravity.z * deltaTime);
+    const XMVECTOR damping = XMVectorReplicate(std::max(1.0f - m_desc.drag * deltaTime, 0.0f));
+
+    // 4 consecutive particles of one component per vector
+    XMFLOAT4* pPositionX = reinterpret_cast<XMFLOAT4*>(m_vPositionX.data());
+    XMFLOAT4* pPositionY = reinterpret_cast<XMFLOAT4*>(m_vPositionY.data());
+    XMFLOAT4* pPositionZ = reinterpret_cast<XMFLOAT4*>(m_vPositionZ.data());
+    XMFLOAT4* pVelocityX = reinterpret_cast<XMFLOAT4*>(m_vVelocityX.data());
+    XMFLOAT4* pVelocityY = reinterpret_cast<XMFLOAT4*>(m_vVelocityY.data());
+    XMFLOAT4* pVelocityZ = reinterpret_cast<XMFLOAT4*>(m_vVelocityZ.data());
+    XMFLOAT4* pAge = reinterpret_cast<XMFLOAT4*>(m_vAge.data());
+
+    for (int group = begin / m_simdWidth; group < end / m_simdWidth; group++)
+    {
+        XMVECTOR velocityX = XMVectorMultiply(XMVectorAdd(XMLoadFloat4(&pVelocityX[group]), gravityX), damping);
+        XMVECTOR velocityY = XMVectorMultiply(XMVectorAdd(XMLoadFloat4(&pVelocityY[group]), gravityY), damping);
+        XMVECTOR velocityZ = XMVectorMultiply(XMVectorAdd(XMLoadFloat4(&pVelocityZ[group]), gravityZ), damping);
+
+        XMStoreFloat4(&pVelocityX[group], velocityX);
+        XMStoreFloat4(&pVelocityY[group], velocityY);
+        XMStoreFloat4(&pVelocityZ[group], velocityZ);
+
+        XMStoreFloat4(&pPositionX[group], XMVectorMultiplyAdd(velocityX, dt, XMLoadFloat4(&pPositionX[group])));
+        XMStoreFloat4(&pPositionY[group], XMVectorMultiplyAdd(velocityY, dt, XMLoadFloat4(&pPositionY[group])));
+        XMStoreFloat4(&pPositionZ[group], XMVectorMultiplyAdd(velocityZ, dt, XMLoadFloat4(&pPositionZ[group])));
+
+        XMStoreFloat4(&pAge[group], XMVectorAdd(XMLoadFloat4(&pAge[group]), dt));
+    }
+}
+
+void GCParticleSimulation::Compact()
+{
+    // Serial : the last alive particle fills each hole, a single pass whatever the thread count
+    int i = 0;
+    while (i < m_count)
+    {
+        if (m_vAge[i] < m_vLifetime[i])
+        {
+            i++;
+            continue;
+        }
+
+        m_count--;
+        m_vPositionX[i] = m_vPositionX[m_count];
+        m_vPositionY[i] = m_vPositionY[m_count];
+        m_vPositionZ[i] = m_vPositionZ[m_count];
+        m_vVelocityX[i] = m_vVelocityX[m_count];
+        m_vVelocityY[i] = m_vVelocityY[m_count];
+        m_vVelocityZ[i] = m_vVelocityZ[m_count];
+        m_vAge[i] = m_vAge[m_count];
+        m_vLifetime[i] = m_vLifetime[m_count];
+    }
+}
+
+int GCParticleSimulation::ConsumeSpawnCount(float deltaTime)
+{
+    m_spawnAccumulator += m_desc.spawnRate * deltaTime;
+
+    int spawnCount = static_cast<int>(m_spawnAccumulator);
+    m_spawnAccumulator -= spawnCount;
+
+    return spawnCount;
+}
+
+int GCParticleSimulation::Burst(int count)
+{
+    int emitCount = std::min(count, m_desc.maxParticles - m_count);
+    if (emitCount <= 0)
+        return 0;
+
+    GCPARTICLE particle;
+    for (int i = 0; i < emitCount; i++)
+    {
+        GenerateParticle(particle);
+
+        m_vPositionX[m_count] = particle.position.x;
+        m_vPositionY[m_count] = particle.position.y;
+        m_vPositionZ[m_count] = particle.position.z;
+        m_vVelocityX[m_count] = particle.velocity.x;
+        m_vVelocityY[m_count] = particle.velocity.y;
+        m_vVelocityZ[m_count] = particle.velocity.z;
+        m_vAge[m_count] = 0.0f;
+        m_vLifetime[m_count] = particle.lifetime;
+        m_count++;
+    }
+
+    return emitCount;
+}
+
+void GCParticleSimulation::GenerateParticle(GCPARTICLE& outParticle)
+{
+    outParticle.position.x = m_desc.position.x + RandomRange(-m_desc.positionSpread.x, m_desc.positionSpread.x);
+    outParticle.position.y = m_desc.position.y + RandomRange(-m_desc.positionSpread.y, m_desc.positionSpread.y);
+    outParticle.position.z = m_desc.position.z + RandomRange(-m_desc.positionSpread.z, m_desc.positionSpread.z);
+
+    outParticle.velocity.x = RandomRange(m_desc.velocityMin.x, m_desc.velocityMax.x);
+    outParticle.velocity.y = RandomRange(m_desc.velocityMin.y, m_desc.velocityMax.y);
+    outParticle.velocity.z = RandomRange(m_desc.velocityMin.z, m_desc.velocityMax.z);
+
+    // Never 0 : size and color are interpolated with age / lifetime
+    outParticle.lifetime = std::max(RandomRange(m_desc.lifetimeMin, m_desc.lifetimeMax), 0.001f);
+    outParticle.age = 0.0f;
+
+    outParticle.size = m_desc.startSize;
+    outParticle.color = m_desc.startColor;
+
+    outParticle.padding[0] = 0.0f;
+    outParticle.padding[1] = 0.0f;
+    outParticle.padding[2] = 0.0f;
+}
+
+void GCParticleSimulation::Pack(GCPARTICLE* pDestination, GCThreadPool* pThreadPool) const
+{
+    if (m_count == 0)
+        return;
+
+    ForEachRange(m_count, pThreadPool, [&](int begin, int end) { PackRange(pDestination, begin, end); });
+}
+
+void GCParticleSimulation::PackRange(GCPARTICLE* pDestination, int begin, int end) const
+{
+    const GC_PARTICLE_EMITTER_DESC& desc = m_desc;
+
+    for (int i = begin; i < end; i++)
+    {
+        float t = std::min(m_vAge[i] / m_vLifetime[i], 1.0f);
+
+        // Local copy written at once : upload memory is write combined, never read it back
+        GCPARTICLE particle;
+        particle.position = DirectX::XMFLOAT3(m_vPositionX[i], m_vPositionY[i], m_vPositionZ[i]);
+        particle.size = desc.startSize + (desc.endSize - desc.startSize) * t;
+        particle.color.x = desc.startColor.x + (desc.endColor.x - desc.startColor.x) * t;
+        particle.color.y = desc.startColor.y + (desc.endColor.y - desc.startColor.y) * t;
+        particle.color.z = desc.startColor.z + (desc.endColor.z - desc.startColor.z) * t;
+        particle.color.w = desc.startColor.w + (desc.endColor.w - desc.startColor.w) * t;
+        particle.velocity = DirectX::XMFLOAT3(m_vVelocityX[i], m_vVelocityY[i], m_vVelocityZ[i]);
+        particle.age = m_vAge[i];
+        particle.lifetime = m_vLifetime[i];
+        particle.padding[0] = 0.0f;
+        particle.padding[1] = 0.0f;
+        particle.padding[2] = 0.0f;
+
+        pDestination[i] = particle;
+    }
+}
+
+void GCParticleSimulation::ForEachRange(int count, GCThreadPool* pThreadPool, const std::function<void(int, int)>& function) const
+{
+    int taskCount = (count + m_particlesPerTask - 1) / m_particlesPerTask;
+    if (pThreadPool == nullptr || taskCount < 2)
+    {
+        function(0, count);
+        return;
+    }
+
+    // Fixed size ranges : every begin stays a multiple of m_simdWidth
+    pThreadPool->ParallelFor(taskCount, [&](int taskIndex, int)
+    {
+        int begin = taskIndex * m_particlesPerTask;
+        function(begin, std::min(begin + m_particlesPerTask, count));
+    });
+}
+
+DirectX::XMFLOAT3 GCParticleSimulation::GetPosition(int index) const
+{
+    return DirectX::XMFLOAT3(m_vPositionX[index], m_vPositionY[index], m_vPositionZ[index]);
+}
+
+DirectX::XMFLOAT3 GCParticleSimulation::GetVelocity(int index) const
+{
+    return DirectX::XMFLOAT3(m_vVelocityX[index], m_vVelocityY[index], m_vVelocityZ[index]);
+}
+
+float GCParticleSimulation::RandomRange(float min, float max)
+{
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    return min + (max - min) * unit(m_random);
+}
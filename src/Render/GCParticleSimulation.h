@@ -0,0 +1,92 @@
+#pragma once
+
+// Emitter settings, shared by the CPU and GPU simulations
+struct GC_PARTICLE_EMITTER_DESC
+{
+	DirectX::XMFLOAT3 position = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	DirectX::XMFLOAT3 positionSpread = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f); // New particles spawn in position +- spread
+	float spawnRate = 100.0f; // Particles per second, 0 for bursts only
+
+	float lifetimeMin = 1.0f; // Seconds
+	float lifetimeMax = 2.0f;
+	DirectX::XMFLOAT3 velocityMin = DirectX::XMFLOAT3(-1.0f, -1.0f, 0.0f);
+	DirectX::XMFLOAT3 velocityMax = DirectX::XMFLOAT3(1.0f, 1.0f, 0.0f);
+
+	DirectX::XMFLOAT3 gravity = DirectX::XMFLOAT3(0.0f, -9.81f, 0.0f);
+	float drag = 0.0f; // Fraction of the velocity lost per second
+
+	// Interpolated over the particle lifetime
+	float startSize = 0.1f;
+	float endSize = 0.0f;
+	DirectX::XMFLOAT4 startColor = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+	DirectX::XMFLOAT4 endColor = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+
+	int maxParticles = 4096;
+};
+
+// CPU particle simulation. Particles are stored as a structure of arrays, integrated 4 at a time (DirectXMath vectors) and split
+// on the thread pool when there are enough of them. Dead particles are swap removed : order isn't kept.
+// Needs no device (standard library, DirectXMath and GCThreadPool only), it runs the same without a window
+class GCParticleSimulation
+{
+public:
+	GCParticleSimulation();
+
+	// seed 0 -> random seed
+	void Initialize(const GC_PARTICLE_EMITTER_DESC& desc, uint32_t seed = 0);
+	// maxParticles is fixed by Initialize, other settings apply from the next Update / emission
+	void SetDesc(const GC_PARTICLE_EMITTER_DESC& desc);
+	inline const GC_PARTICLE_EMITTER_DESC& GetDesc() const { return m_desc; }
+	void SetPosition(const DirectX::XMFLOAT3& position) { m_desc.position = position; }
+
+	// Integrates every particle, removes the dead ones then emits from spawnRate. pThreadPool is optional
+	void Update(float deltaTime, GCThreadPool* pThreadPool = nullptr);
+	// Emits count particles now, capped by the free capacity. Returns the emitted count
+	int Burst(int count);
+	void Clear();
+
+	// Particles due from spawnRate over deltaTime, the fraction left is kept for the next call
+	int ConsumeSpawnCount(float deltaTime);
+	// New particle randomized from the desc, age 0
+	void GenerateParticle(GCPARTICLE& outParticle);
+
+	// Writes the GetCount() particles, size and color interpolated from their age (e.g. in mapped upload memory)
+	void Pack(GCPARTICLE* pDestination, GCThreadPool* pThreadPool = nullptr) const;
+
+	inline int GetCount() const { return m_count; }
+	inline int GetMaxParticles() const { return m_desc.maxParticles; }
+	DirectX::XMFLOAT3 GetPosition(int index) const;
+	DirectX::XMFLOAT3 GetVelocity(int index) const;
+	inline float GetAge(int index) const { return m_vAge[index]; }
+	inline float GetLifetime(int index) const { return m_vLifetime[index]; }
+
+	static constexpr int m_simdWidth = 4;
+	// Multiple of m_simdWidth. Below, splitting the work on the pool costs more than it saves
+	static constexpr int m_particlesPerTask = 4096;
+
+private:
+	// [begin, end) multiples of m_simdWidth, end may go past m_count : padding lanes are integrated and ignored
+	void Integrate(int begin, int end, float deltaTime);
+	void Compact();
+	void PackRange(GCPARTICLE* pDestination, int begin, int end) const;
+	void ForEachRange(int count, GCThreadPool* pThreadPool, const std::function<void(int, int)>& function) const;
+
+	float RandomRange(float min, float max);
+
+	GC_PARTICLE_EMITTER_DESC m_desc;
+
+	int m_count;
+	int m_capacity; // maxParticles rounded up to m_simdWidth
+	float m_spawnAccumulator;
+
+	std::vector<float> m_vPositionX;
+	std::vector<float> m_vPositionY;
+	std::vector<float> m_vPositionZ;
+	std::vector<float> m_vVelocityX;
+	std::vector<float> m_vVelocityY;
+	std::vector<float> m_vVelocityZ;
+	std::vector<float> m_vAge;
+	std::vector<float> m_vLifetime;
+
+	std::mt19937 m_random;
+};
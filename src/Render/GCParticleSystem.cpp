@@ -0,0 +1,238 @@
+#include "pch.h"
+
+GCParticleSystem::GCParticleSystem()
+    : m_pGraphics(nullptr),
+    m_pMaterial(nullptr),
+    m_pMesh(nullptr),
+    m_mode(GC_PARTICLE_SIMULATION_CPU),
+    m_pendingBurst(0),
+    m_pUploadBuffer(nullptr),
+    m_uploadSrv(),
+    m_pSimulationShader(nullptr),
+    m_pParticleBuffer(nullptr),
+    m_particleBufferState(D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+    m_particleUav(),
+    m_particleSrv(),
+    m_spawnStart(0),
+    m_usedSlotCount(0)
+{
+}
+
+GCParticleSystem::~GCParticleSystem()
+{
+    Release();
+}
+
+bool GCParticleSystem::Initialize(GCGraphics* pGraphics, GCMaterial* pMaterial, const GC_PARTICLE_EMITTER_DESC& desc, GC_PARTICLE_SIMULATION_MODE mode)
+{
+    Release();
+
+    if (GC_CHECK_POINTERSNULL("Particle system graphics and material are valid", "Can't create particle system, graphics or material is null", pGraphics, pMaterial) == false)
+        return false;
+    if (desc.maxParticles <= 0)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Can't create particle system, maxParticles is 0");
+        return false;
+    }
+
+    m_pGraphics = pGraphics;
+    m_pMaterial = pMaterial;
+    m_mode = mode;
+
+    int meshFlags = 0;
+    GC_SET_FLAG(meshFlags, GC_VERTEX_POSITION);
+    GC_SET_FLAG(meshFlags, GC_VERTEX_UV);
+    GC_RESOURCE_CREATION_RESULT<GCMesh*> meshResult = m_pGraphics->GetPrimitiveMesh(Plane, meshFlags);
+    if (meshResult.success == false)
+        return false;
+    m_pMesh = meshResult.resource;
+
+    m_simulation.Initialize(desc);
+
+    // Cpu : every alive particle. Gpu : at most maxParticles emitted in one Update
+    GCRenderResources* pResources = m_pGraphics->GetRender()->GetRenderResources();
+    m_pUploadBuffer = new GCUploadBuffer<GCPARTICLE>(pResources->Getmd3dDevice(), desc.maxParticles, false);
+    m_uploadSrv = pResources->CreateSrvWithBuffer(m_pUploadBuffer->Resource(), desc.maxParticles, sizeof(GCPARTICLE));
+    pResources->GetMemoryTracker()->Add(GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, pResources->GetResourceSize(m_pUploadBuffer->Resource()));
+    if (m_uploadSrv.ptr == 0)
+    {
+        Release();
+        return false;
+    }
+
+    if (m_mode == GC_PARTICLE_SIMULATION_GPU && CreateGpuResources() == false)
+    {
+        Release();
+        return false;
+    }
+
+    return true;
+}
+
+bool GCParticleSystem::CreateGpuResources()
+{
+    GCRenderResources* pResources = m_pGraphics->GetRender()->GetRenderResources();
+    int maxParticles = m_simulation.GetMaxParticles();
+
+    m_pSimulationShader = new GCComputeShader();
+    int flags = 0;
+    GC_GRAPHICS_ERROR errorState = m_pSimulationShader->Initialize(m_pGraphics->GetRender(), "../../../res/Shaders/particleSimulation.hlsl", "../../../res/CsoCompiled/particleSimulation", flags, D3D12_CULL_MODE_NONE, sizeof(GC_PARTICLE_SIMULATION_CONSTANTS) / sizeof(UINT));
+    if (errorState != 0 || m_pSimulationShader->Load() != 0)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Particle simulation compute shader creation failed");
+        return false;
+    }
+
+    // Zeroed by the device : every slot starts dead (age 0 >= lifetime 0)
+    CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
+    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(static_cast<UINT64>(maxParticles) * sizeof(GCPARTICLE), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+    HRESULT hr = pResources->Getmd3dDevice()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&m_pParticleBuffer));
+    if (GC_CHECK_HRESULT(hr, "Particle buffer creation") == false)
+        return false;
+    m_particleBufferState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    pResources->GetMemoryTracker()->Add(GC_MEMORY_CATEGORY_MESHES, pResources->GetResourceSize(m_pParticleBuffer));
+
+    m_particleUav = pResources->CreateUavWithBuffer(m_pParticleBuffer, maxParticles, sizeof(GCPARTICLE));
+    m_particleSrv = pResources->CreateSrvWithBuffer(m_pParticleBuffer, maxParticles, sizeof(GCPARTICLE));
+
+    return m_particleUav.ptr != 0 && m_particleSrv.ptr != 0;
+}
+
+void GCParticleSystem::Release()
+{
+    if (m_pGraphics)
+    {
+        GCRenderResources* pResources = m_pGraphics->GetRender()->GetRenderResources();
+        if (m_pUploadBuffer)
+            pResources->GetMemoryTracker()->Remove(GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, pResources->GetResourceSize(m_pUploadBuffer->Resource()));
+        if (m_pParticleBuffer)
+            pResources->GetMemoryTracker()->Remove(GC_MEMORY_CATEGORY_MESHES, pResources->GetResourceSize(m_pParticleBuffer));
+
+        // Back to the buffer view range, emitters created later reuse them
+        pResources->ReleaseBufferView(m_uploadSrv);
+        pResources->ReleaseBufferView(m_particleUav);
+        pResources->ReleaseBufferView(m_particleSrv);
+    }
+    m_uploadSrv = D3D12_GPU_DESCRIPTOR_HANDLE();
+    m_particleUav = D3D12_GPU_DESCRIPTOR_HANDLE();
+    m_particleSrv = D3D12_GPU_DESCRIPTOR_HANDLE();
+
+    GC_DELETE(m_pUploadBuffer);
+    GC_DELETE(m_pSimulationShader);
+    if (m_pParticleBuffer)
+    {
+        m_pParticleBuffer->Release();
+        m_pParticleBuffer = nullptr;
+    }
+
+    m_pMesh = nullptr;
+    m_pendingBurst = 0;
+    m_spawnStart = 0;
+    m_usedSlotCount = 0;
+    m_simulation.Clear();
+}
+
+void GCParticleSystem::Update(float deltaTime)
+{
+    if (m_pUploadBuffer == nullptr)
+        return;
+
+    if (m_mode == GC_PARTICLE_SIMULATION_GPU)
+    {
+        UpdateGpu(deltaTime);
+        return;
+    }
+
+    // The previous frame is flushed by CompleteDraw : the upload buffer isn't read anymore
+    GCThreadPool* pThreadPool = m_pGraphics->GetRender()->GetThreadPool();
+    m_simulation.Update(deltaTime, pThreadPool);
+    m_simulation.Pack(reinterpret_cast<GCPARTICLE*>(m_pUploadBuffer->GetMappedData()), pThreadPool);
+}
+
+void GCParticleSystem::UpdateGpu(float deltaTime)
+{
+    int maxParticles = m_simulation.GetMaxParticles();
+
+    int spawnCount = std::min(m_simulation.ConsumeSpawnCount(deltaTime) + m_pendingBurst, maxParticles);
+    m_pendingBurst = 0;
+
+    if (spawnCount == 0 && m_usedSlotCount == 0)
+        return;
+
+    GCPARTICLE* pSpawned = reinterpret_cast<GCPARTICLE*>(m_pUploadBuffer->GetMappedData());
+    GCPARTICLE particle;
+    for (int i = 0; i < spawnCount; i++)
+    {
+        m_simulation.GenerateParticle(particle);
+        pSpawned[i] = particle;
+    }
+
+    const GC_PARTICLE_EMITTER_DESC& desc = m_simulation.GetDesc();
+
+    GC_PARTICLE_SIMULATION_CONSTANTS constants;
+    constants.deltaTime = deltaTime;
+    constants.gravity = desc.gravity;
+    constants.drag = desc.drag;
+    constants.startSize = desc.startSize;
+    constants.endSize = desc.endSize;
+    constants.spawnStart = static_cast<UINT>(m_spawnStart);
+    constants.startColor = desc.startColor;
+    constants.endColor = desc.endColor;
+    constants.spawnCount = static_cast<UINT>(spawnCount);
+    constants.maxParticles = static_cast<UINT>(maxParticles);
+
+    ID3D12GraphicsCommandList* pCommandList = m_pGraphics->GetRender()->GetRenderResources()->GetCommandList();
+
+    if (m_particleBufferState != D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+    {
+        CD3DX12_RESOURCE_BARRIER toUav = CD3DX12_RESOURCE_BARRIER::Transition(m_pParticleBuffer, m_particleBufferState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        pCommandList->ResourceBarrier(1, &toUav);
+        m_particleBufferState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    }
+
+    // Draws record their own pso / root signature : nothing to restore after the dispatch
+    pCommandList->SetPipelineState(m_pSimulationShader->GetPso());
+    pCommandList->SetComputeRootSignature(m_pSimulationShader->GetRootSign());
+    pCommandList->SetComputeRootDescriptorTable(0, m_uploadSrv);
+    pCommandList->SetComputeRootDescriptorTable(1, m_particleUav);
+    pCommandList->SetComputeRoot32BitConstants(2, sizeof(GC_PARTICLE_SIMULATION_CONSTANTS) / sizeof(UINT), &constants, 0);
+    pCommandList->Dispatch((maxParticles + m_threadGroupSize - 1) / m_threadGroupSize, 1, 1);
+
+    CD3DX12_RESOURCE_BARRIER toShaderResource = CD3DX12_RESOURCE_BARRIER::Transition(m_pParticleBuffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    pCommandList->ResourceBarrier(1, &toShaderResource);
+    m_particleBufferState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+
+    m_spawnStart = (m_spawnStart + spawnCount) % maxParticles;
+    m_usedSlotCount = std::min(m_usedSlotCount + spawnCount, maxParticles);
+}
+
+int GCParticleSystem::Burst(int count)
+{
+    if (m_mode == GC_PARTICLE_SIMULATION_CPU)
+        return m_simulation.Burst(count);
+
+    int queuedCount = std::clamp(count, 0, m_simulation.GetMaxParticles() - m_pendingBurst);
+    m_pendingBurst += queuedCount;
+
+    return queuedCount;
+}
+
+int GCParticleSystem::GetCount() const
+{
+    return m_mode == GC_PARTICLE_SIMULATION_CPU ? m_simulation.GetCount() : m_usedSlotCount;
+}
+
+bool GCParticleSystem::Draw()
+{
+    int instanceCount = GetCount();
+    if (m_pMesh == nullptr || instanceCount == 0)
+        return false;
+
+    // Particles are in world space
+    DirectX::XMMATRIX worldMatrix = DirectX::XMMatrixIdentity();
+    m_pGraphics->UpdateWorldConstantBuffer(m_pMaterial, worldMatrix);
+
+    D3D12_GPU_DESCRIPTOR_HANDLE instanceSrv = m_mode == GC_PARTICLE_SIMULATION_CPU ? m_uploadSrv : m_particleSrv;
+
+    return m_pGraphics->GetRender()->DrawObjectInstanced(m_pMesh, m_pMaterial, true, static_cast<UINT>(instanceCount), instanceSrv);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+enum GC_PARTICLE_SIMULATION_MODE
+{
+	GC_PARTICLE_SIMULATION_CPU, // GCParticleSimulation, packed in an upload buffer every frame
+	GC_PARTICLE_SIMULATION_GPU, // particleSimulation.hlsl on a ring of maxParticles slots, only new particles are uploaded
+};
+
+// Root constants of particleSimulation.hlsl, must match cbSimulation
+struct GC_PARTICLE_SIMULATION_CONSTANTS
+{
+	float deltaTime;
+	DirectX::XMFLOAT3 gravity;
+	float drag;
+	float startSize;
+	float endSize;
+	UINT spawnStart;
+	DirectX::XMFLOAT4 startColor;
+	DirectX::XMFLOAT4 endColor;
+	UINT spawnCount;
+	UINT maxParticles;
+};
+
+// Particle emitter, every particle is drawn by a single instanced draw of the plane primitive.
+// Particles are simulated in world space : moving the emitter doesn't move the particles already emitted
+class GCParticleSystem
+{
+public:
+	GCParticleSystem();
+	~GCParticleSystem();
+
+	// pMaterial uses the particle shader (GCGraphics::CreateShaderParticle) and the particle texture.
+	// The gpu mode compiles its own particleSimulation.hlsl compute shader
+	bool Initialize(GCGraphics* pGraphics, GCMaterial* pMaterial, const GC_PARTICLE_EMITTER_DESC& desc, GC_PARTICLE_SIMULATION_MODE mode = GC_PARTICLE_SIMULATION_CPU);
+	void Release();
+
+	// Between StartFrame and EndFrame : the gpu simulation is recorded on the frame command list, before the draws
+	void Update(float deltaTime);
+	// Cpu : emitted now, capped by the free capacity. Gpu : emitted at the next Update, capped by maxParticles.
+	// Returns the count accepted
+	int Burst(int count);
+	// One instanced draw, false when there is nothing to draw
+	bool Draw();
+
+	void SetDesc(const GC_PARTICLE_EMITTER_DESC& desc) { m_simulation.SetDesc(desc); }
+	inline const GC_PARTICLE_EMITTER_DESC& GetDesc() const { return m_simulation.GetDesc(); }
+	void SetPosition(const DirectX::XMFLOAT3& position) { m_simulation.SetPosition(position); }
+
+	inline GC_PARTICLE_SIMULATION_MODE GetMode() const { return m_mode; }
+	// Cpu : alive particles. Gpu : slots drawn, alive or not (dead ones are collapsed by the vertex shader)
+	int GetCount() const;
+
+	inline GCParticleSimulation& GetSimulation() { return m_simulation; }
+
+private:
+	bool CreateGpuResources();
+	void UpdateGpu(float deltaTime);
+
+	GCGraphics* m_pGraphics;
+	GCMaterial* m_pMaterial;
+	GCMesh* m_pMesh; // Shared plane primitive, owned by GCGraphics
+
+	GC_PARTICLE_SIMULATION_MODE m_mode;
+	GCParticleSimulation m_simulation; // Gpu mode : emission only
+	int m_pendingBurst;
+
+	// Cpu : alive particles packed every Update. Gpu : particles emitted this Update
+	GCUploadBuffer<GCPARTICLE>* m_pUploadBuffer;
+	D3D12_GPU_DESCRIPTOR_HANDLE m_uploadSrv;
+
+	// Gpu simulation
+	GCComputeShader* m_pSimulationShader;
+	ID3D12Resource* m_pParticleBuffer;
+	D3D12_RESOURCE_STATES m_particleBufferState;
+	D3D12_GPU_DESCRIPTOR_HANDLE m_particleUav;
+	D3D12_GPU_DESCRIPTOR_HANDLE m_particleSrv;
+	int m_spawnStart; // Next ring slot written, the oldest one
+	int m_usedSlotCount; // Slots written at least once, the draw stops there
+
+	static constexpr int m_threadGroupSize = 256; // numthreads of particleSimulation.hlsl
+};
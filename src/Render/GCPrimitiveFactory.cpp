@@ -471,6 +471,7 @@ bool GCPrimitiveFactory::Initialize()
 
 GC_GRAPHICS_ERROR GCPrimitiveFactory::BuildGeometry(GC_PRIMITIVE_ID index, DirectX::XMFLOAT4 color, GCGeometry* pGeometry)
 {
+    GC_PROFILE_FUNCTION();
     //Builds a texture based geometry using pre-created ones
     //Needs a geometry name
     if (!GC_CHECK_POINTERSNULL("Primitive Geometry built successfully", "Primitive geometry is empty", pGeometry))
@@ -489,5 +490,7 @@ GC_GRAPHICS_ERROR GCPrimitiveFactory::BuildGeometry(GC_PRIMITIVE_ID index, Direc
 
     pGeometry->normals = std::get<std::vector<DirectX::XMFLOAT3>>(m_primitiveInfos[index][L"normals"]);
 
+    pGeometry->ComputeBounds();
+
 	return GCRENDER_SUCCESS_OK;
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "pch.h"
+
+namespace
+{
+    // Buffer of the calling thread, registered by its first zone
+    thread_local void* t_pThreadBuffer = nullptr;
+
+    std::string EscapeJson(const std::string& text)
+    {
+        std::string result;
+        result.reserve(text.size());
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    }
+}
+
+GCProfiler::GCProfiler()
+    : m_epoch(std::chrono::steady_clock::now()),
+    m_isCapturing(false),
+    m_threadCapacity(m_defaultThreadCapacity)
+{
+}
+
+GCProfiler::~GCProfiler()
+{
+    for (GC_PROFILER_THREAD_BUFFER* pBuffer : m_vThreadBuffers)
+    {
+        GC_DELETE(pBuffer);
+    }
+    m_vThreadBuffers.clear();
+}
+
+GCProfiler& GCProfiler::GetInstance()
+{
+    // First zone may be opened by a worker : thread safe initialization, never destroyed (zones of exiting threads)
+    static GCProfiler* s_pInstance = new GCProfiler();
+    return *s_pInstance;
+}
+
+UINT64 GCProfiler::GetTimeNs() const
+{
+    return static_cast<UINT64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count());
+}
+
+GCProfiler::GC_PROFILER_THREAD_BUFFER* GCProfiler::GetThreadBuffer()
+{
+    if (t_pThreadBuffer)
+        return static_cast<GC_PROFILER_THREAD_BUFFER*>(t_pThreadBuffer);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    GC_PROFILER_THREAD_BUFFER* pBuffer = new GC_PROFILER_THREAD_BUFFER();
+    pBuffer->threadId = static_cast<int>(m_vThreadBuffers.size());
+    pBuffer->name = "Thread " + std::to_string(pBuffer->threadId);
+    pBuffer->vZones.resize(m_threadCapacity);
+    pBuffer->zoneCount.store(0, std::memory_order_relaxed);
+    pBuffer->droppedCount.store(0, std::memory_order_relaxed);
+    pBuffer->depth = 0;
+
+    m_vThreadBuffers.push_back(pBuffer);
+    t_pThreadBuffer = pBuffer;
+
+    return pBuffer;
+}
+
+void GCProfiler::SetThreadName(const std::string& name)
+{
+    GC_PROFILER_THREAD_BUFFER* pBuffer = GetThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pBuffer->name = name;
+}
+
+void GCProfiler::SetThreadCapacity(UINT32 zoneCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threadCapacity = std::max<UINT32>(zoneCount, 1);
+}
+
+void GCProfiler::StartCapture()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (GC_PROFILER_THREAD_BUFFER* pBuffer : m_vThreadBuffers)
+    {
+        pBuffer->vZones.resize(m_threadCapacity);
+        pBuffer->zoneCount.store(0, std::memory_order_relaxed);
+        pBuffer->droppedCount.store(0, std::memory_order_relaxed);
+    }
+    m_vFrameMarks.clear();
+
+    m_isCapturing.store(true, std::memory_order_release);
+}
+
+void GCProfiler::StopCapture()
+{
+    m_isCapturing.store(false, std::memory_order_release);
+}
+
+UINT32 GCProfiler::BeginZone()
+{
+    return GetThreadBuffer()->depth++;
+}
+
+void GCProfiler::EndZone(const char* name, UINT64 startNs, UINT32 depth)
+{
+    UINT64 endNs = GetTimeNs();
+    GC_PROFILER_THREAD_BUFFER* pBuffer = GetThreadBuffer();
+    pBuffer->depth = depth;
+
+    // Only the owner thread writes, the count is published once the zone is complete
+    UINT32 index = pBuffer->zoneCount.load(std::memory_order_relaxed);
+    if (index >= pBuffer->vZones.size())
+    {
+        pBuffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    pBuffer->vZones[index] = { name, startNs, endNs, depth };
+    pBuffer->zoneCount.store(index + 1, std::memory_order_release);
+}
+
+void GCProfiler::AddZone(const std::string& trackName, const char* name, UINT64 startNs, UINT64 endNs, UINT32 depth)
+{
+    if (IsCapturing() == false)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Tracks without thread are found by name, never bound to the calling thread
+    GC_PROFILER_THREAD_BUFFER* pBuffer = nullptr;
+    for (GC_PROFILER_THREAD_BUFFER* pThreadBuffer : m_vThreadBuffers)
+    {
+        if (pThreadBuffer->isExternal && pThreadBuffer->name == trackName)
+        {
+            pBuffer = pThreadBuffer;
+            break;
+        }
+    }
+
+    if (pBuffer == nullptr)
+    {
+        pBuffer = new GC_PROFILER_THREAD_BUFFER();
+        pBuffer->threadId = static_cast<int>(m_vThreadBuffers.size());
+        pBuffer->name = trackName;
+        pBuffer->vZones.resize(m_threadCapacity);
+        pBuffer->zoneCount.store(0, std::memory_order_relaxed);
+        pBuffer->droppedCount.store(0, std::memory_order_relaxed);
+        pBuffer->depth = 0;
+        pBuffer->isExternal = true;
+        m_vThreadBuffers.push_back(pBuffer);
+    }
+
+    UINT32 index = pBuffer->zoneCount.load(std::memory_order_relaxed);
+    if (index >= pBuffer->vZones.size())
+    {
+        pBuffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    pBuffer->vZones[index] = { name, startNs, endNs, depth };
+    pBuffer->zoneCount.store(index + 1, std::memory_order_release);
+}
+
+void GCProfiler::MarkFrame(UINT64 frameIndex)
+{
+    if (IsCapturing() == false)
+        return;
+
+    UINT64 timeNs = GetTimeNs();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_vFrameMarks.push_back({ frameIndex, timeNs });
+}
+
+UINT64 GCProfiler::GetZoneCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    UINT64 count = 0;
+    for (const GC_PROFILER_THREAD_BUFFER* pBuffer : m_vThreadBuffers)
+        count += pBuffer->zoneCount.load(std::memory_order_acquire);
+    return count;
+}
+
+UINT64 GCProfiler::GetDroppedZoneCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    UINT64 count = 0;
+    for (const GC_PROFILER_THREAD_BUFFER* pBuffer : m_vThreadBuffers)
+        count += pBuffer->droppedCount.load(std::memory_order_relaxed);
+    return count;
+}
+
+bool GCProfiler::ExportChromeTrace(const std::string& filePath)
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if (file.is_open() == false)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Can't open profiler trace file : " + filePath);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Chrome trace times are microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool isFirstEvent = true;
+    auto separator = [&]() -> std::ofstream& {
+        if (isFirstEvent == false)
+            file << ",\n";
+        isFirstEvent = false;
+        return file;
+    };
+
+    for (const GC_PROFILER_THREAD_BUFFER* pBuffer : m_vThreadBuffers)
+    {
+        separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pBuffer->threadId
+            << ",\"args\":{\"name\":\"" << EscapeJson(pBuffer->name) << "\"}}";
+
+        UINT32 zoneCount = pBuffer->zoneCount.load(std::memory_order_acquire);
+        for (UINT32 i = 0; i < zoneCount; i++)
+        {
+            const GC_PROFILER_ZONE& zone = pBuffer->vZones[i];
+            separator() << "{\"name\":\"" << EscapeJson(zone.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->threadId
+                << ",\"ts\":" << zone.startNs / 1000.0 << ",\"dur\":" << (zone.endNs - zone.startNs) / 1000.0
+                << ",\"args\":{\"depth\":" << zone.depth << "}}";
+        }
+    }
+
+    for (const std::pair<UINT64, UINT64>& frameMark : m_vFrameMarks)
+    {
+        separator() << "{\"name\":\"Frame " << frameMark.first << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":"
+            << frameMark.second / 1000.0 << "}";
+    }
+
+    file << "]}\n";
+
+    return file.good();
+}
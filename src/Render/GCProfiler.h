@@ -0,0 +1,129 @@
+#pragma once
+
+// CPU zone profiler. Zones are timed by GC_PROFILE_SCOPE / GC_PROFILE_FUNCTION, each thread writes its own buffer
+// (no lock, the reader only sees the published events). Zones nest by scope, the export is a Chrome trace
+// (chrome://tracing, ui.perfetto.dev).
+// Compiled only with GC_ENABLE_PROFILER defined (Debug preprocessor definitions of config/*.prj), the macros are empty otherwise
+
+struct GC_PROFILER_ZONE
+{
+	const char* name; // String literal : the pointer is kept
+	UINT64 startNs;
+	UINT64 endNs;
+	UINT32 depth;
+};
+
+class GCProfiler
+{
+public:
+	static constexpr UINT32 m_defaultThreadCapacity = 64 * 1024;
+
+	static GCProfiler& GetInstance();
+
+	// Capture state changes and the export are done between frames, when no zone is open on the workers
+	void StartCapture();
+	void StopCapture();
+	inline bool IsCapturing() const { return m_isCapturing.load(std::memory_order_relaxed); }
+	// Zones per thread kept by a capture, the next zones are dropped once full. Applied by the next StartCapture
+	void SetThreadCapacity(UINT32 zoneCount);
+
+	// Name of the calling thread track in the trace
+	void SetThreadName(const std::string& name);
+	// Frame boundary, an instant event of the trace
+	void MarkFrame(UINT64 frameIndex);
+
+	// Zones and frames captured, false if the file can't be written
+	bool ExportChromeTrace(const std::string& filePath);
+
+	UINT64 GetZoneCount() const;
+	UINT64 GetDroppedZoneCount() const;
+
+	// Nanoseconds since the profiler creation
+	UINT64 GetTimeNs() const;
+
+	// Used by GCProfileScope
+	UINT32 BeginZone();
+	void EndZone(const char* name, UINT64 startNs, UINT32 depth);
+	// Zone timed elsewhere (GPU), written on a named track of its own. Main thread
+	void AddZone(const std::string& trackName, const char* name, UINT64 startNs, UINT64 endNs, UINT32 depth);
+
+private:
+	GCProfiler();
+	~GCProfiler();
+
+	GCProfiler(const GCProfiler&) = delete;
+	GCProfiler& operator=(const GCProfiler&) = delete;
+
+	struct GC_PROFILER_THREAD_BUFFER
+	{
+		int threadId;
+		std::string name;
+		std::vector<GC_PROFILER_ZONE> vZones;
+		std::atomic<UINT32> zoneCount; // Published by the owner thread, zones below it are complete
+		std::atomic<UINT64> droppedCount;
+		UINT32 depth; // Owner thread only
+		bool isExternal = false; // Filled by AddZone, under the lock
+	};
+
+	GC_PROFILER_THREAD_BUFFER* GetThreadBuffer();
+
+	std::chrono::steady_clock::time_point m_epoch;
+	std::atomic<bool> m_isCapturing;
+	UINT32 m_threadCapacity;
+
+	// Registration of a thread, AddZone and the export only, never taken by a zone
+	mutable std::mutex m_mutex;
+	std::vector<GC_PROFILER_THREAD_BUFFER*> m_vThreadBuffers;
+	std::vector<std::pair<UINT64, UINT64>> m_vFrameMarks; // Frame index, time (main thread)
+};
+
+// Times its scope, the zone is written when it ends
+class GCProfileScope
+{
+public:
+	GCProfileScope(const char* name)
+		: m_name(name)
+	{
+		GCProfiler& profiler = GCProfiler::GetInstance();
+		m_isActive = profiler.IsCapturing();
+		if (m_isActive)
+		{
+			m_depth = profiler.BeginZone();
+			m_startNs = profiler.GetTimeNs();
+		}
+	}
+
+	~GCProfileScope()
+	{
+		if (m_isActive)
+			GCProfiler::GetInstance().EndZone(m_name, m_startNs, m_depth);
+	}
+
+	GCProfileScope(const GCProfileScope&) = delete;
+	GCProfileScope& operator=(const GCProfileScope&) = delete;
+
+private:
+	const char* m_name;
+	bool m_isActive;
+	UINT32 m_depth = 0;
+	UINT64 m_startNs = 0;
+};
+
+#ifdef GC_ENABLE_PROFILER
+#define GC_PROFILE_CONCAT_INNER(a, b) a##b
+#define GC_PROFILE_CONCAT(a, b) GC_PROFILE_CONCAT_INNER(a, b)
+// name : string literal
+#define GC_PROFILE_SCOPE(name) \
+    GCProfileScope GC_PROFILE_CONCAT(gcProfileScope, __LINE__)(name)
+#define GC_PROFILE_FUNCTION() \
+    GC_PROFILE_SCOPE(__FUNCTION__)
+#define GC_PROFILE_THREAD_NAME(name) \
+    GCProfiler::GetInstance().SetThreadName(name)
+#define GC_PROFILE_FRAME(frameIndex) \
+    GCProfiler::GetInstance().MarkFrame(frameIndex)
+#else
+#define GC_PROFILE_SCOPE(name) ((void)0)
+#define GC_PROFILE_FUNCTION() ((void)0)
+#define GC_PROFILE_THREAD_NAME(name) ((void)0)
+#define GC_PROFILE_FRAME(frameIndex) ((void)0)
+#endif
@@ -6,12 +6,42 @@ GCRenderContext::GCRenderContext()
 	m_pCbLightPropertiesInstance(nullptr),
 	m_pPostProcessingShader(nullptr),
 	m_pPixelIdMappingShader(nullptr),
+	m_pPixelIdMappingBufferRtv(nullptr),
 	m_isPixelIDMappingActivated(false),
-	m_isDeferredLightPassActivated(false)
+	m_isDeferredLightPassActivated(false),
+	m_pThreadPool(nullptr),
+	m_isDrawSortingActivated(false),
+	m_isCullingActivated(false),
+	m_frameCamera(),
+	m_isStaticLayerActivated(false),
+	m_isStaticLayerValid(false),
+	m_staticLayerMode(GC_STATIC_LAYER_BYPASS),
+	m_pStaticLayerRtv(nullptr),
+	m_staticLayerState(D3D12_RESOURCE_STATE_COMMON),
+	m_pCbStaticLayerViewProj(nullptr),
+	m_staticLayerCamera(),
+	m_staticLayerOffsetX(0),
+	m_staticLayerOffsetY(0),
+	m_pPixelIdReadback(nullptr),
+	m_pGpuTimer(nullptr),
+	m_gpuFrameZone(GCGpuTimestampRing::m_invalidZone),
+	m_gpuDrawsZone(GCGpuTimestampRing::m_invalidZone),
+	m_pStagingRing(nullptr),
+	m_frameIndex(0),
+	m_materialDslCapacity(0),
+	m_hasWarnedMaterialDslLimit(false),
+	m_frameDsv(),
+	m_hasFrameDsv(false)
 {
 }
 
 GCRenderContext::~GCRenderContext() {
+	GC_DELETE(m_pThreadPool);
+	GC_DELETE(m_pPixelIdReadback);
+	GC_DELETE(m_pGpuTimer);
+	GC_DELETE(m_pStagingRing);
+	// Sub-allocated from the render resources allocator
+	GC_DELETE(m_pCbStaticLayerViewProj);
 	GC_DELETE(m_pGCRenderResources);
 	GC_DELETE(m_pPostProcessingShader);
 	GC_DELETE(m_pPixelIdMappingShader);
@@ -19,6 +49,7 @@ GCRenderContext::~GCRenderContext() {
 	GC_DELETE(m_pPostProcessingRtv);
 	GC_DELETE(m_pPixelIdMappingBufferRtv);
 	GC_DELETE(m_pPixelIdMappingDepthStencilBuffer);
+	GC_DELETE(m_pStaticLayerRtv);
 }
 
 
@@ -33,6 +64,9 @@ bool GCRenderContext::Initialize(Window* pWindow, int renderWidth, int renderHei
 	m_pGCRenderResources->m_renderHeight = renderHeight;
 	m_pGCRenderResources->m_pWindow = pWindow;
 
+	m_pThreadPool = new GCThreadPool();
+	m_pThreadPool->Initialize();
+
 	InitDX12RenderPipeline();
 
 
@@ -89,6 +123,9 @@ bool GCRenderContext::InitDX12RenderPipeline()
 
 	m_pGCRenderResources->m_pDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_pGCRenderResources->m_pFence));
 
+	m_pGCRenderResources->m_pGpuAllocator = new GCGpuMemoryAllocator();
+	m_pGCRenderResources->m_pGpuAllocator->Initialize(m_pGCRenderResources->m_pDevice, &m_pGCRenderResources->m_memoryTracker);
+
 	m_pGCRenderResources->m_rtvDescriptorSize = m_pGCRenderResources->m_pDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 	m_pGCRenderResources->m_dsvDescriptorSize = m_pGCRenderResources->m_pDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
 	m_pGCRenderResources->m_cbvSrvUavDescriptorSize = m_pGCRenderResources->m_pDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -110,12 +147,17 @@ bool GCRenderContext::InitDX12RenderPipeline()
 
 	CreateCommandObjects();
 	CreateSwapChain();
+
+	// Static meshes are copied to the DEFAULT heap through it
+	m_pStagingRing = new GCStagingRing();
+	if (m_pStagingRing->Initialize(m_pGCRenderResources->m_pDevice, m_pGCRenderResources->m_pCommandQueue))
+		m_pGCRenderResources->m_memoryTracker.Add(GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, m_pStagingRing->GetCapacity());
 	
 	//Create RTV/DSV Descriptor Heaps
-	m_pGCRenderResources->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, m_pGCRenderResources->m_swapChainBufferCount + 6, false, &m_pGCRenderResources->m_pRtvHeap);
+	m_pGCRenderResources->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, m_pGCRenderResources->m_swapChainBufferCount + 8, false, &m_pGCRenderResources->m_pRtvHeap);
 	m_pGCRenderResources->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 2, false, &m_pGCRenderResources->m_pDsvHeap);
 	//Create CBV/SRV/UAV Descriptor Heaps
-	m_pGCRenderResources->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1000, true, &m_pGCRenderResources->m_pCbvSrvUavDescriptorHeap);
+	m_pGCRenderResources->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, GCRenderResources::m_cbvSrvUavDescriptorCount, true, &m_pGCRenderResources->m_pCbvSrvUavDescriptorHeap);
 
 	//*
 
@@ -125,9 +167,9 @@ bool GCRenderContext::InitDX12RenderPipeline()
 	OnResize();
 	CreateDeferredLightPassResources();
 	m_pCbLightPropertiesInstance = new GCUploadBuffer<GCLIGHT>(m_pGCRenderResources->m_pDevice, 100, true);
+	m_pGCRenderResources->m_memoryTracker.Add(GC_MEMORY_CATEGORY_CONSTANT_BUFFERS, m_pGCRenderResources->GetResourceSize(m_pCbLightPropertiesInstance->Resource()));
 
-	// Pixel Id Mapping Output Rtv
-	m_pPixelIdMappingBufferRtv = m_pGCRenderResources->CreateRTVTexture(m_pGCRenderResources->GetBackBufferFormat(), D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+	// Pixel Id Mapping Output Rtv is only created once the mapping is activated
 
 	return true;
 }
@@ -156,6 +198,24 @@ void GCRenderContext::CreateCommandObjects()
 	);
 
 	m_pGCRenderResources->m_pCommandList->Close();
+
+	// Command lists for parallel recording, one per thread at most
+	int recordingListCount = std::min(m_pThreadPool->GetThreadCount(), m_maxRecordingCommandLists);
+	if (recordingListCount < 2)
+		return;
+
+	for (int i = 0; i < recordingListCount; i++)
+	{
+		ID3D12CommandAllocator* pAllocator = nullptr;
+		ID3D12GraphicsCommandList* pCommandList = nullptr;
+
+		m_pGCRenderResources->m_pDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&pAllocator));
+		m_pGCRenderResources->m_pDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, pAllocator, nullptr, IID_PPV_ARGS(&pCommandList));
+		pCommandList->Close();
+
+		m_pGCRenderResources->m_vRecordingCmdListAllocs.push_back(pAllocator);
+		m_pGCRenderResources->m_vRecordingCommandLists.push_back(pCommandList);
+	}
 }
 
 void GCRenderContext::CreateSwapChain()
@@ -237,7 +297,7 @@ void GCRenderContext::CreateDeferredLightPassResources() {
 		int rootParametersFlag = 0;
 		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_CB0);
 		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_CB1);
-		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_CB2);
+		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_SRV_SLOT5);
 		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT1);
 		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT2);
 		GC_SET_FLAG(rootParametersFlag, GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT3);
@@ -249,7 +309,10 @@ void GCRenderContext::CreateDeferredLightPassResources() {
 	}
 
 
-	m_pCbMaterialDsl = new GCUploadBuffer<GC_MATERIAL_DSL>(m_pGCRenderResources->m_pDevice, 100, true);
+	// Structured buffer indexed by material id, grown by UploadDirtyMaterials when the materials outgrow it
+	m_materialDslCapacity = m_initialMaterialDslCapacity;
+	m_pCbMaterialDsl = new GCUploadBuffer<GC_MATERIAL_DSL>(m_pGCRenderResources->m_pDevice, m_materialDslCapacity, false);
+	m_pGCRenderResources->m_memoryTracker.Add(GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, m_pGCRenderResources->GetResourceSize(m_pCbMaterialDsl->Resource()));
 }
 
 void GCRenderContext::OnResize() 
@@ -278,6 +341,9 @@ void GCRenderContext::OnResize()
 	FlushCommandQueue();
 
 	UpdateViewport();
+
+	// Sized for the previous render
+	m_isStaticLayerValid = false;
 }
 
 void GCRenderContext::ReleasePreviousResources() 
@@ -291,6 +357,7 @@ void GCRenderContext::ReleasePreviousResources()
 	}
 	if (m_pGCRenderResources->m_pDepthStencilBuffer != nullptr)
 	{
+		m_pGCRenderResources->m_memoryTracker.Remove(GC_MEMORY_CATEGORY_RENDER_TARGETS, m_pGCRenderResources->GetResourceSize(m_pGCRenderResources->m_pDepthStencilBuffer));
 		m_pGCRenderResources->m_pDepthStencilBuffer->Release();
 	}
 }
@@ -387,6 +454,7 @@ bool GCRenderContext::FlushCommandQueue()
 
 bool GCRenderContext::PrepareDraw()
 {
+	GC_PROFILE_FUNCTION();
 	//Always needs to be called right before drawing!!!
 
 	HRESULT hr = m_pGCRenderResources->m_pDirectCmdListAlloc->Reset();
@@ -400,13 +468,16 @@ bool GCRenderContext::PrepareDraw()
 		return false;
 	};
 
+	if (m_pGpuTimer)
+	{
+		m_pGpuTimer->BeginFrame(m_frameIndex);
+		m_gpuFrameZone = m_pGpuTimer->BeginZone(m_pGCRenderResources->m_pCommandList, "Frame");
+	}
+
 	// Swap
 	CD3DX12_RESOURCE_BARRIER ResBar(CD3DX12_RESOURCE_BARRIER::Transition(m_pGCRenderResources->CurrentBackBuffer(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET));
 	m_pGCRenderResources->m_pCommandList->ResourceBarrier(1, &ResBar);
 
-	m_pGCRenderResources->m_pCommandList->RSSetViewports(1, &m_pGCRenderResources->m_ScreenViewport);
-	m_pGCRenderResources->m_pCommandList->RSSetScissorRects(1, &m_pGCRenderResources->m_ScissorRect);
-
 	m_pGCRenderResources->m_pCommandList->ClearRenderTargetView(m_pGCRenderResources->CurrentBackBufferViewAddress(), DirectX::Colors::LightBlue, 1, &m_pGCRenderResources->m_ScissorRect);
 	m_pGCRenderResources->m_pCommandList->ClearDepthStencilView(m_pGCRenderResources->GetDepthStencilViewAddress(), D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
 
@@ -418,137 +489,412 @@ bool GCRenderContext::PrepareDraw()
 	}
 	
 
-	std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> rtvs;
-	std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> dsvs;
+	m_vFrameRtvs.clear();
+	m_hasFrameDsv = false;
 
 	{
 		// Basic draw
 		D3D12_CPU_DESCRIPTOR_HANDLE basicRtv = m_pGCRenderResources->CurrentBackBufferViewAddress();
-		rtvs.push_back(basicRtv);
+		m_vFrameRtvs.push_back(basicRtv);
 
 		if (m_renderMode == GC_RENDER_MODE_3D)
 		{
-			D3D12_CPU_DESCRIPTOR_HANDLE basicDsv = m_pGCRenderResources->GetDepthStencilViewAddress();
-			dsvs.push_back(basicDsv);
+			m_frameDsv = m_pGCRenderResources->GetDepthStencilViewAddress();
+			m_hasFrameDsv = true;
 		}
 	}
 
 	{
 		// Pixel Id Mapping
 		if (m_isPixelIDMappingActivated) {
-			rtvs.push_back(m_pPixelIdMappingBufferRtv->cpuHandle);
+			m_vFrameRtvs.push_back(m_pPixelIdMappingBufferRtv->cpuHandle);
 		}
 	}
 	
 	{
 		// Deferred Light Pass
 		if (m_isDeferredLightPassActivated) {
-			rtvs.push_back(m_pAlbedoGBuffer->cpuHandle);
-			rtvs.push_back(m_pWorldPosGBuffer->cpuHandle);
-			rtvs.push_back(m_pNormalGBuffer->cpuHandle);
+			m_vFrameRtvs.push_back(m_pAlbedoGBuffer->cpuHandle);
+			m_vFrameRtvs.push_back(m_pWorldPosGBuffer->cpuHandle);
+			m_vFrameRtvs.push_back(m_pNormalGBuffer->cpuHandle);
 		}
 	}
 
-	UINT rtvCount = static_cast<UINT>(rtvs.size());
+	BindFrameState(m_pGCRenderResources->m_pCommandList);
 
-	D3D12_CPU_DESCRIPTOR_HANDLE basicDsv = m_pGCRenderResources->GetDepthStencilViewAddress();
-	m_pGCRenderResources->m_pCommandList->OMSetRenderTargets(rtvCount, rtvs.data(), FALSE, dsvs.data());
+	m_vDrawCommands.clear();
+	m_vStaticDrawCommands.clear();
+	m_renderQueue.Clear();
+	m_culler.Clear();
 
-	
-	ID3D12DescriptorHeap* descriptorHeaps[] = { m_pGCRenderResources->m_pCbvSrvUavDescriptorHeap };
-	m_pGCRenderResources->m_pCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+	// Before any draw : tells whether static draws of this frame are needed
+	UpdateStaticLayerMode();
 
 	return true;
 }
 
-bool GCRenderContext::DrawObject(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha)
+void GCRenderContext::BindFrameState(ID3D12GraphicsCommandList* pCommandList)
+{
+	pCommandList->RSSetViewports(1, &m_pGCRenderResources->m_ScreenViewport);
+	pCommandList->RSSetScissorRects(1, &m_pGCRenderResources->m_ScissorRect);
+
+	UINT rtvCount = static_cast<UINT>(m_vFrameRtvs.size());
+	pCommandList->OMSetRenderTargets(rtvCount, m_vFrameRtvs.data(), FALSE, m_hasFrameDsv ? &m_frameDsv : nullptr);
+
+	ID3D12DescriptorHeap* descriptorHeaps[] = { m_pGCRenderResources->m_pCbvSrvUavDescriptorHeap };
+	pCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+}
+
+bool GCRenderContext::BuildDrawCommand(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha, GC_DRAW_COMMAND& outCommand)
 {
+	if (pMaterial == nullptr || pMesh == nullptr)
+		return false;
 	GCShader* pShader = pMaterial->GetShader();
-	if (pMaterial == nullptr || pShader == nullptr || pMesh == nullptr)
+	if (pShader == nullptr)
 		return false;
 	if (!GC_COMPARE_SHADER_MESH_FLAGS(pMaterial, pMesh))
 		return false;
 
-	//Basic Draw
-	{
-		m_pGCRenderResources->m_pCommandList->SetPipelineState(pMaterial->GetShader()->GetPso(alpha));
-		m_pGCRenderResources->m_pCommandList->SetGraphicsRootSignature(pMaterial->GetShader()->GetRootSign());
+	int rootParameterFlag = pShader->GetFlagRootParameters();
+
+	// The draw is only recorded at CompleteDraw, keep the object cb written for it now
+	outCommand.pMesh = pMesh;
+	outCommand.pMaterial = pMaterial;
+	outCommand.alpha = alpha;
+	outCommand.objectCbAddress = 0;
+	outCommand.cullIndex = -1;
+	outCommand.instanceCount = 1;
+	outCommand.instanceSrv.ptr = 0;
+
+	if (GC_HAS_FLAG(rootParameterFlag, GC_ROOT_PARAMETER_CB0)) {
+		outCommand.objectCbAddress = pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]->GetGPUVirtualAddress();
+	}
 
-		m_pGCRenderResources->m_pCommandList->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-		D3D12_VERTEX_BUFFER_VIEW vertexBufferView = pMesh->GetBufferGeometryData()->VertexBufferView();
-		m_pGCRenderResources->m_pCommandList->IASetVertexBuffers(0, 1, &vertexBufferView);
-		D3D12_INDEX_BUFFER_VIEW indexBufferView = pMesh->GetBufferGeometryData()->IndexBufferView();
-		m_pGCRenderResources->m_pCommandList->IASetIndexBuffer(&indexBufferView);
+	// Set cb object buffer on used
+	pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]->m_isUsed = true;
+	pMaterial->IncrementCBCount();
 
-		// Update texture if material has texture
-		pMaterial->UpdateTexture();
+	return true;
+}
 
-		int rootParameterFlag = pMaterial->GetShader()->GetFlagRootParameters();
+bool GCRenderContext::DrawObject(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha, float depth, const DirectX::XMFLOAT4X4* pWorldMatrix)
+{
+	GC_PROFILE_FUNCTION();
+	GC_DRAW_COMMAND command;
+	if (BuildDrawCommand(pMesh, pMaterial, alpha, command) == false)
+		return false;
 
-		// Update cb0, cb of object
-		if (GC_HAS_FLAG(rootParameterFlag, GC_ROOT_PARAMETER_CB0)) {
-			m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(pShader->m_rootParameter_ConstantBuffer_0, pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]->Resource()->GetGPUVirtualAddress());
+	if (m_isCullingActivated && pWorldMatrix)
+		command.cullIndex = m_culler.Push(pMesh->GetBoundingBox(), *pWorldMatrix);
+
+	if (m_isDrawSortingActivated)
+	{
+		uint64_t key;
+		if (alpha)
+			key = GCRenderQueue::MakeAlphaKey(depth, static_cast<uint32_t>(m_vDrawCommands.size()));
+		else
+		{
+			int textureId = pMaterial->GetTexture() ? pMaterial->GetTexture()->GetTextureId() : 0;
+			key = GCRenderQueue::MakeOpaqueKey(pMaterial->GetShader()->GetShaderId(), static_cast<int>(pMaterial->m_materialId), textureId, depth);
 		}
+		m_renderQueue.Push(key);
+	}
+
+	m_vDrawCommands.push_back(command);
+
+	return true;
+}
+
+bool GCRenderContext::DrawObjectInstanced(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha, UINT instanceCount, D3D12_GPU_DESCRIPTOR_HANDLE instanceSrv, float depth)
+{
+	GC_PROFILE_FUNCTION();
+	if (instanceCount == 0)
+		return false;
+
+	// Same path as DrawObject for the sort key, no world matrix : the draw is never culled
+	if (DrawObject(pMesh, pMaterial, alpha, depth) == false)
+		return false;
+
+	GC_DRAW_COMMAND& command = m_vDrawCommands.back();
+	command.instanceCount = instanceCount;
+	command.instanceSrv = instanceSrv;
+
+	return true;
+}
+
+bool GCRenderContext::DrawStaticObject(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha)
+{
+	if (m_staticLayerMode == GC_STATIC_LAYER_BYPASS)
+		return DrawObject(pMesh, pMaterial, alpha);
+
+	// Already in the layer
+	if (m_staticLayerMode == GC_STATIC_LAYER_CACHED)
+		return true;
+
+	// Rendered in the layer, in submission order : never sorted nor culled (the layer is larger than the view)
+	GC_DRAW_COMMAND command;
+	if (BuildDrawCommand(pMesh, pMaterial, alpha, command) == false)
+		return false;
+
+	m_vStaticDrawCommands.push_back(command);
+
+	return true;
+}
+
+void GCRenderContext::ResolveDrawBindings(const GC_DRAW_COMMAND& command, D3D12_GPU_VIRTUAL_ADDRESS cameraCbAddress, GC_DRAW_BINDINGS& outDraw) const
+{
+	GCMaterial* pMaterial = command.pMaterial;
+	GCShader* pShader = pMaterial->GetShader();
+	GC_MESH_BUFFER_DATA* pBufferData = command.pMesh->GetBufferGeometryData();
+
+	outDraw.pPso = pShader->GetPso(command.alpha);
+	outDraw.pRootSignature = pShader->GetRootSign();
+	outDraw.vertexBufferView = pBufferData->VertexBufferView();
+	outDraw.indexBufferView = pBufferData->IndexBufferView();
+
+	// Texture if material has texture
+	outDraw.textureRootIndex = -1;
+	if (GC_HAS_FLAG(pShader->GetFlagEnabledBits(), GC_VERTEX_UV) && pMaterial->GetTexture()) {
+		outDraw.textureRootIndex = pShader->m_rootParameter_DescriptorTable_1;
+		outDraw.texture = pMaterial->GetTexture()->GetTextureAddress();
+	}
+
+	outDraw.instanceRootIndex = -1;
+	if (command.instanceSrv.ptr != 0 && pShader->m_rootParameter_DescriptorTable_2 >= 0) {
+		outDraw.instanceRootIndex = pShader->m_rootParameter_DescriptorTable_2;
+		outDraw.instances = command.instanceSrv;
+	}
+
+	int rootParameterFlag = pShader->GetFlagRootParameters();
+
+	// cb0 object, cb1 camera, cb2 material properties, cb3 lights
+	const int cbFlags[4] = { GC_ROOT_PARAMETER_CB0, GC_ROOT_PARAMETER_CB1, GC_ROOT_PARAMETER_CB2, GC_ROOT_PARAMETER_CB3 };
+	const int cbRootIndices[4] = { pShader->m_rootParameter_ConstantBuffer_0, pShader->m_rootParameter_ConstantBuffer_1, pShader->m_rootParameter_ConstantBuffer_2, pShader->m_rootParameter_ConstantBuffer_3 };
+	const D3D12_GPU_VIRTUAL_ADDRESS cbAddresses[4] = {
+		command.objectCbAddress,
+		cameraCbAddress,
+		pMaterial->GetCbMaterialPropertiesInstance()->GetGPUVirtualAddress(),
+		m_pCbLightPropertiesInstance->GetGPUVirtualAddress()
+	};
+
+	for (int cb = 0; cb < 4; cb++)
+	{
+		outDraw.constantBufferRootIndices[cb] = GC_HAS_FLAG(rootParameterFlag, cbFlags[cb]) ? cbRootIndices[cb] : -1;
+		outDraw.constantBuffers[cb] = cbAddresses[cb];
+	}
+
+	outDraw.indexCount = pBufferData->IndexCount;
+	outDraw.instanceCount = command.instanceCount;
+}
+
+void GCRenderContext::RecordDraws(GCDrawRecorder& recorder, const std::vector<GC_DRAW_COMMAND>& commands, int begin, int end, D3D12_GPU_VIRTUAL_ADDRESS cameraCbAddress, GC_STATE_CHANGE_STATS& stats)
+{
+	// Every recording starts on a freshly bound list, nothing is known about its state
+	recorder.ResetState();
+
+	GC_DRAW_BINDINGS draw;
+	for (int i = begin; i < end; i++)
+	{
+		ResolveDrawBindings(commands[i], cameraCbAddress, draw);
+		recorder.RecordDraw(draw, stats);
+	}
+}
+
+bool GCRenderContext::SubmitDraws()
+{
+	GC_PROFILE_FUNCTION();
+	// Meshes staged since the last frame, the direct queue waits for their copy before the draws
+	if (m_pStagingRing->Flush() == false) return false;
 
-		// Set cb object buffer on used
-		pMaterial->GetCbObjectInstance()[pMaterial->GetCount()]->m_isUsed = true;
-		pMaterial->IncrementCBCount();
+	int drawCount = static_cast<int>(m_vDrawCommands.size());
 
-		// cb1, Camera
-		if (GC_HAS_FLAG(rootParameterFlag, GC_ROOT_PARAMETER_CB1)) {
-			m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(pShader->m_rootParameter_ConstantBuffer_1, m_pCbCurrentViewProjInstance->Resource()->GetGPUVirtualAddress());
+	// Culling results are read while gathering the draws, the keys index the unculled list
+	bool isCulled = m_isCullingActivated && m_culler.GetCount() > 0;
+	if (isCulled)
+	{
+		GC_PROFILE_SCOPE("Cull");
+		m_culler.Cull(m_pThreadPool);
+	}
+
+	// Reorder the draws by key : opaque before alpha, then grouped by shader / material / texture
+	if (m_isDrawSortingActivated && m_renderQueue.GetCount() == m_vDrawCommands.size() && drawCount > 1)
+	{
+		GC_PROFILE_SCOPE("Sort draws");
+		m_renderQueue.Sort();
+
+		m_vSortedDrawCommands.clear();
+		for (int i = 0; i < drawCount; i++)
+		{
+			const GC_DRAW_COMMAND& command = m_vDrawCommands[m_renderQueue.GetSortedIndex(i)];
+			if (isCulled && command.cullIndex >= 0 && m_culler.IsVisible(command.cullIndex) == false)
+				continue;
+			m_vSortedDrawCommands.push_back(command);
 		}
-		// cb2, Material Properties
-		if (GC_HAS_FLAG(rootParameterFlag, GC_ROOT_PARAMETER_CB2))
-			m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(pShader->m_rootParameter_ConstantBuffer_2, pMaterial->GetCbMaterialPropertiesInstance()->Resource()->GetGPUVirtualAddress());
-		// cb3, Light Properties
-		if (GC_HAS_FLAG(rootParameterFlag, GC_ROOT_PARAMETER_CB3))
-			m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(pShader->m_rootParameter_ConstantBuffer_3, m_pCbLightPropertiesInstance->Resource()->GetGPUVirtualAddress());
-
-		// Draw
-		m_pGCRenderResources->m_pCommandList->DrawIndexedInstanced(pMesh->GetBufferGeometryData()->IndexCount, 1, 0, 0, 0);
-	}
-
-	// Structured Buffer Send to Deferred Shader
-	GC_MATERIAL_DSL newMaterial;
-	newMaterial.ambientLightColor = pMaterial->ambientLightColor;
-	newMaterial.ambient = pMaterial->ambient;
-	newMaterial.diffuse = pMaterial->diffuse;
-	newMaterial.specular = pMaterial->specular;
-	newMaterial.shininess = pMaterial->shininess;
-	newMaterial.materialId = pMaterial->m_materialId;
-
-	//Material already in array?
-	for (const auto& material : m_materialsUsedInFrame)
-	{
-		if (material.materialId == newMaterial.materialId)
+
+		m_vDrawCommands.swap(m_vSortedDrawCommands);
+	}
+	else if (isCulled)
+	{
+		int keptCount = 0;
+		for (int i = 0; i < drawCount; i++)
 		{
-			
-			return true;
+			const GC_DRAW_COMMAND& command = m_vDrawCommands[i];
+			if (command.cullIndex >= 0 && m_culler.IsVisible(command.cullIndex) == false)
+				continue;
+			m_vDrawCommands[keptCount++] = command;
 		}
+		m_vDrawCommands.resize(keptCount);
 	}
-	m_materialsUsedInFrame.push_back(newMaterial);
+
+	m_frameStats.culledDraws = drawCount - static_cast<int>(m_vDrawCommands.size());
+	drawCount = static_cast<int>(m_vDrawCommands.size());
+
+	int listCount = GCParallelDrawRecording::GetListCount(drawCount, m_pGCRenderResources->GetRecordingCommandListCount(), m_minDrawsPerRecordingList);
+
+	m_stateChangeStats = GC_STATE_CHANGE_STATS();
+
+	// Static layer below every other draw, recorded on the main list : it is executed before the recording lists
+	// Camera changed after PrepareDraw : the previous offset is kept one frame, the layer is rendered again next frame
+	if (m_staticLayerMode == GC_STATIC_LAYER_CACHED && ComputeStaticLayerOffset(m_staticLayerOffsetX, m_staticLayerOffsetY) == false)
+		m_isStaticLayerValid = false;
+
+	if (m_staticLayerMode == GC_STATIC_LAYER_REBUILD)
+		RenderStaticLayer();
+	if (m_staticLayerMode != GC_STATIC_LAYER_BYPASS)
+		CopyStaticLayer();
+
+	D3D12_GPU_VIRTUAL_ADDRESS cameraCbAddress = m_pCbCurrentViewProjInstance->GetGPUVirtualAddress();
+
+	if (listCount < 2)
+	{
+		GC_PROFILE_SCOPE("Record draws");
+		GCD3D12DrawRecorder recorder(m_pGCRenderResources->m_pCommandList);
+		RecordDraws(recorder, m_vDrawCommands, 0, drawCount, cameraCbAddress, m_stateChangeStats);
+		m_vDrawCommands.clear();
+		return true;
+	}
+
+	// Main list is submitted first with the frame setup (barrier, clears), then every chunk in draw order
+	HRESULT hr = m_pGCRenderResources->m_pCommandList->Close();
+	if (GC_CHECK_HRESULT(hr, "Failed to close command list") == false) return false;
+
+	bool isRecorded = m_parallelRecording.Record(m_pThreadPool, drawCount, listCount, [&](int listIndex, int begin, int end, GC_STATE_CHANGE_STATS& stats)
+	{
+		GC_PROFILE_SCOPE("Record draws");
+		ID3D12CommandAllocator* pAllocator = m_pGCRenderResources->m_vRecordingCmdListAllocs[listIndex];
+		ID3D12GraphicsCommandList* pCommandList = m_pGCRenderResources->m_vRecordingCommandLists[listIndex];
+
+		// Previous frame is flushed at the end of CompleteDraw, the allocator is free
+		if (FAILED(pAllocator->Reset()) || FAILED(pCommandList->Reset(pAllocator, nullptr)))
+			return false;
+
+		BindFrameState(pCommandList);
+		GCD3D12DrawRecorder recorder(pCommandList);
+		RecordDraws(recorder, m_vDrawCommands, begin, end, cameraCbAddress, stats);
+
+		return SUCCEEDED(pCommandList->Close());
+	}, m_stateChangeStats);
+
+	if (isRecorded == false)
+	{
+		GCGraphicsLogger::GetInstance().LogWarning("Failed to record draw command lists");
+		return false;
+	}
+
+	ID3D12CommandList* cmdsLists[1 + m_maxRecordingCommandLists];
+	cmdsLists[0] = m_pGCRenderResources->m_pCommandList;
+	for (int i = 0; i < listCount; i++)
+		cmdsLists[i + 1] = m_pGCRenderResources->m_vRecordingCommandLists[i];
+
+	m_pGCRenderResources->m_pCommandQueue->ExecuteCommandLists(listCount + 1, cmdsLists);
+
+	// Reopen the main list for the end of frame passes, its allocator keeps growing until the next PrepareDraw
+	hr = m_pGCRenderResources->m_pCommandList->Reset(m_pGCRenderResources->m_pDirectCmdListAlloc, nullptr);
+	if (GC_CHECK_HRESULT(hr, "m_CommandList->Reset()") == false) return false;
+
+	BindFrameState(m_pGCRenderResources->m_pCommandList);
+
+	m_vDrawCommands.clear();
 
 	return true;
 }
 
 bool GCRenderContext::CompleteDraw()
 {
-	if (m_isDeferredLightPassActivated) PerformDeferredLightPass();
-	if (m_isCSPostProcessingActivated) PerformPostProcessingCS();
+	GC_PROFILE_FUNCTION();
+	ID3D12GraphicsCommandList* pCommandList = m_pGCRenderResources->m_pCommandList;
+
+	// Parallel recording lists run between the begin and the end, both on the direct queue
+	if (m_pGpuTimer) m_gpuDrawsZone = m_pGpuTimer->BeginZone(pCommandList, "Draws");
+	if (SubmitDraws() == false) return false;
+	if (m_pGpuTimer) m_pGpuTimer->EndZone(pCommandList, m_gpuDrawsZone);
+
+	// Pixel id copy, read back frames later by GetPixelIdAt
+	bool isPixelIdCopied = false;
+	if (m_pPixelIdReadback && m_isPixelIDMappingActivated)
+	{
+		UINT32 zone = m_pGpuTimer ? m_pGpuTimer->BeginZone(pCommandList, "Pixel id copy") : GCGpuTimestampRing::m_invalidZone;
+		isPixelIdCopied = m_pPixelIdReadback->RecordCopy(pCommandList, D3D12_RESOURCE_STATE_RENDER_TARGET, m_frameIndex);
+		if (m_pGpuTimer) m_pGpuTimer->EndZone(pCommandList, zone);
+	}
+
+	if (m_isDeferredLightPassActivated)
+	{
+		UINT32 zone = m_pGpuTimer ? m_pGpuTimer->BeginZone(pCommandList, "Deferred light pass") : GCGpuTimestampRing::m_invalidZone;
+		PerformDeferredLightPass();
+		if (m_pGpuTimer) m_pGpuTimer->EndZone(pCommandList, zone);
+	}
+	if (m_isCSPostProcessingActivated)
+	{
+		UINT32 zone = m_pGpuTimer ? m_pGpuTimer->BeginZone(pCommandList, "Post processing CS") : GCGpuTimestampRing::m_invalidZone;
+		PerformPostProcessingCS();
+		if (m_pGpuTimer) m_pGpuTimer->EndZone(pCommandList, zone);
+	}
 	
 	if (m_isCSPostProcessingActivated == false) {
 		CD3DX12_RESOURCE_BARRIER RtToPresent = CD3DX12_RESOURCE_BARRIER::Transition(m_pGCRenderResources->CurrentBackBuffer(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
 		m_pGCRenderResources->m_pCommandList->ResourceBarrier(1, &RtToPresent);
 	}
 
+	// Resolve of the frame timestamps, after the last pass
+	bool isGpuFrameTimed = m_pGpuTimer && m_pGpuTimer->HasPendingFrame();
+	if (m_pGpuTimer)
+	{
+		m_pGpuTimer->EndZone(pCommandList, m_gpuFrameZone);
+		m_pGpuTimer->EndFrame(pCommandList);
+	}
+
 	HRESULT hr = m_pGCRenderResources->m_pCommandList->Close();
 	if (GC_CHECK_HRESULT(hr, "Failed to close command list") == false) return false;
 	ID3D12CommandList* cmdsLists[] = { m_pGCRenderResources->m_pCommandList };
 	m_pGCRenderResources->m_pCommandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
 
+	if (isPixelIdCopied)
+	{
+		m_pGCRenderResources->m_CurrentFence++;
+		m_pGCRenderResources->m_pCommandQueue->Signal(m_pGCRenderResources->m_pFence, m_pGCRenderResources->m_CurrentFence);
+		m_pPixelIdReadback->OnSubmitted(m_pGCRenderResources->m_CurrentFence);
+	}
+	if (isGpuFrameTimed)
+	{
+		m_pGCRenderResources->m_CurrentFence++;
+		m_pGCRenderResources->m_pCommandQueue->Signal(m_pGCRenderResources->m_pFence, m_pGCRenderResources->m_CurrentFence);
+		m_pGpuTimer->OnSubmitted(m_pGCRenderResources->m_CurrentFence);
+	}
+
+	m_frameStats.frameIndex = m_frameIndex;
+	m_frameStats.drawCalls = m_stateChangeStats.drawCalls;
+	m_frameStats.triangles = m_stateChangeStats.triangles;
+	m_frameStats.psoChanges = m_stateChangeStats.psoChanges;
+	m_frameStats.rootSignatureChanges = m_stateChangeStats.rootSignatureChanges;
+	m_frameStats.stateChangesSkipped = m_stateChangeStats.skipped;
+	m_frameStats.descriptorsAllocated = m_pGCRenderResources->GetViewDescriptorCount();
+	m_frameIndex++;
 
-	hr = m_pGCRenderResources->m_pSwapChain->Present(0, 0);
+	{
+		GC_PROFILE_SCOPE("Present");
+		hr = m_pGCRenderResources->m_pSwapChain->Present(0, 0);
+	}
 	if (GC_CHECK_HRESULT(hr, "Failed to present swap chain") == false) return false;
 	// Swap front - back buffer index
 	m_pGCRenderResources->m_currBackBuffer = (m_pGCRenderResources->m_currBackBuffer + 1) % m_pGCRenderResources->m_swapChainBufferCount;
@@ -556,12 +902,26 @@ bool GCRenderContext::CompleteDraw()
 
 	//Clear frame counter for resource using - Release short time resource
 	// #WARNING It will replace resource on these offset already allocated
-	m_pGCRenderResources->m_srvStaticOffsetCount = 300;
-	m_pGCRenderResources->m_srvDynamicOffsetCount = 320;
+	m_pGCRenderResources->m_srvStaticOffsetCount = GCRenderResources::m_srvStaticOffsetStart;
+	m_pGCRenderResources->m_srvDynamicOffsetCount = GCRenderResources::m_srvDynamicOffsetStart;
 
 
 	// Flush the command queue
-	if (FlushCommandQueue() == false) return false;
+	{
+		GC_PROFILE_SCOPE("Wait for GPU");
+		if (FlushCommandQueue() == false) return false;
+	}
+
+	if (m_pGpuTimer)
+	{
+		m_pGpuTimer->Update(m_pGCRenderResources->m_pFence);
+		m_frameStats.hasGpuTiming = m_pGpuTimer->HasResult();
+		m_frameStats.gpuFrameIndex = m_pGpuTimer->GetResultFrame();
+		m_frameStats.gpuFrameMs = m_pGpuTimer->GetResultFrameMs();
+	}
+
+	m_lastFrameStats = m_frameStats;
+	m_frameStats = GC_FRAME_STATS();
 
 	return true;
 }
@@ -598,14 +958,13 @@ void GCRenderContext::PerformDeferredLightPass() {
 	m_pGCRenderResources->m_pCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// Set camera & lights entry
-	m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(m_pDeferredLightPassShader->m_rootParameter_ConstantBuffer_0, m_pCbCurrentViewProjInstance->Resource()->GetGPUVirtualAddress());
-	m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(m_pDeferredLightPassShader->m_rootParameter_ConstantBuffer_1, m_pCbLightPropertiesInstance->Resource()->GetGPUVirtualAddress());
+	m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(m_pDeferredLightPassShader->m_rootParameter_ConstantBuffer_0, m_pCbCurrentViewProjInstance->GetGPUVirtualAddress());
+	m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(m_pDeferredLightPassShader->m_rootParameter_ConstantBuffer_1, m_pCbLightPropertiesInstance->GetGPUVirtualAddress());
 
-	//Update Materials
-	size_t count = m_materialsUsedInFrame.size();
-	m_pCbMaterialDsl->CopyData(0, m_materialsUsedInFrame.data(), sizeof(GC_MATERIAL_DSL) * count);
+	//Update Materials, only the entries changed since the last pass
+	UploadDirtyMaterials();
 
-	m_pGCRenderResources->m_pCommandList->SetGraphicsRootConstantBufferView(m_pDeferredLightPassShader->m_rootParameter_ConstantBuffer_2, m_pCbMaterialDsl->Resource()->GetGPUVirtualAddress());
+	m_pGCRenderResources->m_pCommandList->SetGraphicsRootShaderResourceView(m_pDeferredLightPassShader->m_rootParameter_ShaderResourceView_5, m_pCbMaterialDsl->GetGPUVirtualAddress());
 
 	m_pGCRenderResources->m_pCommandList->DrawIndexedInstanced(theMesh->GetBufferGeometryData()->IndexCount, 1, 0, 0, 0);
 
@@ -803,7 +1162,16 @@ void GCRenderContext::DesactiveCSPostProcessing() {
 	m_isCSPostProcessingActivated = false;
 }
 
+void GCRenderContext::CreatePixelIdMappingResources()
+{
+	if (m_pPixelIdMappingBufferRtv)
+		return;
+
+	m_pPixelIdMappingBufferRtv = m_pGCRenderResources->CreateRTVTexture(m_pGCRenderResources->GetBackBufferFormat(), D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+}
+
 void GCRenderContext::ActivePixelIDMapping() {
+	CreatePixelIdMappingResources();
 	m_isPixelIDMappingActivated = true;
 }
 
@@ -812,10 +1180,375 @@ void GCRenderContext::DesactivePixelIDMapping() {
 }
 
 void GCRenderContext::ActiveDeferredLightPass() {
+	CreatePixelIdMappingResources();
 	m_isDeferredLightPassActivated = true;
 	m_isPixelIDMappingActivated = true;
 }
 
+void GCRenderContext::UpdateMaterialDsl(GCMaterial* pMaterial)
+{
+	// Already queued : its properties are read at the upload
+	if (pMaterial->IsPropertiesDirty())
+		return;
+
+	pMaterial->SetPropertiesDirty(true);
+	m_vDirtyMaterials.push_back(pMaterial);
+}
+
+void GCRenderContext::OnMaterialRemoved(GCMaterial* pMaterial)
+{
+	if (pMaterial->IsPropertiesDirty())
+		m_vDirtyMaterials.erase(std::find(m_vDirtyMaterials.begin(), m_vDirtyMaterials.end(), pMaterial));
+}
+
+void GCRenderContext::UploadDirtyMaterials()
+{
+	if (m_vDirtyMaterials.empty())
+		return;
+
+	// Properties copied in the table now, several updates of a material in a frame cost one upload
+	m_vDirtyMaterialIds.clear();
+	for (GCMaterial* pMaterial : m_vDirtyMaterials)
+	{
+		pMaterial->SetPropertiesDirty(false);
+
+		int materialId = static_cast<int>(pMaterial->m_materialId);
+		if (materialId < 0 || materialId >= m_maxMaterialsDsl)
+		{
+			if (m_hasWarnedMaterialDslLimit == false)
+			{
+				GCGraphicsLogger::GetInstance().LogWarning("Material id " + std::to_string(materialId) + " doesn't fit in the pixel id map (" + std::to_string(m_maxMaterialsDsl) + " materials), its properties are not sent to the light pass");
+				m_hasWarnedMaterialDslLimit = true;
+			}
+			continue;
+		}
+
+		if (materialId >= static_cast<int>(m_vMaterialDslTable.size()))
+			m_vMaterialDslTable.resize(materialId + 1);
+
+		GC_MATERIAL_DSL& material = m_vMaterialDslTable[materialId];
+		material.ambientLightColor = pMaterial->ambientLightColor;
+		material.ambient = pMaterial->ambient;
+		material.diffuse = pMaterial->diffuse;
+		material.specular = pMaterial->specular;
+		material.shininess = pMaterial->shininess;
+		material.materialId = pMaterial->m_materialId;
+
+		m_vDirtyMaterialIds.push_back(materialId);
+	}
+	m_vDirtyMaterials.clear();
+
+	if (static_cast<int>(m_vMaterialDslTable.size()) > m_materialDslCapacity)
+	{
+		GrowMaterialDslBuffer();
+		return;
+	}
+
+	// Neighbour ids are sent in the same copy. Ids of removed materials are given again, they may repeat
+	std::sort(m_vDirtyMaterialIds.begin(), m_vDirtyMaterialIds.end());
+	m_vDirtyMaterialIds.erase(std::unique(m_vDirtyMaterialIds.begin(), m_vDirtyMaterialIds.end()), m_vDirtyMaterialIds.end());
+
+	size_t i = 0;
+	while (i < m_vDirtyMaterialIds.size())
+	{
+		int first = m_vDirtyMaterialIds[i];
+		int last = first;
+		while (i + 1 < m_vDirtyMaterialIds.size() && m_vDirtyMaterialIds[i + 1] == last + 1)
+			last = m_vDirtyMaterialIds[++i];
+		i++;
+
+		int count = last - first + 1;
+		m_pCbMaterialDsl->CopyData(first, &m_vMaterialDslTable[first], sizeof(GC_MATERIAL_DSL) * count);
+		AddConstantBufferBytes(sizeof(GC_MATERIAL_DSL) * count);
+	}
+}
+
+void GCRenderContext::GrowMaterialDslBuffer()
+{
+	int capacity = m_materialDslCapacity;
+	while (capacity < static_cast<int>(m_vMaterialDslTable.size()))
+		capacity *= 2;
+
+	// Frames in flight may still read the old buffer, this frame binds the new one after this
+	FlushCommandQueue();
+	m_pGCRenderResources->m_memoryTracker.Remove(GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, m_pGCRenderResources->GetResourceSize(m_pCbMaterialDsl->Resource()));
+	delete m_pCbMaterialDsl;
+
+	m_materialDslCapacity = capacity;
+	m_pCbMaterialDsl = new GCUploadBuffer<GC_MATERIAL_DSL>(m_pGCRenderResources->m_pDevice, m_materialDslCapacity, false);
+	m_pGCRenderResources->m_memoryTracker.Add(GC_MEMORY_CATEGORY_UPLOAD_BUFFERS, m_pGCRenderResources->GetResourceSize(m_pCbMaterialDsl->Resource()));
+
+	// The whole table in one contiguous write, every dirty entry is in it
+	m_pCbMaterialDsl->CopyData(0, m_vMaterialDslTable.data(), sizeof(GC_MATERIAL_DSL) * m_vMaterialDslTable.size());
+	AddConstantBufferBytes(sizeof(GC_MATERIAL_DSL) * m_vMaterialDslTable.size());
+}
+
+void GCRenderContext::SetFrameCamera(const GCVIEWPROJCB& camera)
+{
+	m_frameCamera = camera;
+	m_culler.SetCamera(camera);
+}
+
+void GCRenderContext::UpdateStaticLayerMode()
+{
+	m_staticLayerMode = GC_STATIC_LAYER_BYPASS;
+
+	// Layer holds colors only, passes writing other targets need every draw
+	if (m_isStaticLayerActivated == false || m_renderMode != GC_RENDER_MODE_2D)
+		return;
+	if (m_isPixelIDMappingActivated || m_isDeferredLightPassActivated)
+		return;
+
+	// Created for another render size
+	D3D12_RESOURCE_DESC layerDesc = m_pStaticLayerRtv->pResource->GetDesc();
+	UINT layerWidth = m_pGCRenderResources->GetRenderWidth() + 2 * m_staticLayerMargin;
+	UINT layerHeight = m_pGCRenderResources->GetRenderHeight() + 2 * m_staticLayerMargin;
+	if (layerDesc.Width != layerWidth || layerDesc.Height != layerHeight)
+		return;
+
+	if (m_isStaticLayerValid && ComputeStaticLayerOffset(m_staticLayerOffsetX, m_staticLayerOffsetY))
+	{
+		m_staticLayerMode = GC_STATIC_LAYER_CACHED;
+		return;
+	}
+
+	m_isStaticLayerValid = false;
+	m_staticLayerMode = GC_STATIC_LAYER_REBUILD;
+}
+
+bool GCRenderContext::ComputeStaticLayerOffset(int& outOffsetX, int& outOffsetY) const
+{
+	// Camera cb matrices are transposed : view translation is the last column, proj w row is the last row
+	const GCVIEWPROJCB& cached = m_staticLayerCamera;
+	const GCVIEWPROJCB& current = m_frameCamera;
+
+	// Zoom, projection or perspective : no pixel offset matches
+	if (memcmp(&cached.proj, &current.proj, sizeof(DirectX::XMFLOAT4X4)) != 0)
+		return false;
+	if (current.proj._41 != 0.0f || current.proj._42 != 0.0f || current.proj._43 != 0.0f)
+		return false;
+
+	// Only a pan in x / y is allowed
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			if ((column == 3 && row < 2) == false && cached.view.m[row][column] != current.view.m[row][column])
+				return false;
+		}
+	}
+
+	float renderWidth = static_cast<float>(m_pGCRenderResources->m_renderWidth);
+	float renderHeight = static_cast<float>(m_pGCRenderResources->m_renderHeight);
+
+	// Clip space delta to pixels, y down
+	float offsetX = (current.view._14 - cached.view._14) * current.proj._11 * renderWidth * 0.5f;
+	float offsetY = -(current.view._24 - cached.view._24) * current.proj._22 * renderHeight * 0.5f;
+
+	float roundedX = std::round(offsetX);
+	float roundedY = std::round(offsetY);
+
+	// The copy moves whole pixels, a sub pixel pan would shift the static draws against the others
+	if (std::abs(offsetX - roundedX) > 0.01f || std::abs(offsetY - roundedY) > 0.01f)
+		return false;
+	if (std::abs(roundedX) > m_staticLayerMargin || std::abs(roundedY) > m_staticLayerMargin)
+		return false;
+
+	outOffsetX = static_cast<int>(roundedX);
+	outOffsetY = static_cast<int>(roundedY);
+
+	return true;
+}
+
+void GCRenderContext::RenderStaticLayer()
+{
+	ID3D12GraphicsCommandList* pCommandList = m_pGCRenderResources->m_pCommandList;
+
+	UINT renderWidth = m_pGCRenderResources->m_renderWidth;
+	UINT renderHeight = m_pGCRenderResources->m_renderHeight;
+	UINT layerWidth = renderWidth + 2 * m_staticLayerMargin;
+	UINT layerHeight = renderHeight + 2 * m_staticLayerMargin;
+
+	// Same camera, the projection covers the margin : x and y clip rows scaled down
+	GCVIEWPROJCB layerCamera = m_frameCamera;
+	float scaleX = static_cast<float>(renderWidth) / static_cast<float>(layerWidth);
+	float scaleY = static_cast<float>(renderHeight) / static_cast<float>(layerHeight);
+	for (int column = 0; column < 4; column++)
+	{
+		layerCamera.proj.m[0][column] *= scaleX;
+		layerCamera.proj.m[1][column] *= scaleY;
+	}
+	m_pCbStaticLayerViewProj->CopyData(0, layerCamera);
+	AddConstantBufferBytes(m_pCbStaticLayerViewProj->GetElementByteSize());
+
+	if (m_staticLayerState != D3D12_RESOURCE_STATE_RENDER_TARGET)
+	{
+		CD3DX12_RESOURCE_BARRIER toRenderTarget = CD3DX12_RESOURCE_BARRIER::Transition(m_pStaticLayerRtv->pResource, m_staticLayerState, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		pCommandList->ResourceBarrier(1, &toRenderTarget);
+	}
+
+	pCommandList->ClearRenderTargetView(m_pStaticLayerRtv->cpuHandle, DirectX::Colors::LightBlue, 0, nullptr);
+
+	D3D12_VIEWPORT viewport = { 0.0f, 0.0f, static_cast<float>(layerWidth), static_cast<float>(layerHeight), 0.0f, 1.0f };
+	D3D12_RECT scissorRect = { 0, 0, static_cast<LONG>(layerWidth), static_cast<LONG>(layerHeight) };
+	pCommandList->RSSetViewports(1, &viewport);
+	pCommandList->RSSetScissorRects(1, &scissorRect);
+	pCommandList->OMSetRenderTargets(1, &m_pStaticLayerRtv->cpuHandle, FALSE, nullptr);
+
+	GCD3D12DrawRecorder recorder(pCommandList);
+	RecordDraws(recorder, m_vStaticDrawCommands, 0, static_cast<int>(m_vStaticDrawCommands.size()), m_pCbStaticLayerViewProj->GetGPUVirtualAddress(), m_stateChangeStats);
+
+	CD3DX12_RESOURCE_BARRIER toCopySource = CD3DX12_RESOURCE_BARRIER::Transition(m_pStaticLayerRtv->pResource, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE);
+	pCommandList->ResourceBarrier(1, &toCopySource);
+	m_staticLayerState = D3D12_RESOURCE_STATE_COPY_SOURCE;
+
+	m_staticLayerCamera = m_frameCamera;
+	m_staticLayerOffsetX = 0;
+	m_staticLayerOffsetY = 0;
+	m_isStaticLayerValid = true;
+	m_vStaticDrawCommands.clear();
+
+	// Frame targets back for the other draws
+	BindFrameState(pCommandList);
+}
+
+void GCRenderContext::CopyStaticLayer()
+{
+	ID3D12GraphicsCommandList* pCommandList = m_pGCRenderResources->m_pCommandList;
+	ID3D12Resource* pBackBuffer = m_pGCRenderResources->CurrentBackBuffer();
+
+	// Layer texel of the top left render pixel : margin, minus the pan since the layer was rendered
+	D3D12_BOX sourceBox;
+	sourceBox.left = m_staticLayerMargin - m_staticLayerOffsetX;
+	sourceBox.top = m_staticLayerMargin - m_staticLayerOffsetY;
+	sourceBox.right = sourceBox.left + m_pGCRenderResources->m_renderWidth;
+	sourceBox.bottom = sourceBox.top + m_pGCRenderResources->m_renderHeight;
+	sourceBox.front = 0;
+	sourceBox.back = 1;
+
+	UINT destinationX = static_cast<UINT>(std::max<LONG>(m_pGCRenderResources->m_ScissorRect.left, 0));
+	UINT destinationY = static_cast<UINT>(std::max<LONG>(m_pGCRenderResources->m_ScissorRect.top, 0));
+
+	CD3DX12_TEXTURE_COPY_LOCATION destination(pBackBuffer, 0);
+	CD3DX12_TEXTURE_COPY_LOCATION source(m_pStaticLayerRtv->pResource, 0);
+
+	CD3DX12_RESOURCE_BARRIER toCopyDest = CD3DX12_RESOURCE_BARRIER::Transition(pBackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_DEST);
+	pCommandList->ResourceBarrier(1, &toCopyDest);
+
+	pCommandList->CopyTextureRegion(&destination, destinationX, destinationY, 0, &source, &sourceBox);
+
+	CD3DX12_RESOURCE_BARRIER toRenderTarget = CD3DX12_RESOURCE_BARRIER::Transition(pBackBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	pCommandList->ResourceBarrier(1, &toRenderTarget);
+}
+
+void GCRenderContext::InvalidateStaticLayer()
+{
+	m_isStaticLayerValid = false;
+}
+
+void GCRenderContext::ActiveStaticLayer() {
+	if (m_pStaticLayerRtv == nullptr)
+	{
+		D3D12_CLEAR_VALUE clearValue = {};
+		clearValue.Format = m_pGCRenderResources->GetBackBufferFormat();
+		memcpy(clearValue.Color, DirectX::Colors::LightBlue, sizeof(clearValue.Color));
+
+		UINT layerWidth = m_pGCRenderResources->m_renderWidth + 2 * m_staticLayerMargin;
+		UINT layerHeight = m_pGCRenderResources->m_renderHeight + 2 * m_staticLayerMargin;
+		m_pStaticLayerRtv = m_pGCRenderResources->CreateRTVTexture(m_pGCRenderResources->GetBackBufferFormat(), D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET, &clearValue, layerWidth, layerHeight);
+		m_staticLayerState = D3D12_RESOURCE_STATE_COMMON;
+
+		m_pCbStaticLayerViewProj = new GCShaderUploadBuffer<GCVIEWPROJCB>(m_pGCRenderResources->m_pGpuAllocator, 1, true);
+	}
+
+	m_isStaticLayerActivated = true;
+	m_isStaticLayerValid = false;
+}
+
+void GCRenderContext::DesactiveStaticLayer() {
+	m_isStaticLayerActivated = false;
+	m_isStaticLayerValid = false;
+}
+
+void GCRenderContext::ActiveCulling() {
+	m_isCullingActivated = true;
+}
+
+void GCRenderContext::DesactiveCulling() {
+	m_isCullingActivated = false;
+	m_culler.Clear();
+}
+
+void GCRenderContext::ActivePixelIdReadback(int depth) {
+	ActivePixelIDMapping();
+
+	if (m_pPixelIdReadback == nullptr)
+		m_pPixelIdReadback = new GCTextureReadback();
+
+	m_pPixelIdReadback->Initialize(m_pGCRenderResources->m_pDevice, m_pPixelIdMappingBufferRtv->pResource, depth);
+}
+
+void GCRenderContext::DesactivePixelIdReadback() {
+	// Copies still in flight write into the buffers, wait them out before releasing
+	FlushCommandQueue();
+	GC_DELETE(m_pPixelIdReadback);
+}
+
+void GCRenderContext::ActiveGpuTimer(int depth) {
+	if (m_pGpuTimer == nullptr)
+		m_pGpuTimer = new GCGpuTimer();
+
+	if (m_pGpuTimer->Initialize(m_pGCRenderResources->m_pDevice, m_pGCRenderResources->m_pCommandQueue, static_cast<UINT32>(std::max(depth, 2))) == false)
+	{
+		GC_DELETE(m_pGpuTimer);
+	}
+}
+
+void GCRenderContext::DesactiveGpuTimer() {
+	// Resolves still in flight write into the readback buffer
+	FlushCommandQueue();
+	GC_DELETE(m_pGpuTimer);
+}
+
+void GCRenderContext::SetPixelIdReadbackRegion(int x, int y, int width, int height)
+{
+	if (m_pPixelIdReadback)
+		m_pPixelIdReadback->SetRegion(x, y, width, height);
+}
+
+void GCRenderContext::SetPixelIdReadbackFullRegion()
+{
+	if (m_pPixelIdReadback)
+		m_pPixelIdReadback->SetFullRegion();
+}
+
+bool GCRenderContext::GetPixelIdAt(int x, int y, int& outObjectId, int& outMaterialId)
+{
+	if (m_pPixelIdReadback == nullptr)
+		return false;
+
+	m_pPixelIdReadback->Update(m_pGCRenderResources->m_pFence);
+
+	uint32_t texel;
+	if (m_pPixelIdReadback->ReadTexel(x, y, texel) == false)
+		return false;
+
+	// Written as unorm r = objectId % 256, g = materialId % 256, b = (materialId / 256) % 256
+	outObjectId = static_cast<int>(texel & 0xFF);
+	outMaterialId = static_cast<int>((texel >> 8) & 0xFFFF);
+
+	return true;
+}
+
+void GCRenderContext::ActiveDrawSorting() {
+	m_isDrawSortingActivated = true;
+}
+
+void GCRenderContext::DesactiveDrawSorting() {
+	m_isDrawSortingActivated = false;
+	m_renderQueue.Clear();
+}
+
 void GCRenderContext::DesactiveDeferredLightPass() {
 	m_isDeferredLightPassActivated = false;
 }
\ No newline at end of file
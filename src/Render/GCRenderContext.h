@@ -1,5 +1,57 @@
 #pragma once
 
+// Draw submitted by DrawObject, recorded into a command list when the frame is completed
+struct GC_DRAW_COMMAND
+{
+	GCMesh* pMesh;
+	GCMaterial* pMaterial;
+	bool alpha;
+
+	// Object cb filled for this draw, captured at submit because the material cb count moves on
+	D3D12_GPU_VIRTUAL_ADDRESS objectCbAddress;
+
+	// Index of the draw bounds in the culler, -1 when the draw is never culled
+	int cullIndex;
+
+	// Instanced draw (particles) : instances read instanceSrv (t1, descriptor table slot 2), ptr 0 when unused
+	UINT instanceCount;
+	D3D12_GPU_DESCRIPTOR_HANDLE instanceSrv;
+};
+
+// What a frame did, published at the end of the frame. Upload counters hold everything written since the previous frame
+struct GC_FRAME_STATS
+{
+	UINT64 frameIndex = 0;
+
+	int drawCalls = 0;
+	UINT64 triangles = 0;
+	int culledDraws = 0;
+
+	int psoChanges = 0;
+	int rootSignatureChanges = 0;
+	int stateChangesSkipped = 0;
+
+	UINT64 constantBufferBytes = 0; // Shader cb writes count their 256 B aligned slot
+	UINT64 meshUploadBytes = 0; // Vertex and index bytes packed by mesh buffer creations
+	int descriptorsAllocated = 0; // Views in use at the end of the frame : SRV, UAV and buffer view ranges
+
+	int materialsUsed = 0; // Set by GCGraphics
+	double cpuFrameMs = 0.0; // Set by GCGraphics : previous EndFrame to this one
+
+	// Last frame read back by the GPU timer, when active
+	bool hasGpuTiming = false;
+	UINT64 gpuFrameIndex = 0;
+	double gpuFrameMs = 0.0;
+};
+
+// How static draws are handled this frame, decided by PrepareDraw
+enum GC_STATIC_LAYER_MODE
+{
+	GC_STATIC_LAYER_BYPASS, // Layer unusable (3D, pixel id, deferred, off), static draws are drawn as any other draw
+	GC_STATIC_LAYER_REBUILD, // Static draws are rendered in the layer, then the layer is copied to the back buffer
+	GC_STATIC_LAYER_CACHED, // Static draws are skipped, the layer rendered in a previous frame is copied
+};
+
 
 class GCRenderContext
 {
@@ -21,6 +73,8 @@ public:
 
 	void CreatePostProcessingResources(std::string shaderfilePath, std::string csoDestinationPath);
 	void CreateDeferredLightPassResources();
+	// Pixel id target, created on first activation : CPU picking (LE GetObjectAt) doesn't need it
+	void CreatePixelIdMappingResources();
 
 	// Resize 
 	void ReleasePreviousResources();
@@ -41,20 +95,69 @@ public:
 
 	bool PrepareDraw();
 
-	bool DrawObject(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha);
+	// depth is only used by draw sorting : opaque draws front to back, alpha draws back to front
+	// pWorldMatrix (as uploaded in GCWORLDCB) is only used by culling, draws without it are always kept
+	bool DrawObject(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha, float depth = 0.0f, const DirectX::XMFLOAT4X4* pWorldMatrix = nullptr);
+	// Draw of the static layer, drawn below every DrawObject of the frame in submission order.
+	// Skipped while the layer is cached : the object cb doesn't need to be updated either (see IsStaticLayerCached)
+	bool DrawStaticObject(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha);
+	// instanceCount copies of the mesh in one draw, instanceSrv is bound on the shader descriptor table slot 2 (t1).
+	// Never culled : instances are placed by the shader
+	bool DrawObjectInstanced(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha, UINT instanceCount, D3D12_GPU_DESCRIPTOR_HANDLE instanceSrv, float depth = 0.0f);
 
 	bool CompleteDraw();
 
+	inline GCThreadPool* GetThreadPool() { return m_pThreadPool; }
+	inline const GC_STATE_CHANGE_STATS& GetStateChangeStats() const { return m_stateChangeStats; }
+	// Render counters of the last completed frame
+	inline const GC_FRAME_STATS& GetFrameStats() const { return m_lastFrameStats; }
+	// Upload counters of the frame being built, main thread
+	inline void AddConstantBufferBytes(UINT64 bytes) { m_frameStats.constantBufferBytes += bytes; }
+	inline void AddMeshUploadBytes(UINT64 bytes) { m_frameStats.meshUploadBytes += bytes; }
+	inline const GCCuller& GetCuller() const { return m_culler; }
+	inline GCStagingRing* GetStagingRing() { return m_pStagingRing; }
+	inline UINT64 GetFrameIndex() const { return m_frameIndex; }
+
+	// Camera of the frame (as uploaded in the camera cb), used by culling and the static layer
+	void SetFrameCamera(const GCVIEWPROJCB& camera);
+
+	// Static layer must be rendered again : a static object moved, changed or was removed
+	void InvalidateStaticLayer();
+	inline bool IsStaticLayerCached() const { return m_staticLayerMode == GC_STATIC_LAYER_CACHED; }
+
+	// Pixel id readback : full target by default, or only a rect (e.g. around the cursor)
+	void SetPixelIdReadbackRegion(int x, int y, int width, int height);
+	void SetPixelIdReadbackFullRegion();
+	// Ids of the last copy finished by the GPU (one or more frames old), false if not available. Never waits
+	bool GetPixelIdAt(int x, int y, int& outObjectId, int& outMaterialId);
+	// GPU pass timings of the last frame finished by the GPU, nullptr when the timer isn't active
+	inline const GCGpuTimer* GetGpuTimer() const { return m_pGpuTimer; }
+
 	void OnResize(); 
 
 
 	void ActiveCSPostProcessing();
 	void ActivePixelIDMapping();
 	void ActiveDeferredLightPass();
+	void ActiveDrawSorting();
+	void ActiveCulling();
+	// Copies the pixel id target to a readback ring (depth frames) at the end of each frame, activates the mapping
+	void ActivePixelIdReadback(int depth = 3);
+	// Timestamps around the frame passes (draws, pixel id copy, light pass, post processing), read depth frames later
+	void ActiveGpuTimer(int depth = 3);
+	// 2D only : static draws are rendered once in an offscreen target larger than the render by a margin,
+	// copied to the back buffer every frame and rendered again when invalidated or when the camera pans
+	// further than the margin, zooms, rotates or changes projection
+	void ActiveStaticLayer();
 
 	void DesactiveCSPostProcessing();
 	void DesactivePixelIDMapping();
 	void DesactiveDeferredLightPass();
+	void DesactiveDrawSorting();
+	void DesactiveCulling();
+	void DesactivePixelIdReadback();
+	void DesactiveGpuTimer();
+	void DesactiveStaticLayer();
 
 
 	// Camera & Light Upload
@@ -67,15 +170,96 @@ public:
 	inline void Set3DMode() { m_renderMode = 1; }
 	int GetRenderMode() { return m_renderMode; }
 	// DEFERRED SHADING LIGHT RESOURCES
-	// All diferent material used in same frame
-	std::vector<GC_MATERIAL_DSL> m_materialsUsedInFrame;
-	// Upload Material DSL, Send to Deferred Shader
+	// Upload Material DSL, Send to Deferred Shader, structured buffer indexed by material id
 	GCUploadBuffer<GC_MATERIAL_DSL>* m_pCbMaterialDsl;
 
+	// Flags the material dirty, its properties are copied in the material table at the next deferred light pass.
+	// The table grows with the ids, up to m_maxMaterialsDsl (65536) : the others are ignored with a warning logged once
+	void UpdateMaterialDsl(GCMaterial* pMaterial);
+	// Before the material is deleted
+	void OnMaterialRemoved(GCMaterial* pMaterial);
+
 	std::string m_PPa;
 	std::string m_PPb;
 	//*
 private:
+	// Draw recording
+	void BindFrameState(ID3D12GraphicsCommandList* pCommandList);
+	bool BuildDrawCommand(GCMesh* pMesh, GCMaterial* pMaterial, bool alpha, GC_DRAW_COMMAND& outCommand);
+	void ResolveDrawBindings(const GC_DRAW_COMMAND& command, D3D12_GPU_VIRTUAL_ADDRESS cameraCbAddress, GC_DRAW_BINDINGS& outDraw) const;
+	void RecordDraws(GCDrawRecorder& recorder, const std::vector<GC_DRAW_COMMAND>& commands, int begin, int end, D3D12_GPU_VIRTUAL_ADDRESS cameraCbAddress, GC_STATE_CHANGE_STATS& stats);
+	bool SubmitDraws();
+
+	// Static layer
+	void UpdateStaticLayerMode();
+	bool ComputeStaticLayerOffset(int& outOffsetX, int& outOffsetY) const;
+	void RenderStaticLayer();
+	void CopyStaticLayer();
+
+	void UploadDirtyMaterials();
+	// Doubles m_pCbMaterialDsl until the table fits, then uploads the whole table
+	void GrowMaterialDslBuffer();
+
+	static constexpr int m_maxRecordingCommandLists = 8;
+	// Below this amount of draws per list, recording in parallel costs more than it saves
+	static constexpr int m_minDrawsPerRecordingList = 256;
+
+	GCThreadPool* m_pThreadPool;
+
+	std::vector<GC_DRAW_COMMAND> m_vDrawCommands;
+
+	// Draw sorting, off by default : 2D relies on submission order for overlapping opaque draws
+	bool m_isDrawSortingActivated;
+	GCRenderQueue m_renderQueue;
+	std::vector<GC_DRAW_COMMAND> m_vSortedDrawCommands;
+
+	// Culling, off by default
+	bool m_isCullingActivated;
+	GCCuller m_culler;
+
+	GCVIEWPROJCB m_frameCamera;
+
+	// Static layer, off by default
+	static constexpr int m_staticLayerMargin = 256; // Pixels cached around the render on each side
+	bool m_isStaticLayerActivated;
+	bool m_isStaticLayerValid;
+	GC_STATIC_LAYER_MODE m_staticLayerMode;
+	std::vector<GC_DRAW_COMMAND> m_vStaticDrawCommands;
+	GC_DESCRIPTOR_RESOURCE* m_pStaticLayerRtv;
+	D3D12_RESOURCE_STATES m_staticLayerState;
+	GCShaderUploadBufferBase* m_pCbStaticLayerViewProj;
+	GCVIEWPROJCB m_staticLayerCamera; // Frame camera the layer was rendered with
+	int m_staticLayerOffsetX; // Camera pan since the layer was rendered, in pixels
+	int m_staticLayerOffsetY;
+
+	GCTextureReadback* m_pPixelIdReadback;
+	GCGpuTimer* m_pGpuTimer;
+	UINT32 m_gpuFrameZone;
+	UINT32 m_gpuDrawsZone;
+	GCStagingRing* m_pStagingRing;
+	UINT64 m_frameIndex;
+
+	GCParallelDrawRecording m_parallelRecording;
+
+	GC_STATE_CHANGE_STATS m_stateChangeStats;
+	GC_FRAME_STATS m_frameStats; // Being built
+	GC_FRAME_STATS m_lastFrameStats;
+
+	// The pixel id map stores the material id on 16 bits (g low byte, b high byte)
+	static constexpr int m_maxMaterialsDsl = 65536;
+	static constexpr int m_initialMaterialDslCapacity = 256;
+	// CPU copy of m_pCbMaterialDsl, only the entries of dirty materials are uploaded
+	std::vector<GC_MATERIAL_DSL> m_vMaterialDslTable;
+	std::vector<GCMaterial*> m_vDirtyMaterials; // Flagged by UpdateMaterialDsl, once each
+	std::vector<int> m_vDirtyMaterialIds; // Upload scratch
+	int m_materialDslCapacity; // Elements of m_pCbMaterialDsl
+	bool m_hasWarnedMaterialDslLimit;
+
+	// Targets bound by PrepareDraw, set again on every recording command list
+	std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> m_vFrameRtvs;
+	D3D12_CPU_DESCRIPTOR_HANDLE m_frameDsv;
+	bool m_hasFrameDsv;
+
 	bool m_isPixelIDMappingActivated; 
 	bool m_isDeferredLightPassActivated;
 
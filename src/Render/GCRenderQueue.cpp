@@ -0,0 +1,111 @@
+#include "pch.h"
+
+// Below this size a comparison sort beats the 8 histogram passes
+static constexpr size_t RADIX_SORT_MIN_COUNT = 256;
+
+uint32_t GCRenderQueue::OrderedFloatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(uint32_t));
+
+    // Positive -> set sign bit, negative -> flip every bit
+    uint32_t mask = (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+    return bits ^ mask;
+}
+
+uint64_t GCRenderQueue::MakeOpaqueKey(int shaderId, int materialId, int textureId, float depth)
+{
+    uint64_t key = 0;
+    key |= (static_cast<uint64_t>(shaderId) & 0xFFF) << 51;
+    key |= (static_cast<uint64_t>(materialId) & 0xFFFF) << 35;
+    key |= (static_cast<uint64_t>(textureId) & 0xFFF) << 23;
+    key |= static_cast<uint64_t>(OrderedFloatBits(depth) >> 9);
+
+    return key;
+}
+
+uint64_t GCRenderQueue::MakeAlphaKey(float depth, uint32_t sequence)
+{
+    // Farthest first
+    uint32_t invertedDepth = ~OrderedFloatBits(depth) >> 1;
+
+    uint64_t key = 1ull << 63;
+    key |= static_cast<uint64_t>(invertedDepth) << 32;
+    key |= sequence;
+
+    return key;
+}
+
+void GCRenderQueue::Reserve(size_t count)
+{
+    m_vEntries.reserve(count);
+    m_vScratch.reserve(count);
+}
+
+void GCRenderQueue::Push(uint64_t key)
+{
+    GC_RENDER_QUEUE_ENTRY entry;
+    entry.key = key;
+    entry.index = static_cast<uint32_t>(m_vEntries.size());
+    m_vEntries.push_back(entry);
+}
+
+void GCRenderQueue::Sort()
+{
+    RadixSort(m_vEntries, m_vScratch);
+}
+
+void GCRenderQueue::RadixSort(std::vector<GC_RENDER_QUEUE_ENTRY>& entries, std::vector<GC_RENDER_QUEUE_ENTRY>& scratch)
+{
+    size_t count = entries.size();
+
+    if (count < RADIX_SORT_MIN_COUNT)
+    {
+        std::stable_sort(entries.begin(), entries.end(), [](const GC_RENDER_QUEUE_ENTRY& a, const GC_RENDER_QUEUE_ENTRY& b) { return a.key < b.key; });
+        return;
+    }
+
+    scratch.resize(count);
+
+    // One read of the keys builds the histograms of the 8 bytes
+    uint32_t histograms[8][256] = {};
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t key = entries[i].key;
+        for (int pass = 0; pass < 8; pass++)
+            histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+    }
+
+    GC_RENDER_QUEUE_ENTRY* pSource = entries.data();
+    GC_RENDER_QUEUE_ENTRY* pDestination = scratch.data();
+
+    for (int pass = 0; pass < 8; pass++)
+    {
+        uint32_t* histogram = histograms[pass];
+        int shift = pass * 8;
+
+        // Every key shares this byte, the pass wouldn't move anything
+        if (histogram[(pSource[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++)
+        {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const GC_RENDER_QUEUE_ENTRY& entry = pSource[i];
+            pDestination[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+
+        std::swap(pSource, pDestination);
+    }
+
+    // Odd number of passes done, result sits in scratch
+    if (pSource != entries.data())
+        entries.swap(scratch);
+}
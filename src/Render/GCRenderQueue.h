@@ -0,0 +1,37 @@
+#pragma once
+
+struct GC_RENDER_QUEUE_ENTRY
+{
+	uint64_t key;
+	uint32_t index; // Position of the draw in submission order
+};
+
+// Sort keys for the frame draws, LSD radix sorted (stable) before recording.
+// Opaque : | pass 0 (1) | shader (12) | material (16) | texture (12) | depth front to back (23) |
+// Alpha  : | pass 1 (1) | depth back to front (31) | submission order (32) |
+class GCRenderQueue
+{
+public:
+	static uint64_t MakeOpaqueKey(int shaderId, int materialId, int textureId, float depth);
+	static uint64_t MakeAlphaKey(float depth, uint32_t sequence);
+
+	void Clear() { m_vEntries.clear(); }
+	void Reserve(size_t count);
+	void Push(uint64_t key);
+
+	void Sort();
+
+	inline size_t GetCount() const { return m_vEntries.size(); }
+	inline uint32_t GetSortedIndex(size_t i) const { return m_vEntries[i].index; }
+	inline const std::vector<GC_RENDER_QUEUE_ENTRY>& GetEntries() const { return m_vEntries; }
+
+	// Stable sort by key, scratch is resized to entries size and reused between calls
+	static void RadixSort(std::vector<GC_RENDER_QUEUE_ENTRY>& entries, std::vector<GC_RENDER_QUEUE_ENTRY>& scratch);
+
+private:
+	// Float bits flipped so unsigned order follows float order, negatives included
+	static uint32_t OrderedFloatBits(float value);
+
+	std::vector<GC_RENDER_QUEUE_ENTRY> m_vEntries;
+	std::vector<GC_RENDER_QUEUE_ENTRY> m_vScratch;
+};
@@ -21,6 +21,8 @@ GCRenderResources::GCRenderResources()
 	m_pFence(nullptr),
 	m_CurrentFence(0),
 
+	m_pGpuAllocator(nullptr),
+
 	m_pRtvHeap(nullptr),
 	m_pDsvHeap(nullptr),
 	m_pCbvSrvUavDescriptorHeap(nullptr),
@@ -50,7 +52,10 @@ GCRenderResources::~GCRenderResources() {
 
 	// Release all RTV resources
 	for (auto& rtvResource : m_lRenderTargets) {
-		rtvResource->pResource->Release();
+		if (rtvResource->allocation.IsValid())
+			m_pGpuAllocator->Free(rtvResource->allocation);
+		else
+			rtvResource->pResource->Release();
 	}
 
 	// Release all DSV resources
@@ -58,6 +63,9 @@ GCRenderResources::~GCRenderResources() {
 		dsvResource->pResource->Release();
 	}
 
+	// Every page, after the resources placed in them
+	GC_DELETE(m_pGpuAllocator);
+
 	m_lShaderResourceView.clear(); 
 	m_lUnorderedAccessView.clear();
 
@@ -70,6 +78,13 @@ GCRenderResources::~GCRenderResources() {
 	m_pCommandList->Release();
 	m_pDirectCmdListAlloc->Release();
 
+	for (size_t i = 0; i < m_vRecordingCommandLists.size(); i++) {
+		m_vRecordingCommandLists[i]->Release();
+		m_vRecordingCmdListAllocs[i]->Release();
+	}
+	m_vRecordingCommandLists.clear();
+	m_vRecordingCmdListAllocs.clear();
+
 	// Release Command Queue
 	m_pCommandQueue->Release();
 
@@ -92,7 +107,42 @@ void GCRenderResources::CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type, UI
 	HRESULT hr = m_pDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(pDescriptorHeap));
 }
 
-GC_DESCRIPTOR_RESOURCE* GCRenderResources::CreateRTVTexture(DXGI_FORMAT format, D3D12_RESOURCE_FLAGS resourceFlags, D3D12_CLEAR_VALUE* clearValue)
+UINT64 GCRenderResources::GetResourceSize(ID3D12Resource* pResource) const
+{
+	if (pResource == nullptr)
+		return 0;
+
+	D3D12_RESOURCE_DESC desc = pResource->GetDesc();
+	return m_pDevice->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+}
+
+void GCRenderResources::UpdateDescriptorMemory(int textureDescriptorCount)
+{
+	UINT64 heapBytes = 0;
+	ID3D12DescriptorHeap* heaps[] = { m_pRtvHeap, m_pDsvHeap, m_pCbvSrvUavDescriptorHeap };
+	for (ID3D12DescriptorHeap* pHeap : heaps)
+	{
+		if (pHeap == nullptr)
+			continue;
+		D3D12_DESCRIPTOR_HEAP_DESC desc = pHeap->GetDesc();
+		heapBytes += static_cast<UINT64>(desc.NumDescriptors) * m_pDevice->GetDescriptorHandleIncrementSize(desc.Type);
+	}
+
+	int usedCount = textureDescriptorCount + m_rtvOffsetCount + m_dsvOffsetCount + GetViewDescriptorCount();
+
+	m_memoryTracker.Set(GC_MEMORY_CATEGORY_DESCRIPTORS, heapBytes, usedCount);
+}
+
+int GCRenderResources::GetViewDescriptorCount() const
+{
+	// Each range is filled from its first offset
+	return (m_srvStaticOffsetCount - m_srvStaticOffsetStart)
+		+ (m_srvDynamicOffsetCount - m_srvDynamicOffsetStart)
+		+ (m_uavOffsetCount - m_uavOffsetStart)
+		+ GetBufferViewCount();
+}
+
+GC_DESCRIPTOR_RESOURCE* GCRenderResources::CreateRTVTexture(DXGI_FORMAT format, D3D12_RESOURCE_FLAGS resourceFlags, D3D12_CLEAR_VALUE* clearValue, UINT width, UINT height)
 {
 	//Handle Cpu
 	CD3DX12_CPU_DESCRIPTOR_HANDLE rtvCpuHandle(m_pRtvHeap->GetCPUDescriptorHandleForHeapStart());
@@ -100,8 +150,8 @@ GC_DESCRIPTOR_RESOURCE* GCRenderResources::CreateRTVTexture(DXGI_FORMAT format,
 
 	D3D12_RESOURCE_DESC textureDesc = {};
 	textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	textureDesc.Width = m_renderWidth;
-	textureDesc.Height = m_renderHeight;
+	textureDesc.Width = width > 0 ? width : m_renderWidth;
+	textureDesc.Height = height > 0 ? height : m_renderHeight;
 	textureDesc.DepthOrArraySize = 1;
 	textureDesc.MipLevels = 1;
 	textureDesc.Format = format;
@@ -121,16 +171,14 @@ GC_DESCRIPTOR_RESOURCE* GCRenderResources::CreateRTVTexture(DXGI_FORMAT format,
 	// Use the provided clear value or the default one
 	D3D12_CLEAR_VALUE* actualClearValue = clearValue ? clearValue : &defaultClearValue;
 
-	CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
-	ID3D12Resource* renderTargetTexture = nullptr;
-	HRESULT hr = m_pDevice->CreateCommittedResource(
-		&heapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&textureDesc,
+	GC_GPU_ALLOCATION allocation;
+	m_pGpuAllocator->CreateTexture(
+		textureDesc,
 		D3D12_RESOURCE_STATE_COMMON,
 		resourceFlags == D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS ? nullptr: actualClearValue,
-		IID_PPV_ARGS(&renderTargetTexture)
+		allocation
 	);
+	ID3D12Resource* renderTargetTexture = allocation.pResource;
 
 	D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
 	rtvDesc.Format = format;
@@ -147,6 +195,7 @@ GC_DESCRIPTOR_RESOURCE* GCRenderResources::CreateRTVTexture(DXGI_FORMAT format,
 	GC_DESCRIPTOR_RESOURCE* descriptorResource = new GC_DESCRIPTOR_RESOURCE();
 	descriptorResource->pResource = renderTargetTexture;
 	descriptorResource->cpuHandle = rtvCpuHandle;
+	descriptorResource->allocation = allocation;
 
 	m_lRenderTargets.push_back(descriptorResource);
 
@@ -188,6 +237,7 @@ GC_DESCRIPTOR_RESOURCE* GCRenderResources::CreateDepthStencilBufferAndView(DXGI_
 		IID_PPV_ARGS(&depthStencilBuffer)
 	);
 	GC_CHECK_HRESULT(hr, "Dsv Bad Init");
+	m_memoryTracker.Add(GC_MEMORY_CATEGORY_RENDER_TARGETS, GetResourceSize(depthStencilBuffer));
 
 	D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
 	dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
@@ -276,3 +326,82 @@ CD3DX12_GPU_DESCRIPTOR_HANDLE GCRenderResources::CreateUavTexture(ID3D12Resource
 
 	return uavGpuHandle;
 }
+
+CD3DX12_GPU_DESCRIPTOR_HANDLE GCRenderResources::CreateSrvWithBuffer(ID3D12Resource* bufferResource, UINT elementCount, UINT elementByteSize)
+{
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.NumElements = elementCount;
+	srvDesc.Buffer.StructureByteStride = elementByteSize;
+	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
+
+	int offset = AllocateBufferViewOffset();
+	if (offset < 0)
+		return CD3DX12_GPU_DESCRIPTOR_HANDLE(D3D12_DEFAULT);
+
+	CD3DX12_CPU_DESCRIPTOR_HANDLE srvCpuHandle(m_pCbvSrvUavDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
+	srvCpuHandle.Offset(offset, m_cbvSrvUavDescriptorSize);
+
+	CD3DX12_GPU_DESCRIPTOR_HANDLE srvGpuHandle(m_pCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+	srvGpuHandle.Offset(offset, m_cbvSrvUavDescriptorSize);
+
+	m_pDevice->CreateShaderResourceView(bufferResource, &srvDesc, srvCpuHandle);
+
+	return srvGpuHandle;
+}
+
+CD3DX12_GPU_DESCRIPTOR_HANDLE GCRenderResources::CreateUavWithBuffer(ID3D12Resource* bufferResource, UINT elementCount, UINT elementByteSize)
+{
+	D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+	uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+	uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+	uavDesc.Buffer.FirstElement = 0;
+	uavDesc.Buffer.NumElements = elementCount;
+	uavDesc.Buffer.StructureByteStride = elementByteSize;
+	uavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
+
+	int offset = AllocateBufferViewOffset();
+	if (offset < 0)
+		return CD3DX12_GPU_DESCRIPTOR_HANDLE(D3D12_DEFAULT);
+
+	CD3DX12_CPU_DESCRIPTOR_HANDLE uavCpuHandle(m_pCbvSrvUavDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
+	uavCpuHandle.Offset(offset, m_cbvSrvUavDescriptorSize);
+
+	CD3DX12_GPU_DESCRIPTOR_HANDLE uavGpuHandle(m_pCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+	uavGpuHandle.Offset(offset, m_cbvSrvUavDescriptorSize);
+
+	m_pDevice->CreateUnorderedAccessView(bufferResource, nullptr, &uavDesc, uavCpuHandle);
+
+	return uavGpuHandle;
+}
+
+void GCRenderResources::ReleaseBufferView(D3D12_GPU_DESCRIPTOR_HANDLE handle)
+{
+	if (handle.ptr == 0)
+		return;
+
+	UINT64 heapStart = m_pCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart().ptr;
+	m_vFreeBufferViewOffsets.push_back(static_cast<int>((handle.ptr - heapStart) / m_cbvSrvUavDescriptorSize));
+}
+
+int GCRenderResources::AllocateBufferViewOffset()
+{
+	if (m_vFreeBufferViewOffsets.empty() == false)
+	{
+		int offset = m_vFreeBufferViewOffsets.back();
+		m_vFreeBufferViewOffsets.pop_back();
+		return offset;
+	}
+
+	// Past the end is outside the shader visible heap
+	if (m_bufferViewOffsetCount >= m_cbvSrvUavDescriptorCount)
+	{
+		GCGraphicsLogger::GetInstance().LogWarning("Can't create buffer view, the " + std::to_string(m_cbvSrvUavDescriptorCount - m_bufferViewOffsetStart) + " buffer views are in use : release unused particle systems");
+		return -1;
+	}
+
+	return m_bufferViewOffsetCount++;
+}
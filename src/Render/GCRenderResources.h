@@ -4,6 +4,7 @@ struct GC_DESCRIPTOR_RESOURCE
 {
 	ID3D12Resource* pResource;
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle;
+	GC_GPU_ALLOCATION allocation; // Placed by the gpu allocator, pResource is allocation.pResource
 };
 
 class GCRenderResources {
@@ -33,8 +34,27 @@ public:
 	inline ID3D12Device* Getmd3dDevice() const { return m_pDevice; }
 	inline ID3D12CommandQueue* GetCommandQueue() const { return m_pCommandQueue; }
 	inline ID3D12CommandAllocator* GetCommandAllocator() const { return m_pDirectCmdListAlloc; }
+	inline ID3D12GraphicsCommandList* GetRecordingCommandList(int index) const { return m_vRecordingCommandLists[index]; }
+	inline int GetRecordingCommandListCount() const { return static_cast<int>(m_vRecordingCommandLists.size()); }
 	inline ID3D12Fence* GetFence() { return m_pFence; }
+	// Last value signaled on the command queue
+	inline UINT64 GetCurrentFenceValue() const { return m_CurrentFence; }
 	inline ID3D12Debug* GetDebugController() { return m_pDebugController; }
+	inline GCGpuMemoryAllocator* GetGpuAllocator() { return m_pGpuAllocator; }
+	inline GCMemoryTracker* GetMemoryTracker() { return &m_memoryTracker; }
+	// Size the device really allocates for the resource
+	UINT64 GetResourceSize(ID3D12Resource* pResource) const;
+	// Heap sizes and descriptors in use, textureDescriptorCount : the texture slots at the start of the cbv/srv/uav heap
+	void UpdateDescriptorMemory(int textureDescriptorCount);
+
+	// Structured buffer views (particles), null handle (ptr 0) when the buffer view range is full
+	CD3DX12_GPU_DESCRIPTOR_HANDLE CreateSrvWithBuffer(ID3D12Resource* bufferResource, UINT elementCount, UINT elementByteSize);
+	CD3DX12_GPU_DESCRIPTOR_HANDLE CreateUavWithBuffer(ID3D12Resource* bufferResource, UINT elementCount, UINT elementByteSize);
+	// Gives the view back to the range, the GPU must be done with it. Null handles are ignored
+	void ReleaseBufferView(D3D12_GPU_DESCRIPTOR_HANDLE handle);
+	inline int GetBufferViewCount() const { return m_bufferViewOffsetCount - m_bufferViewOffsetStart - static_cast<int>(m_vFreeBufferViewOffsets.size()); }
+	// Views in use in every CBV/SRV/UAV range after the textures : static and dynamic SRVs, UAVs and buffer views
+	int GetViewDescriptorCount() const;
 
 
 	//Descriptor Heaps
@@ -81,6 +101,10 @@ private:
 	ID3D12CommandQueue* m_pCommandQueue;
 	ID3D12CommandAllocator* m_pDirectCmdListAlloc;
 
+	// One list / allocator per draw chunk recorded in parallel, executed right after m_pCommandList
+	std::vector<ID3D12GraphicsCommandList*> m_vRecordingCommandLists;
+	std::vector<ID3D12CommandAllocator*> m_vRecordingCmdListAllocs;
+
 	//Fence
 	ID3D12Fence* m_pFence;
 	UINT64 m_CurrentFence;
@@ -88,6 +112,10 @@ private:
 	//Debug Controller
 	ID3D12Debug* m_pDebugController;
 
+	// Constant buffers, static meshes and render targets are placed in its pages
+	GCGpuMemoryAllocator* m_pGpuAllocator;
+	GCMemoryTracker m_memoryTracker;
+
 	//Descriptor heaps
 	ID3D12DescriptorHeap* m_pRtvHeap;
 	ID3D12DescriptorHeap* m_pDsvHeap;
@@ -123,20 +151,32 @@ private:
 	//Rtv Manager
 	int m_rtvOffsetCount = 2;
 	std::list<GC_DESCRIPTOR_RESOURCE*> m_lRenderTargets;
-	GC_DESCRIPTOR_RESOURCE* CreateRTVTexture(DXGI_FORMAT format, D3D12_RESOURCE_FLAGS resourceFlags = D3D12_RESOURCE_FLAG_NONE, D3D12_CLEAR_VALUE* clearValue = nullptr);
-
-	//Srv Manager
-	int m_srvStaticOffsetCount = 300;
-	int m_srvDynamicOffsetCount = 320;
+	// Sized as the render by default
+	GC_DESCRIPTOR_RESOURCE* CreateRTVTexture(DXGI_FORMAT format, D3D12_RESOURCE_FLAGS resourceFlags = D3D12_RESOURCE_FLAG_NONE, D3D12_CLEAR_VALUE* clearValue = nullptr, UINT width = 0, UINT height = 0);
+
+	//Srv Manager, textures use the offsets below m_srvStaticOffsetStart
+	static constexpr int m_srvStaticOffsetStart = 300;
+	static constexpr int m_srvDynamicOffsetStart = 320;
+	int m_srvStaticOffsetCount = m_srvStaticOffsetStart;
+	int m_srvDynamicOffsetCount = m_srvDynamicOffsetStart;
 	std::list<CD3DX12_GPU_DESCRIPTOR_HANDLE> m_lShaderResourceView;
 	CD3DX12_GPU_DESCRIPTOR_HANDLE CreateDynamicSrvWithTexture(ID3D12Resource* textureResource, DXGI_FORMAT format);
 	CD3DX12_GPU_DESCRIPTOR_HANDLE CreateStaticSrvWithTexture(ID3D12Resource* textureResource, DXGI_FORMAT format);
 
 	//Uav Manager
-	int m_uavOffsetCount = 400;
+	static constexpr int m_uavOffsetStart = 400;
+	int m_uavOffsetCount = m_uavOffsetStart;
 	std::list<CD3DX12_CPU_DESCRIPTOR_HANDLE> m_lUnorderedAccessView;
 	CD3DX12_GPU_DESCRIPTOR_HANDLE CreateUavTexture(ID3D12Resource* textureResource);
 
+	//Structured buffer views (particles), from the end of the CBV/SRV/UAV heap. Released views are reused
+	static constexpr int m_cbvSrvUavDescriptorCount = 1000;
+	static constexpr int m_bufferViewOffsetStart = 500;
+	int m_bufferViewOffsetCount = m_bufferViewOffsetStart; // Next never used offset
+	std::vector<int> m_vFreeBufferViewOffsets;
+	// -1 with a warning when every view of the range is in use
+	int AllocateBufferViewOffset();
+
 	//Dsv Manager
 	int m_dsvOffsetCount = 0;
 	std::list<GC_DESCRIPTOR_RESOURCE*> m_lDepthStencilView;
@@ -3,6 +3,8 @@
 GCShader::GCShader()
 	: m_pRootSignature(nullptr),
 
+	m_shaderId(s_shaderCount++),
+
 	m_pPsoAlpha(nullptr),
 	m_pPsoNoAlpha(nullptr),
 
@@ -22,7 +24,8 @@ GCShader::GCShader()
 	m_rootParameter_ConstantBuffer_2(-1),
 	m_rootParameter_ConstantBuffer_3(-1),
 	m_rootParameter_DescriptorTable_1(-1),
-	m_rootParameter_DescriptorTable_2(-1)
+	m_rootParameter_DescriptorTable_2(-1),
+	m_rootParameter_ShaderResourceView_5(-1)
 
 {
 	m_psCsoPath.clear();
@@ -74,28 +77,8 @@ void GCShader::CompileShader()
 	m_pVsByteCode = LoadShaderFromFile(m_vsCsoPath);
 	m_pPsByteCode = LoadShaderFromFile(m_psCsoPath);
 
-	m_InputLayout.clear();
-
-	UINT offset = 0; 
-	if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_POSITION)) {
-		m_InputLayout.push_back({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offset, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
-		offset += sizeof(DirectX::XMFLOAT3); 
-	}
-
-	if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_COLOR)) {
-		m_InputLayout.push_back({ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, offset, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
-		offset += sizeof(DirectX::XMFLOAT4); 
-	}
-
-	if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_UV)) {
-		m_InputLayout.push_back({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offset, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
-		offset += sizeof(DirectX::XMFLOAT2); // Taille des coordonnées de texture
-	}
-
-	if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_NORMAL)) {
-		m_InputLayout.push_back({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offset, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
-		offset += sizeof(DirectX::XMFLOAT3); // Taille des coordonnées de texture
-	}
+	// Same layout as the mesh vertices (GCMesh packs them with GCVertexLayout too)
+	GCVertexLayout::FillInputLayout(m_flagEnabledBits, m_InputLayout);
 }
 
 
@@ -121,6 +104,10 @@ void GCShader::RootSign()
 		m_rootParameter_ConstantBuffer_3 = numParameters;
 		slotRootParameter[numParameters++].InitAsConstantBufferView(3);
 	}
+	if (GC_HAS_FLAG(m_flagRootParameters, GC_ROOT_PARAMETER_SRV_SLOT5)) {
+		m_rootParameter_ShaderResourceView_5 = numParameters;
+		slotRootParameter[numParameters++].InitAsShaderResourceView(4);
+	}
 
 	CD3DX12_STATIC_SAMPLER_DESC staticSample = CD3DX12_STATIC_SAMPLER_DESC(
 		0, // shaderRegister
@@ -371,8 +358,13 @@ void GCShader::PreCompile(const std::string& filePath, const std::string& csoDes
 	std::wstring wideFilePath(filePath.begin(), filePath.end());
 	std::wstring wideCsoDestinationPath(csoDestinationPath.begin(), csoDestinationPath.end());
 
-	ID3DBlob* vsByteCode = CompileShaderBase(wideFilePath, nullptr, "VS", "vs_5_0");
-	ID3DBlob* psByteCode = CompileShaderBase(wideFilePath, nullptr, "PS", "ps_5_0");
+	// Octahedral normals are float2 inputs, the shader picks its decoding variant (GC_VERTEX_NORMAL_TYPE in Utils.hlsl)
+	D3D_SHADER_MACRO defines[2] = { { nullptr, nullptr }, { nullptr, nullptr } };
+	if (GC_HAS_FLAG(m_flagEnabledBits, GC_VERTEX_NORMAL_OCT))
+		defines[0] = { "GC_NORMAL_OCT", "1" };
+
+	ID3DBlob* vsByteCode = CompileShaderBase(wideFilePath, defines, "VS", "vs_5_0");
+	ID3DBlob* psByteCode = CompileShaderBase(wideFilePath, defines, "PS", "ps_5_0");
 
 	SaveShaderToFile(vsByteCode, wideCsoDestinationPath + L"VS.cso");
 	SaveShaderToFile(psByteCode, wideCsoDestinationPath + L"PS.cso");
@@ -424,7 +416,7 @@ void GCShader::SetRenderTargetFormats(DXGI_FORMAT format, int i)
 
 
 GCComputeShader::GCComputeShader()
-	: m_RootSignature(nullptr), m_PSO(nullptr), m_csByteCode(nullptr), m_pRender(nullptr), m_flagEnabledBits(0), m_cullMode(D3D12_CULL_MODE_NONE)
+	: m_RootSignature(nullptr), m_PSO(nullptr), m_csByteCode(nullptr), m_pRender(nullptr), m_flagEnabledBits(0), m_cullMode(D3D12_CULL_MODE_NONE), m_rootConstantCount(0)
 {
 	m_InputLayout.clear();
 	m_csCsoPath.clear();
@@ -433,13 +425,14 @@ GCComputeShader::GCComputeShader()
 
 GCComputeShader::~GCComputeShader()
 {
-	m_RootSignature->Release();
-	m_PSO->Release();
-	m_csByteCode->Release();
+	// Null when Load failed
+	if (m_RootSignature) m_RootSignature->Release();
+	if (m_PSO) m_PSO->Release();
+	if (m_csByteCode) m_csByteCode->Release();
 	m_InputLayout.clear();
 }
 
-GC_GRAPHICS_ERROR GCComputeShader::Initialize(GCRenderContext* pRender, const std::string& filePath, const std::string& csoDestinationPath, int& flagEnabledBits, D3D12_CULL_MODE cullMode)
+GC_GRAPHICS_ERROR GCComputeShader::Initialize(GCRenderContext* pRender, const std::string& filePath, const std::string& csoDestinationPath, int& flagEnabledBits, D3D12_CULL_MODE cullMode, int rootConstantCount)
 {
 	if (!pRender) return GCRENDER_ERROR_POINTER_NULL;
 
@@ -455,6 +448,7 @@ GC_GRAPHICS_ERROR GCComputeShader::Initialize(GCRenderContext* pRender, const st
 	m_cullMode = cullMode;
 	m_pRender = pRender;
 	m_flagEnabledBits = flagEnabledBits;
+	m_rootConstantCount = rootConstantCount;
 
 	PreCompile(filePath, csoDestinationPath);
 
@@ -481,12 +475,16 @@ void GCComputeShader::RootSign()
 	uavTable.Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0); // OutputImage
 
 	// Define root parameters
-	CD3DX12_ROOT_PARAMETER slotRootParameter[2]; // Only 2 parameters: SRV and UAV
+	CD3DX12_ROOT_PARAMETER slotRootParameter[3]; // SRV and UAV, root constants when asked
 	slotRootParameter[0].InitAsDescriptorTable(1, &srvTable); // SRV for OriginalImage
 	slotRootParameter[1].InitAsDescriptorTable(1, &uavTable); // UAV for OutputImage
 
+	UINT numParameters = 2;
+	if (m_rootConstantCount > 0)
+		slotRootParameter[numParameters++].InitAsConstants(m_rootConstantCount, 0); // b0
+
 	// Create a root signature descriptor
-	CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(2, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+	CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(numParameters, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
 
 	// Serialize the root signature
 	ID3DBlob* serializedRootSig = nullptr;
@@ -23,6 +23,8 @@ public:
 
 	int GetFlagEnabledBits() const { return m_flagEnabledBits; }
 	int GetFlagRootParameters() const { return m_flagRootParameters; }
+	// Unique per shader, used to group draws by pipeline
+	int GetShaderId() const { return m_shaderId; }
 	
 
 	ID3DBlob* CompileShaderBase(const std::wstring& filename, const D3D_SHADER_MACRO* defines, const std::string& entrypoint, const std::string& target);
@@ -51,6 +53,7 @@ public:
 	int m_rootParameter_DescriptorTable_2;
 	int m_rootParameter_DescriptorTable_3;
 	int m_rootParameter_DescriptorTable_4;
+	int m_rootParameter_ShaderResourceView_5;
 
 private:
 	// Initialize var
@@ -73,6 +76,9 @@ private:
 	int m_flagEnabledBits;
 	int m_flagRootParameters;
 
+	int m_shaderId;
+	inline static int s_shaderCount = 0;
+
 	//Pso 
 	DXGI_FORMAT m_rtvFormats[8]; 
 };
@@ -83,7 +89,8 @@ public:
 	GCComputeShader();
 	~GCComputeShader();
 
-	GC_GRAPHICS_ERROR Initialize(GCRenderContext* pRender, const std::string& filePath, const std::string& csoDestinationPath, int& flagEnabledBits, D3D12_CULL_MODE cullMode = D3D12_CULL_MODE_BACK);
+	// rootConstantCount 32 bits values are bound at b0 (root parameter 2), after the SRV (t0) and UAV (u0) tables
+	GC_GRAPHICS_ERROR Initialize(GCRenderContext* pRender, const std::string& filePath, const std::string& csoDestinationPath, int& flagEnabledBits, D3D12_CULL_MODE cullMode = D3D12_CULL_MODE_BACK, int rootConstantCount = 0);
 	void CompileShader();
 	void RootSign();
 	void Pso();
@@ -107,4 +114,5 @@ private:
 	GCRenderContext* m_pRender;
 	int m_flagEnabledBits;
 	D3D12_CULL_MODE m_cullMode;
+	int m_rootConstantCount;
 };
@@ -41,6 +41,19 @@ struct GCLIGHT
     float padding3[2];    
 };
 
+// Particle instance, element of the structured buffer read by particle.hlsl (t1) and particleSimulation.hlsl
+// Must match struct Particle in both shaders
+struct GCPARTICLE
+{
+    DirectX::XMFLOAT3 position;
+    float size;
+    DirectX::XMFLOAT4 color;
+    DirectX::XMFLOAT3 velocity;
+    float age;
+    float lifetime;
+    float padding[3];
+};
+
 //struct GCLIGHTSPROPERTIES : GCSHADERCB
 //{
 //    GCLIGHT lights[10]; 
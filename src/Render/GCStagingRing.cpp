@@ -0,0 +1,226 @@
+#include "pch.h"
+
+GCStagingRing::GCStagingRing()
+    : m_pDevice(nullptr),
+    m_pDirectQueue(nullptr),
+    m_pCopyQueue(nullptr),
+    m_pCopyAllocator(nullptr),
+    m_pCopyCommandList(nullptr),
+    m_isCommandListOpen(false),
+    m_pCopyFence(nullptr),
+    m_copyFenceValue(0),
+    m_fenceEvent(nullptr),
+    m_pUploadBuffer(nullptr),
+    m_pMappedData(nullptr)
+{
+}
+
+GCStagingRing::~GCStagingRing()
+{
+    Release();
+}
+
+bool GCStagingRing::Initialize(ID3D12Device* pDevice, ID3D12CommandQueue* pDirectQueue, UINT64 capacity)
+{
+    Release();
+
+    if (GC_CHECK_POINTERSNULL("Staging ring device and queue are valid", "Can't create staging ring, device or queue is null", pDevice, pDirectQueue) == false)
+        return false;
+
+    m_pDevice = pDevice;
+    m_pDirectQueue = pDirectQueue;
+
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+    HRESULT hr = m_pDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_pCopyQueue));
+    if (GC_CHECK_HRESULT(hr, "Copy queue creation") == false)
+        return false;
+    hr = m_pDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&m_pCopyAllocator));
+    if (GC_CHECK_HRESULT(hr, "Copy command allocator creation") == false)
+        return false;
+    hr = m_pDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, m_pCopyAllocator, nullptr, IID_PPV_ARGS(&m_pCopyCommandList));
+    if (GC_CHECK_HRESULT(hr, "Copy command list creation") == false)
+        return false;
+    m_pCopyCommandList->Close();
+
+    hr = m_pDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_pCopyFence));
+    if (GC_CHECK_HRESULT(hr, "Copy fence creation") == false)
+        return false;
+    m_fenceEvent = CreateEventEx(nullptr, NULL, false, EVENT_ALL_ACCESS);
+
+    CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+    hr = m_pDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&m_pUploadBuffer));
+    if (GC_CHECK_HRESULT(hr, "Staging ring buffer creation") == false)
+        return false;
+    m_pUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&m_pMappedData));
+
+    m_allocator.Initialize(capacity);
+
+    return true;
+}
+
+void GCStagingRing::Release()
+{
+    // Recorded copies not submitted are dropped, the submitted ones are waited for
+    if (m_isCommandListOpen)
+    {
+        m_pCopyCommandList->Close();
+        m_isCommandListOpen = false;
+    }
+    for (ID3D12Resource* pDestination : m_vOpenDestinations)
+        pDestination->Release();
+    m_vOpenDestinations.clear();
+
+    if (m_pCopyFence)
+        WaitForFence(m_copyFenceValue);
+    for (std::pair<UINT64, ID3D12Resource*>& pending : m_pendingDestinations)
+        pending.second->Release();
+    m_pendingDestinations.clear();
+
+    if (m_pUploadBuffer)
+    {
+        m_pUploadBuffer->Unmap(0, nullptr);
+        m_pUploadBuffer->Release();
+        m_pUploadBuffer = nullptr;
+    }
+    m_pMappedData = nullptr;
+
+    if (m_fenceEvent)
+    {
+        CloseHandle(m_fenceEvent);
+        m_fenceEvent = nullptr;
+    }
+
+    ID3D12Object* objects[] = { m_pCopyFence, m_pCopyCommandList, m_pCopyAllocator, m_pCopyQueue };
+    for (ID3D12Object* pObject : objects)
+    {
+        if (pObject)
+            pObject->Release();
+    }
+    m_pCopyFence = nullptr;
+    m_pCopyCommandList = nullptr;
+    m_pCopyAllocator = nullptr;
+    m_pCopyQueue = nullptr;
+
+    m_copyFenceValue = 0;
+    m_allocator.Initialize(0);
+    m_pDevice = nullptr;
+    m_pDirectQueue = nullptr;
+}
+
+BYTE* GCStagingRing::StageBufferCopy(ID3D12Resource* pDestination, UINT64 destinationOffset, UINT64 size)
+{
+    if (m_pUploadBuffer == nullptr || pDestination == nullptr || size > m_allocator.GetCapacity())
+        return nullptr;
+
+    RetireCompleted();
+
+    UINT64 offset = m_allocator.Allocate(size, m_copyAlignment);
+    if (offset == GCStagingRingAllocator::m_invalidOffset)
+    {
+        // Full : everything staged so far is submitted and waited for
+        if (WaitIdle() == false)
+            return nullptr;
+        offset = m_allocator.Allocate(size, m_copyAlignment);
+        if (offset == GCStagingRingAllocator::m_invalidOffset)
+            return nullptr;
+    }
+
+    if (m_isCommandListOpen == false && OpenCommandList() == false)
+        return nullptr;
+
+    // DEFAULT heap buffers are promoted to COPY_DEST by the copy queue and decay back to COMMON, then are
+    // promoted again to their read state by the direct queue : no barrier needed
+    m_pCopyCommandList->CopyBufferRegion(pDestination, destinationOffset, m_pUploadBuffer, offset, size);
+
+    pDestination->AddRef();
+    m_vOpenDestinations.push_back(pDestination);
+
+    return m_pMappedData + offset;
+}
+
+bool GCStagingRing::OpenCommandList()
+{
+    // The allocator is reused once its last submission is done, already the case after a frame flush
+    if (WaitForFence(m_copyFenceValue) == false)
+        return false;
+
+    HRESULT hr = m_pCopyAllocator->Reset();
+    if (GC_CHECK_HRESULT(hr, "Copy command allocator reset") == false)
+        return false;
+    hr = m_pCopyCommandList->Reset(m_pCopyAllocator, nullptr);
+    if (GC_CHECK_HRESULT(hr, "Copy command list reset") == false)
+        return false;
+
+    m_isCommandListOpen = true;
+    return true;
+}
+
+bool GCStagingRing::Flush()
+{
+    GC_PROFILE_FUNCTION();
+    if (m_isCommandListOpen == false)
+        return true;
+
+    m_isCommandListOpen = false;
+    HRESULT hr = m_pCopyCommandList->Close();
+    if (GC_CHECK_HRESULT(hr, "Copy command list close") == false)
+        return false;
+
+    ID3D12CommandList* cmdsLists[] = { m_pCopyCommandList };
+    m_pCopyQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+
+    m_copyFenceValue++;
+    hr = m_pCopyQueue->Signal(m_pCopyFence, m_copyFenceValue);
+    if (GC_CHECK_HRESULT(hr, "Copy queue signal") == false)
+        return false;
+
+    // GPU side wait : the next direct queue submissions start once the copies are done
+    hr = m_pDirectQueue->Wait(m_pCopyFence, m_copyFenceValue);
+    if (GC_CHECK_HRESULT(hr, "Direct queue wait on copy fence") == false)
+        return false;
+
+    m_allocator.Close(m_copyFenceValue);
+    for (ID3D12Resource* pDestination : m_vOpenDestinations)
+        m_pendingDestinations.push_back({ m_copyFenceValue, pDestination });
+    m_vOpenDestinations.clear();
+
+    return true;
+}
+
+bool GCStagingRing::WaitIdle()
+{
+    if (Flush() == false || WaitForFence(m_copyFenceValue) == false)
+        return false;
+
+    RetireCompleted();
+    return true;
+}
+
+void GCStagingRing::RetireCompleted()
+{
+    UINT64 completedValue = m_pCopyFence->GetCompletedValue();
+
+    m_allocator.Retire(completedValue);
+    while (m_pendingDestinations.empty() == false && m_pendingDestinations.front().first <= completedValue)
+    {
+        m_pendingDestinations.front().second->Release();
+        m_pendingDestinations.pop_front();
+    }
+}
+
+bool GCStagingRing::WaitForFence(UINT64 fenceValue)
+{
+    if (m_pCopyFence->GetCompletedValue() >= fenceValue)
+        return true;
+
+    HRESULT hr = m_pCopyFence->SetEventOnCompletion(fenceValue, m_fenceEvent);
+    if (GC_CHECK_HRESULT(hr, "Copy fence SetEventOnCompletion") == false)
+        return false;
+
+    WaitForSingleObject(m_fenceEvent, INFINITE);
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// Shared upload buffer static resources are filled through : data is written in the ring and copied to
+// the DEFAULT heap destination by a copy queue. Flush submits the copies and makes the direct queue wait
+// for them, the copies of a frame are done before its draws.
+// Destinations are referenced until their copy is done, they can be released by their owner at any time
+class GCStagingRing
+{
+public:
+	static constexpr UINT64 m_defaultCapacity = 16 * 1024 * 1024;
+
+	GCStagingRing();
+	~GCStagingRing();
+
+	bool Initialize(ID3D12Device* pDevice, ID3D12CommandQueue* pDirectQueue, UINT64 capacity = m_defaultCapacity);
+	void Release();
+
+	// Mapped ring memory of size bytes copied to pDestination at destinationOffset by the next Flush.
+	// Write only (write combined memory). Waits for the copy queue when the ring is full,
+	// nullptr when size doesn't fit in the ring at all
+	BYTE* StageBufferCopy(ID3D12Resource* pDestination, UINT64 destinationOffset, UINT64 size);
+
+	// Submits the recorded copies, the direct queue waits for them. Nothing is done without copies
+	bool Flush();
+	// Flush and CPU wait for every copy
+	bool WaitIdle();
+
+	inline UINT64 GetCapacity() const { return m_allocator.GetCapacity(); }
+	inline UINT64 GetUsedBytes() const { return m_allocator.GetUsedBytes(); }
+
+private:
+	bool OpenCommandList();
+	void RetireCompleted();
+	bool WaitForFence(UINT64 fenceValue);
+
+	ID3D12Device* m_pDevice;
+	ID3D12CommandQueue* m_pDirectQueue;
+
+	ID3D12CommandQueue* m_pCopyQueue;
+	ID3D12CommandAllocator* m_pCopyAllocator;
+	ID3D12GraphicsCommandList* m_pCopyCommandList;
+	bool m_isCommandListOpen;
+
+	ID3D12Fence* m_pCopyFence;
+	UINT64 m_copyFenceValue; // Last signaled
+	HANDLE m_fenceEvent;
+
+	ID3D12Resource* m_pUploadBuffer;
+	BYTE* m_pMappedData;
+	GCStagingRingAllocator m_allocator;
+
+	// Destinations referenced by the copies, released with their fence value
+	std::vector<ID3D12Resource*> m_vOpenDestinations;
+	std::deque<std::pair<UINT64, ID3D12Resource*>> m_pendingDestinations;
+
+	static constexpr UINT64 m_copyAlignment = 16;
+};
@@ -0,0 +1,86 @@
+#include "pch.h"
+
+GCStagingRingAllocator::GCStagingRingAllocator()
+    : m_capacity(0),
+    m_head(0),
+    m_tail(0),
+    m_usedBytes(0),
+    m_openBytes(0)
+{
+}
+
+void GCStagingRingAllocator::Initialize(UINT64 capacity)
+{
+    m_capacity = capacity;
+    m_head = 0;
+    m_tail = 0;
+    m_usedBytes = 0;
+    m_openBytes = 0;
+    m_pendingBatches.clear();
+}
+
+UINT64 GCStagingRingAllocator::Allocate(UINT64 size, UINT64 alignment)
+{
+    if (size == 0 || size > m_capacity || m_usedBytes == m_capacity)
+        return m_invalidOffset;
+
+    // Empty : restart at the beginning, the whole ring is free in one piece
+    if (m_usedBytes == 0)
+    {
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    UINT64 alignedHead = (m_head + alignment - 1) & ~(alignment - 1);
+    UINT64 offset = m_invalidOffset;
+    UINT64 consumedBytes = 0;
+
+    if (m_head >= m_tail)
+    {
+        // Free space : [head, capacity) then [0, tail)
+        if (alignedHead + size <= m_capacity)
+        {
+            offset = alignedHead;
+            consumedBytes = alignedHead - m_head + size;
+        }
+        else if (size <= m_tail)
+        {
+            offset = 0;
+            consumedBytes = m_capacity - m_head + size;
+        }
+    }
+    else if (alignedHead + size <= m_tail)
+    {
+        // Free space : [head, tail)
+        offset = alignedHead;
+        consumedBytes = alignedHead - m_head + size;
+    }
+
+    if (offset == m_invalidOffset)
+        return m_invalidOffset;
+
+    m_head = offset + size;
+    m_usedBytes += consumedBytes;
+    m_openBytes += consumedBytes;
+
+    return offset;
+}
+
+void GCStagingRingAllocator::Close(UINT64 fenceValue)
+{
+    if (m_openBytes == 0)
+        return;
+
+    m_pendingBatches.push_back({ fenceValue, m_head, m_openBytes });
+    m_openBytes = 0;
+}
+
+void GCStagingRingAllocator::Retire(UINT64 completedFenceValue)
+{
+    while (m_pendingBatches.empty() == false && m_pendingBatches.front().fenceValue <= completedFenceValue)
+    {
+        m_tail = m_pendingBatches.front().endOffset;
+        m_usedBytes -= m_pendingBatches.front().byteCount;
+        m_pendingBatches.pop_front();
+    }
+}
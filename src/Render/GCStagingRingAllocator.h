@@ -0,0 +1,41 @@
+#pragma once
+
+// Offsets of a ring buffer freed in submission order, once the fence value of their batch is reached.
+// Pure bookkeeping : no device object, GCStagingRing maps it on its upload buffer
+class GCStagingRingAllocator
+{
+public:
+	static constexpr UINT64 m_invalidOffset = UINT64_MAX;
+
+	GCStagingRingAllocator();
+
+	void Initialize(UINT64 capacity);
+
+	// Offset of size bytes aligned on alignment (power of 2), m_invalidOffset when the free space is too small.
+	// Never splits an allocation : the end of the ring is skipped (and counted as used) when it doesn't fit
+	UINT64 Allocate(UINT64 size, UINT64 alignment);
+	// Allocations since the last Close are freed by the first Retire reaching fenceValue
+	void Close(UINT64 fenceValue);
+	void Retire(UINT64 completedFenceValue);
+
+	inline UINT64 GetCapacity() const { return m_capacity; }
+	inline UINT64 GetUsedBytes() const { return m_usedBytes; }
+	inline UINT64 GetOpenBytes() const { return m_openBytes; }
+	inline bool HasPendingBatches() const { return m_pendingBatches.empty() == false; }
+
+private:
+	struct GC_STAGING_BATCH
+	{
+		UINT64 fenceValue;
+		UINT64 endOffset; // Head when the batch was closed, the tail once it is retired
+		UINT64 byteCount; // Alignment and skipped ring end included
+	};
+
+	UINT64 m_capacity;
+	UINT64 m_head; // Next allocation
+	UINT64 m_tail; // Oldest allocation still in use
+	UINT64 m_usedBytes;
+	UINT64 m_openBytes; // Part of m_usedBytes not closed yet
+
+	std::deque<GC_STAGING_BATCH> m_pendingBatches;
+};
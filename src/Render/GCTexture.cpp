@@ -20,12 +20,14 @@ GCTexture::~GCTexture()
 
 GC_GRAPHICS_ERROR GCTexture::Initialize(const std::string& filePath, GCGraphics* pGraphics, int& textureOffset)
 {
+    GC_PROFILE_FUNCTION();
     //Initializes textures
     std::wstring wideFilePath(filePath.begin(), filePath.end());
 
     if (GC_CHECK_POINTERSNULL("Graphics ptr is not null", "Graphic pointer is null", pGraphics) == false) return GCRENDER_ERROR_TEXTURE_CREATION_FAILED;
     if (GC_CHECK_FILE(filePath, "Texture not found: " + filePath, "Texture file : " + filePath + " loaded successfully") == false) return GCRENDER_ERROR_TEXTURE_CREATION_FAILED;
 
+    m_textureId = textureOffset;
     m_cbvSrvUavDescriptorSize = pGraphics->GetRender()->GetRenderResources()->Getmd3dDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     DirectX::CreateDDSTextureFromFile12(pGraphics->GetRender()->GetRenderResources()->Getmd3dDevice(), pGraphics->GetRender()->GetRenderResources()->GetCommandList(), wideFilePath.c_str(), &m_pTextureBuffer, &m_pUploadTexture, m_width, m_height);
@@ -15,6 +15,8 @@ public:
     inline UINT GetMipLevels() const { return m_mipLevels; }
     inline int GetWidth() const { return m_width; }
     inline int GetHeight() const { return m_height; }
+    // Descriptor slot of the texture, unique among living textures
+    inline int GetTextureId() const { return m_textureId; }
 
 private:
     UINT m_cbvSrvUavDescriptorSize;
@@ -25,4 +27,5 @@ private:
 
     int m_height = 0;
     int m_width = 0;
+    int m_textureId = 0;
 };
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "pch.h"
+
+// Texels are read as 32 bits, the readback only supports 4 bytes formats (back buffer / pixel id)
+static constexpr UINT READBACK_BYTES_PER_TEXEL = 4;
+
+GCTextureReadback::GCTextureReadback()
+    : m_pTexture(nullptr),
+    m_width(0),
+    m_height(0),
+    m_format(DXGI_FORMAT_UNKNOWN),
+    m_region(),
+    m_nextSlot(0),
+    m_recordedSlot(-1),
+    m_resultSlot(-1)
+{
+}
+
+GCTextureReadback::~GCTextureReadback()
+{
+    Release();
+}
+
+bool GCTextureReadback::Initialize(ID3D12Device* pDevice, ID3D12Resource* pTexture, int depth)
+{
+    Release();
+
+    if (GC_CHECK_POINTERSNULL("Readback texture is valid", "Can't create readback, texture is null", pDevice, pTexture) == false)
+        return false;
+
+    D3D12_RESOURCE_DESC textureDesc = pTexture->GetDesc();
+    m_pTexture = pTexture;
+    m_width = static_cast<UINT>(textureDesc.Width);
+    m_height = textureDesc.Height;
+    m_format = textureDesc.Format;
+
+    // Sized for the whole texture, any region fits
+    UINT64 totalBytes = 0;
+    pDevice->GetCopyableFootprints(&textureDesc, 0, 1, 0, nullptr, nullptr, nullptr, &totalBytes);
+
+    CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_READBACK);
+    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(totalBytes);
+
+    m_vSlots.resize(std::max(depth, 2));
+    for (GC_READBACK_SLOT& slot : m_vSlots)
+    {
+        HRESULT hr = pDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&slot.pBuffer));
+        if (GC_CHECK_HRESULT(hr, "Readback buffer creation") == false)
+        {
+            Release();
+            return false;
+        }
+
+        slot.pBuffer->Map(0, nullptr, reinterpret_cast<void**>(&slot.pData));
+    }
+
+    SetFullRegion();
+
+    return true;
+}
+
+void GCTextureReadback::Release()
+{
+    for (GC_READBACK_SLOT& slot : m_vSlots)
+    {
+        if (slot.pBuffer)
+        {
+            slot.pBuffer->Unmap(0, nullptr);
+            slot.pBuffer->Release();
+        }
+    }
+    m_vSlots.clear();
+
+    m_pTexture = nullptr;
+    m_nextSlot = 0;
+    m_recordedSlot = -1;
+    m_resultSlot = -1;
+}
+
+void GCTextureReadback::SetRegion(int x, int y, int width, int height)
+{
+    int left = std::clamp(x, 0, static_cast<int>(m_width));
+    int top = std::clamp(y, 0, static_cast<int>(m_height));
+    int right = std::clamp(x + width, left, static_cast<int>(m_width));
+    int bottom = std::clamp(y + height, top, static_cast<int>(m_height));
+
+    m_region.left = left;
+    m_region.top = top;
+    m_region.right = right;
+    m_region.bottom = bottom;
+    m_region.front = 0;
+    m_region.back = 1;
+}
+
+void GCTextureReadback::SetFullRegion()
+{
+    SetRegion(0, 0, static_cast<int>(m_width), static_cast<int>(m_height));
+}
+
+bool GCTextureReadback::RecordCopy(ID3D12GraphicsCommandList* pCommandList, D3D12_RESOURCE_STATES textureState, UINT64 frameIndex)
+{
+    if (m_pTexture == nullptr || m_recordedSlot >= 0)
+        return false;
+    if (m_region.right == m_region.left || m_region.bottom == m_region.top)
+        return false;
+
+    // Free slot : not in flight and not holding the result being read
+    int slotCount = static_cast<int>(m_vSlots.size());
+    int slotIndex = -1;
+    for (int i = 0; i < slotCount; i++)
+    {
+        int candidate = (m_nextSlot + i) % slotCount;
+        if (m_vSlots[candidate].isPending == false && candidate != m_resultSlot)
+        {
+            slotIndex = candidate;
+            break;
+        }
+    }
+
+    // Every slot still used, drop this frame's copy rather than wait
+    if (slotIndex < 0)
+        return false;
+
+    GC_READBACK_SLOT& slot = m_vSlots[slotIndex];
+
+    UINT regionWidth = m_region.right - m_region.left;
+    UINT rowPitch = (regionWidth * READBACK_BYTES_PER_TEXEL + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+    footprint.Offset = 0;
+    footprint.Footprint.Format = m_format;
+    footprint.Footprint.Width = regionWidth;
+    footprint.Footprint.Height = m_region.bottom - m_region.top;
+    footprint.Footprint.Depth = 1;
+    footprint.Footprint.RowPitch = rowPitch;
+
+    CD3DX12_TEXTURE_COPY_LOCATION destination(slot.pBuffer, footprint);
+    CD3DX12_TEXTURE_COPY_LOCATION source(m_pTexture, 0);
+
+    CD3DX12_RESOURCE_BARRIER toCopySource = CD3DX12_RESOURCE_BARRIER::Transition(m_pTexture, textureState, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    pCommandList->ResourceBarrier(1, &toCopySource);
+
+    pCommandList->CopyTextureRegion(&destination, 0, 0, 0, &source, &m_region);
+
+    CD3DX12_RESOURCE_BARRIER toTextureState = CD3DX12_RESOURCE_BARRIER::Transition(m_pTexture, D3D12_RESOURCE_STATE_COPY_SOURCE, textureState);
+    pCommandList->ResourceBarrier(1, &toTextureState);
+
+    slot.box = m_region;
+    slot.rowPitch = rowPitch;
+    slot.frameIndex = frameIndex;
+
+    m_recordedSlot = slotIndex;
+    m_nextSlot = (slotIndex + 1) % slotCount;
+
+    return true;
+}
+
+void GCTextureReadback::OnSubmitted(UINT64 fenceValue)
+{
+    if (m_recordedSlot < 0)
+        return;
+
+    GC_READBACK_SLOT& slot = m_vSlots[m_recordedSlot];
+    slot.fenceValue = fenceValue;
+    slot.isPending = true;
+
+    m_recordedSlot = -1;
+}
+
+void GCTextureReadback::Update(ID3D12Fence* pFence)
+{
+    UINT64 completedValue = pFence->GetCompletedValue();
+
+    for (int i = 0; i < static_cast<int>(m_vSlots.size()); i++)
+    {
+        GC_READBACK_SLOT& slot = m_vSlots[i];
+        if (slot.isPending == false || slot.fenceValue > completedValue)
+            continue;
+
+        slot.isPending = false;
+        if (m_resultSlot < 0 || slot.frameIndex > m_vSlots[m_resultSlot].frameIndex)
+            m_resultSlot = i;
+    }
+}
+
+bool GCTextureReadback::ReadTexel(int x, int y, uint32_t& outTexel) const
+{
+    if (m_resultSlot < 0)
+        return false;
+
+    const GC_READBACK_SLOT& slot = m_vSlots[m_resultSlot];
+    if (x < static_cast<int>(slot.box.left) || x >= static_cast<int>(slot.box.right) || y < static_cast<int>(slot.box.top) || y >= static_cast<int>(slot.box.bottom))
+        return false;
+
+    size_t offset = static_cast<size_t>(y - slot.box.top) * slot.rowPitch + static_cast<size_t>(x - slot.box.left) * READBACK_BYTES_PER_TEXEL;
+    memcpy(&outTexel, slot.pData + offset, sizeof(uint32_t));
+
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+struct GC_READBACK_SLOT
+{
+	ID3D12Resource* pBuffer = nullptr;
+	BYTE* pData = nullptr; // Persistently mapped
+
+	UINT64 fenceValue = 0;
+	bool isPending = false;
+
+	// Copied texels and their layout in pBuffer
+	D3D12_BOX box = {};
+	UINT rowPitch = 0;
+	UINT64 frameIndex = 0;
+};
+
+// Ring of readback buffers a texture (or a rect of it) is copied into at the end of a frame.
+// A copy is read once its fence is reached, one or more frames later : nothing ever waits on the
+// GPU, a copy is skipped when every slot is still in flight.
+class GCTextureReadback
+{
+public:
+	GCTextureReadback();
+	~GCTextureReadback();
+
+	bool Initialize(ID3D12Device* pDevice, ID3D12Resource* pTexture, int depth = 3);
+	void Release();
+
+	// Texels copied from now on, clamped to the texture
+	void SetRegion(int x, int y, int width, int height);
+	void SetFullRegion();
+
+	// Records the copy of the current region, pTexture is in textureState before and after
+	bool RecordCopy(ID3D12GraphicsCommandList* pCommandList, D3D12_RESOURCE_STATES textureState, UINT64 frameIndex);
+	// Fence value signaled after the command list of the last RecordCopy
+	void OnSubmitted(UINT64 fenceValue);
+
+	// Picks the latest finished copy as result, never waits
+	void Update(ID3D12Fence* pFence);
+
+	// Texel of the result, false if no result yet or outside of the copied region
+	bool ReadTexel(int x, int y, uint32_t& outTexel) const;
+
+	inline bool HasResult() const { return m_resultSlot >= 0; }
+	inline UINT64 GetResultFrame() const { return m_vSlots[m_resultSlot].frameIndex; }
+	inline bool HasPendingCopy() const { return m_recordedSlot >= 0; }
+
+private:
+	ID3D12Resource* m_pTexture;
+	UINT m_width;
+	UINT m_height;
+	DXGI_FORMAT m_format;
+
+	D3D12_BOX m_region;
+
+	std::vector<GC_READBACK_SLOT> m_vSlots;
+	int m_nextSlot;
+	int m_recordedSlot; // Recorded, waiting for OnSubmitted
+	int m_resultSlot;
+};
@@ -0,0 +1,142 @@
+#include "pch.h"
+
+GCThreadPool::GCThreadPool()
+    : m_pTask(nullptr),
+    m_taskCount(0),
+    m_nextTask(0),
+    m_completedTasks(0),
+    m_jobGeneration(0),
+    m_activeWorkers(0),
+    m_stop(false)
+{
+}
+
+GCThreadPool::~GCThreadPool()
+{
+    Release();
+}
+
+void GCThreadPool::Initialize(int workerCount)
+{
+    Release();
+
+    if (workerCount <= 0)
+    {
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    m_stop = false;
+    m_vWorkers.reserve(workerCount);
+    for (int i = 0; i < workerCount; i++)
+        m_vWorkers.emplace_back(&GCThreadPool::WorkerLoop, this, i + 1);
+}
+
+void GCThreadPool::Release()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (std::thread& worker : m_vWorkers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_vWorkers.clear();
+}
+
+void GCThreadPool::ParallelFor(int taskCount, const std::function<void(int, int)>& task)
+{
+    if (taskCount <= 0)
+        return;
+
+    // Nothing to share, avoid waking the workers
+    if (taskCount == 1 || m_vWorkers.empty())
+    {
+        for (int i = 0; i < taskCount; i++)
+            task(i, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pTask = &task;
+        m_taskCount = taskCount;
+        m_nextTask = 0;
+        m_completedTasks = 0;
+        m_activeWorkers = static_cast<int>(m_vWorkers.size());
+        m_jobGeneration++;
+    }
+    m_wakeCondition.notify_all();
+
+    RunTasks(0);
+
+    // Wait every task and every worker out of the job, m_pTask points to the caller's function
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_completedTasks.load() == m_taskCount && m_activeWorkers == 0; });
+    m_pTask = nullptr;
+}
+
+void GCThreadPool::Partition(int count, int taskCount, std::vector<std::pair<int, int>>& outRanges)
+{
+    outRanges.clear();
+    if (count <= 0 || taskCount <= 0)
+        return;
+
+    if (taskCount > count)
+        taskCount = count;
+
+    int base = count / taskCount;
+    int remainder = count % taskCount;
+
+    int begin = 0;
+    for (int i = 0; i < taskCount; i++)
+    {
+        int size = base + (i < remainder ? 1 : 0);
+        outRanges.emplace_back(begin, begin + size);
+        begin += size;
+    }
+}
+
+void GCThreadPool::WorkerLoop(int threadIndex)
+{
+    GC_PROFILE_THREAD_NAME("Worker " + std::to_string(threadIndex));
+    UINT64 lastGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] { return m_stop || m_jobGeneration != lastGeneration; });
+
+            if (m_stop)
+                return;
+
+            lastGeneration = m_jobGeneration;
+        }
+
+        RunTasks(threadIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkers--;
+        }
+        m_doneCondition.notify_one();
+    }
+}
+
+void GCThreadPool::RunTasks(int threadIndex)
+{
+    while (true)
+    {
+        int taskIndex = m_nextTask.fetch_add(1);
+        if (taskIndex >= m_taskCount)
+            break;
+
+        (*m_pTask)(taskIndex, threadIndex);
+        m_completedTasks.fetch_add(1);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// Persistent worker threads used to split frame work (command recording, culling, simulation).
+// ParallelFor blocks until every task is done, the calling thread executes tasks too.
+class GCThreadPool
+{
+public:
+	GCThreadPool();
+	~GCThreadPool();
+
+	// workerCount = 0 -> hardware threads - 1
+	void Initialize(int workerCount = 0);
+	void Release();
+
+	// Calls task(taskIndex, threadIndex) for taskIndex in [0, taskCount), threadIndex 0 is the caller
+	void ParallelFor(int taskCount, const std::function<void(int, int)>& task);
+
+	// Splits [0, count) in taskCount ranges of nearly equal size, in order
+	static void Partition(int count, int taskCount, std::vector<std::pair<int, int>>& outRanges);
+
+	inline int GetThreadCount() const { return static_cast<int>(m_vWorkers.size()) + 1; }
+
+private:
+	void WorkerLoop(int threadIndex);
+	void RunTasks(int threadIndex);
+
+	std::vector<std::thread> m_vWorkers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wakeCondition;
+	std::condition_variable m_doneCondition;
+
+	// Current job
+	const std::function<void(int, int)>* m_pTask;
+	int m_taskCount;
+	std::atomic<int> m_nextTask;
+	std::atomic<int> m_completedTasks;
+
+	UINT64 m_jobGeneration;
+	int m_activeWorkers;
+	bool m_stop;
+};
@@ -0,0 +1,239 @@
+#include "pch.h"
+
+GCTilemap::GCTilemap()
+    : m_pGraphics(nullptr),
+    m_pMaterial(nullptr),
+    m_width(0),
+    m_height(0),
+    m_tileSize(0.0f),
+    m_atlasColumns(1),
+    m_atlasRows(1),
+    m_chunkColumns(0),
+    m_chunkRows(0)
+{
+    DirectX::XMStoreFloat4x4(&m_world, DirectX::XMMatrixIdentity());
+}
+
+GCTilemap::~GCTilemap()
+{
+    Release();
+}
+
+bool GCTilemap::Initialize(GCGraphics* pGraphics, GCMaterial* pAtlasMaterial, int width, int height, float tileSize, int atlasColumns, int atlasRows)
+{
+    Release();
+
+    if (GC_CHECK_POINTERSNULL("Tilemap graphics and atlas material are valid", "Can't create tilemap, graphics or atlas material is null", pGraphics, pAtlasMaterial) == false)
+        return false;
+    if (width <= 0 || height <= 0 || atlasColumns <= 0 || atlasRows <= 0)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Can't create tilemap, empty grid or atlas");
+        return false;
+    }
+    // Draw divides by the chunk size in world units, NaN fails the test too
+    if ((tileSize > 0.0f) == false)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Can't create tilemap, tile size must be positive");
+        return false;
+    }
+
+    m_pGraphics = pGraphics;
+    m_pMaterial = pAtlasMaterial;
+    m_width = width;
+    m_height = height;
+    m_tileSize = tileSize;
+    m_atlasColumns = atlasColumns;
+    m_atlasRows = atlasRows;
+
+    m_vTiles.assign(static_cast<size_t>(width) * height, -1);
+
+    m_chunkColumns = (width + m_chunkSize - 1) / m_chunkSize;
+    m_chunkRows = (height + m_chunkSize - 1) / m_chunkSize;
+    m_vChunks.resize(static_cast<size_t>(m_chunkColumns) * m_chunkRows);
+
+    return true;
+}
+
+void GCTilemap::Release()
+{
+    for (GC_TILEMAP_CHUNK& chunk : m_vChunks)
+    {
+        if (chunk.pMesh)
+            m_pGraphics->RemoveMesh(chunk.pMesh);
+        GC_DELETE(chunk.pGeometry);
+    }
+    m_vChunks.clear();
+    m_vTiles.clear();
+
+    m_width = 0;
+    m_height = 0;
+    m_chunkColumns = 0;
+    m_chunkRows = 0;
+}
+
+void GCTilemap::SetTile(int x, int y, int tile)
+{
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+        return;
+    if (IsValidTile(tile) == false)
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Tilemap SetTile ignored, tile is out of the 16 bits range");
+        return;
+    }
+
+    int16_t& current = m_vTiles[static_cast<size_t>(y) * m_width + x];
+    if (current == tile)
+        return;
+
+    current = static_cast<int16_t>(tile);
+    m_vChunks[GetChunkIndex(x, y)].isDirty = true;
+}
+
+int GCTilemap::GetTile(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+        return -1;
+
+    return m_vTiles[static_cast<size_t>(y) * m_width + x];
+}
+
+void GCTilemap::SetTiles(const std::vector<int>& tiles)
+{
+    if (tiles.size() != m_vTiles.size())
+    {
+        GCGraphicsLogger::GetInstance().LogWarning("Tilemap SetTiles ignored, tile count doesn't match the grid");
+        return;
+    }
+    for (int tile : tiles)
+    {
+        if (IsValidTile(tile) == false)
+        {
+            GCGraphicsLogger::GetInstance().LogWarning("Tilemap SetTiles ignored, a tile is out of the 16 bits range");
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < tiles.size(); i++)
+        m_vTiles[i] = static_cast<int16_t>(tiles[i]);
+
+    for (GC_TILEMAP_CHUNK& chunk : m_vChunks)
+        chunk.isDirty = true;
+}
+
+void GCTilemap::SetPosition(float x, float y)
+{
+    DirectX::XMStoreFloat4x4(&m_world, DirectX::XMMatrixTranslation(x, y, 0.0f));
+}
+
+int GCTilemap::Draw(float viewX, float viewY, float viewWidth, float viewHeight)
+{
+    if (m_vChunks.empty())
+        return 0;
+
+    // Chunk range overlapping the view, clamped to the grid
+    float chunkWorldSize = m_tileSize * m_chunkSize;
+    int firstChunkX = std::max(static_cast<int>(std::floor(viewX / chunkWorldSize)), 0);
+    int firstChunkY = std::max(static_cast<int>(std::floor(viewY / chunkWorldSize)), 0);
+    int lastChunkX = std::min(static_cast<int>(std::floor((viewX + viewWidth) / chunkWorldSize)), m_chunkColumns - 1);
+    int lastChunkY = std::min(static_cast<int>(std::floor((viewY + viewHeight) / chunkWorldSize)), m_chunkRows - 1);
+
+    DirectX::XMMATRIX worldMatrix = DirectX::XMLoadFloat4x4(&m_world);
+
+    int drawCount = 0;
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; chunkY++)
+    {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; chunkX++)
+        {
+            GC_TILEMAP_CHUNK& chunk = m_vChunks[chunkY * m_chunkColumns + chunkX];
+            if (chunk.isDirty)
+                BuildChunk(chunkX, chunkY);
+
+            if (chunk.tileCount == 0)
+                continue;
+
+            m_pGraphics->UpdateWorldConstantBuffer(m_pMaterial, worldMatrix);
+            if (m_pGraphics->GetRender()->DrawObject(chunk.pMesh, m_pMaterial, true, 0.0f, &m_world))
+                drawCount++;
+        }
+    }
+
+    return drawCount;
+}
+
+void GCTilemap::BuildChunk(int chunkX, int chunkY)
+{
+    GC_TILEMAP_CHUNK& chunk = m_vChunks[chunkY * m_chunkColumns + chunkX];
+    chunk.isDirty = false;
+
+    if (chunk.pGeometry == nullptr)
+        chunk.pGeometry = new GCGeometry();
+
+    GCGeometry* pGeometry = chunk.pGeometry;
+    pGeometry->pos.clear();
+    pGeometry->uv.clear();
+    pGeometry->indices.clear();
+
+    int firstX = chunkX * m_chunkSize;
+    int firstY = chunkY * m_chunkSize;
+    int lastX = std::min(firstX + m_chunkSize, m_width);
+    int lastY = std::min(firstY + m_chunkSize, m_height);
+
+    float cellU = 1.0f / m_atlasColumns;
+    float cellV = 1.0f / m_atlasRows;
+    int atlasCellCount = m_atlasColumns * m_atlasRows;
+
+    // Same quad as the plane primitive : top left origin, clockwise, uv (0, 0) top left
+    for (int y = firstY; y < lastY; y++)
+    {
+        for (int x = firstX; x < lastX; x++)
+        {
+            int tile = m_vTiles[static_cast<size_t>(y) * m_width + x];
+            if (tile < 0 || tile >= atlasCellCount)
+                continue;
+
+            float left = x * m_tileSize;
+            float top = -y * m_tileSize;
+            float u = (tile % m_atlasColumns) * cellU;
+            float v = (tile / m_atlasColumns) * cellV;
+
+            // 32x32 tiles, 4096 vertices at most : 16 bits indices are enough
+            std::uint16_t baseIndex = static_cast<std::uint16_t>(pGeometry->pos.size());
+
+            pGeometry->pos.push_back(DirectX::XMFLOAT3(left, top, 0.0f));
+            pGeometry->pos.push_back(DirectX::XMFLOAT3(left + m_tileSize, top, 0.0f));
+            pGeometry->pos.push_back(DirectX::XMFLOAT3(left + m_tileSize, top - m_tileSize, 0.0f));
+            pGeometry->pos.push_back(DirectX::XMFLOAT3(left, top - m_tileSize, 0.0f));
+
+            pGeometry->uv.push_back(DirectX::XMFLOAT2(u, v));
+            pGeometry->uv.push_back(DirectX::XMFLOAT2(u + cellU, v));
+            pGeometry->uv.push_back(DirectX::XMFLOAT2(u + cellU, v + cellV));
+            pGeometry->uv.push_back(DirectX::XMFLOAT2(u, v + cellV));
+
+            const std::uint16_t quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+            for (std::uint16_t index : quadIndices)
+                pGeometry->indices.push_back(baseIndex + index);
+        }
+    }
+
+    chunk.tileCount = static_cast<int>(pGeometry->pos.size() / 4);
+    pGeometry->vertexNumber = pGeometry->pos.size();
+    pGeometry->indiceNumber = pGeometry->indices.size();
+
+    // Emptied chunk keeps its last buffers, it isn't drawn anymore
+    if (chunk.tileCount == 0)
+        return;
+
+    pGeometry->ComputeBounds();
+
+    if (chunk.pMesh == nullptr)
+    {
+        GC_RESOURCE_CREATION_RESULT<GCMesh*> meshResult = m_pGraphics->CreateMeshTexture(pGeometry, GC_MESH_STORAGE_EDITABLE);
+        chunk.pMesh = meshResult.success ? meshResult.resource : nullptr;
+        if (chunk.pMesh == nullptr)
+            chunk.tileCount = 0;
+    }
+    else
+    {
+        chunk.pMesh->UpdateGeometryData();
+    }
+}
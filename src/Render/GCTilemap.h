@@ -0,0 +1,70 @@
+#pragma once
+
+// Chunk of GCTilemap, its tiles are merged in a single mesh
+struct GC_TILEMAP_CHUNK
+{
+	GCGeometry* pGeometry = nullptr;
+	GCMesh* pMesh = nullptr; // Created on the first build with tiles
+
+	int tileCount = 0; // Tiles in the last build, nothing is drawn when 0
+	bool isDirty = true; // Edited since the last build
+};
+
+// Grid of tiles drawn from an atlas texture split in equal cells. Tiles are grouped by chunks of
+// m_chunkSize x m_chunkSize, each one is a single mesh and a single draw. A chunk is built only when
+// it is drawn and was edited since its last build : a large map costs the few chunks on screen.
+// Tile (0, 0) is the top left one, rows go down (-y) like the 2D screen space.
+class GCTilemap
+{
+public:
+	GCTilemap();
+	~GCTilemap();
+
+	// pAtlasMaterial is a texture material, its texture holds atlasColumns x atlasRows tiles
+	bool Initialize(GCGraphics* pGraphics, GCMaterial* pAtlasMaterial, int width, int height, float tileSize, int atlasColumns, int atlasRows);
+	// Chunk meshes are removed from pGraphics, release the tilemap before it
+	void Release();
+
+	// Atlas cell index, row major, -1 for an empty tile. Tiles are stored on 16 bits : ids outside
+	// [-1, 32767] are rejected with a warning
+	void SetTile(int x, int y, int tile);
+	int GetTile(int x, int y) const;
+	// Whole grid at once, width x height tiles row major. Nothing is set if a tile is out of range
+	void SetTiles(const std::vector<int>& tiles);
+
+	// World position of the top left corner of tile (0, 0)
+	void SetPosition(float x, float y);
+
+	// Draws the chunks overlapping the rect, in tilemap local units (x right, y down from tile (0, 0)).
+	// Returns the number of draws submitted
+	int Draw(float viewX, float viewY, float viewWidth, float viewHeight);
+
+	inline int GetWidth() const { return m_width; }
+	inline int GetHeight() const { return m_height; }
+	inline float GetTileSize() const { return m_tileSize; }
+	inline int GetChunkCount() const { return static_cast<int>(m_vChunks.size()); }
+
+	static constexpr int m_chunkSize = 32;
+
+private:
+	void BuildChunk(int chunkX, int chunkY);
+	inline int GetChunkIndex(int x, int y) const { return (y / m_chunkSize) * m_chunkColumns + x / m_chunkSize; }
+	static inline bool IsValidTile(int tile) { return tile >= -1 && tile <= INT16_MAX; }
+
+	GCGraphics* m_pGraphics;
+	GCMaterial* m_pMaterial;
+
+	int m_width;
+	int m_height;
+	float m_tileSize;
+	int m_atlasColumns;
+	int m_atlasRows;
+
+	std::vector<int16_t> m_vTiles;
+
+	int m_chunkColumns;
+	int m_chunkRows;
+	std::vector<GC_TILEMAP_CHUNK> m_vChunks;
+
+	DirectX::XMFLOAT4X4 m_world;
+};
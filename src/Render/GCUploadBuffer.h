@@ -4,21 +4,46 @@
 class GCShaderUploadBufferBase
 {
 public:
-    GCShaderUploadBufferBase() : m_pUpload(nullptr), m_data(nullptr), m_elementByteSize(0), m_isConstantBuffer(false), m_isUsed(false), m_framesSinceLastUse(0) {}
+    GCShaderUploadBufferBase() : m_pUpload(nullptr), m_data(nullptr), m_elementByteSize(0), m_isConstantBuffer(false), m_pAllocator(nullptr), m_isUsed(false), m_framesSinceLastUse(0) {}
     virtual ~GCShaderUploadBufferBase()
     {
-        if (m_pUpload)
+        // Sub-allocated : the page buffer stays mapped
+        if (m_pAllocator)
+        {
+            m_pAllocator->Free(m_allocation);
+        }
+        else if (m_pUpload)
         {
             m_pUpload->Unmap(0, nullptr);
         }
         m_data = nullptr;
     }
 
+    // Shared with other buffers when sub-allocated, use GetGPUVirtualAddress to bind this one
     ID3D12Resource* Resource() const
     {
         return m_pUpload;
     }
 
+    D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const
+    {
+        return m_pAllocator ? m_allocation.GetGpuAddress() : m_pUpload->GetGPUVirtualAddress();
+    }
+
+    // Bytes of one element, 256 B aligned for a constant buffer
+    UINT GetElementByteSize() const
+    {
+        return m_elementByteSize;
+    }
+
+    // Memory held by the buffer : its block when sub-allocated
+    UINT64 GetAllocatedSize() const
+    {
+        if (m_pAllocator)
+            return m_allocation.size;
+        return m_pUpload ? m_pUpload->GetDesc().Width : 0;
+    }
+
     virtual void CopyData(int elementIndex, const GCSHADERCB& data) = 0;
 
     bool m_isUsed;
@@ -30,6 +55,9 @@ protected:
     UINT m_elementByteSize;
     bool m_isConstantBuffer;
 
+    GCGpuMemoryAllocator* m_pAllocator;
+    GC_GPU_ALLOCATION m_allocation;
+
     UINT CalcConstantBufferByteSize(UINT byteSize)
     {
         return (byteSize + 255) & ~255;
@@ -40,6 +68,20 @@ template<typename T>
 class GCShaderUploadBuffer : public GCShaderUploadBufferBase 
 {
 public:
+    // Range of a shared upload page instead of a 64KB committed resource
+    GCShaderUploadBuffer(GCGpuMemoryAllocator* pAllocator, UINT elementCount, bool isConstantBuffer)
+    {
+        m_isConstantBuffer = isConstantBuffer;
+        m_elementByteSize = isConstantBuffer ? CalcConstantBufferByteSize(sizeof(T)) : sizeof(T);
+
+        if (pAllocator->AllocateBuffer(GC_GPU_POOL_UPLOAD_BUFFER, m_elementByteSize * elementCount, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, m_allocation))
+        {
+            m_pAllocator = pAllocator;
+            m_pUpload = m_allocation.pResource;
+            m_data = m_allocation.pMappedData;
+        }
+    }
+
     GCShaderUploadBuffer(ID3D12Device* device, UINT elementCount, bool isConstantBuffer) 
     {
         m_isConstantBuffer = isConstantBuffer;
@@ -88,8 +130,19 @@ public:
         return m_pUpload;
     }
 
+    D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const
+    {
+        return m_pUpload->GetGPUVirtualAddress();
+    }
+
     virtual void CopyData(int elementIndex, const void* data, size_t dataSize) = 0;
 
+    // Persistently mapped memory, for writers filling the buffer in place (no intermediate copy)
+    BYTE* GetMappedData() const
+    {
+        return m_data;
+    }
+
     bool m_isUsed;
     int m_framesSinceLastUse;
 
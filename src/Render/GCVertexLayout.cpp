@@ -0,0 +1,115 @@
+#include "pch.h"
+
+static_assert(GCVertexLayout::m_streamFlags == 0x0F, "Pack table is indexed by the 4 low flag bits");
+static_assert(GCVertexLayout::Make(GC_VERTEX_POSITION | GC_VERTEX_COLOR).stride == 28, "Color vertex layout changed");
+static_assert(GCVertexLayout::Make(GC_VERTEX_POSITION | GC_VERTEX_UV).GetOffset(GC_VERTEX_UV) == 12, "Texture vertex layout changed");
+static_assert(GCVertexLayout::Make(GCVertexLayout::m_streamFlags).stride == 48, "Full vertex layout changed");
+static_assert(GCVertexLayout::Make(GCVertexLayout::m_streamFlags | GCVertexLayout::m_compressedFlags).stride == 20, "Compressed vertex layout changed");
+
+template<int Flags>
+void GCVertexLayout::PackFlags(const GCGeometry& geometry, const DirectX::XMFLOAT3& positionOffset, BYTE* pDestination)
+{
+    using namespace DirectX::PackedVector;
+
+    constexpr GC_VERTEX_LAYOUT layout = Make(Flags);
+    constexpr UINT positionByteOffset = layout.GetOffset(GC_VERTEX_POSITION);
+    constexpr UINT colorByteOffset = layout.GetOffset(GC_VERTEX_COLOR);
+    constexpr UINT uvByteOffset = layout.GetOffset(GC_VERTEX_UV);
+    constexpr UINT normalByteOffset = layout.GetOffset(GC_VERTEX_NORMAL);
+
+    const DirectX::XMFLOAT3* pPositions = geometry.pos.data();
+    const DirectX::XMFLOAT4* pColors = geometry.color.data();
+    const DirectX::XMFLOAT2* pUvs = geometry.uv.data();
+    const DirectX::XMFLOAT3* pNormals = geometry.normals.data();
+
+    size_t vertexCount = geometry.pos.size();
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        BYTE* pVertex = pDestination + i * layout.stride;
+
+        if constexpr ((Flags & GC_VERTEX_POSITION) != 0)
+        {
+            DirectX::XMFLOAT3 position(pPositions[i].x + positionOffset.x, pPositions[i].y + positionOffset.y, pPositions[i].z + positionOffset.z);
+            if constexpr ((Flags & GC_VERTEX_POSITION_HALF) != 0)
+            {
+                XMHALF4 packed(position.x, position.y, position.z, 1.0f);
+                memcpy(pVertex + positionByteOffset, &packed, sizeof(packed));
+            }
+            else
+                memcpy(pVertex + positionByteOffset, &position, sizeof(position));
+        }
+        if constexpr ((Flags & GC_VERTEX_COLOR) != 0)
+        {
+            if constexpr ((Flags & GC_VERTEX_COLOR_RGBA8) != 0)
+            {
+                XMUBYTEN4 packed;
+                XMStoreUByteN4(&packed, DirectX::XMLoadFloat4(&pColors[i]));
+                memcpy(pVertex + colorByteOffset, &packed, sizeof(packed));
+            }
+            else
+                memcpy(pVertex + colorByteOffset, &pColors[i], sizeof(DirectX::XMFLOAT4));
+        }
+        if constexpr ((Flags & GC_VERTEX_UV) != 0)
+        {
+            if constexpr ((Flags & GC_VERTEX_UV_HALF) != 0)
+            {
+                XMHALF2 packed(pUvs[i].x, pUvs[i].y);
+                memcpy(pVertex + uvByteOffset, &packed, sizeof(packed));
+            }
+            else
+                memcpy(pVertex + uvByteOffset, &pUvs[i], sizeof(DirectX::XMFLOAT2));
+        }
+        if constexpr ((Flags & GC_VERTEX_NORMAL) != 0)
+        {
+            if constexpr ((Flags & GC_VERTEX_NORMAL_OCT) != 0)
+            {
+                DirectX::XMFLOAT2 encoded = EncodeOctahedralNormal(pNormals[i]);
+                XMSHORTN2 packed;
+                XMStoreShortN2(&packed, DirectX::XMLoadFloat2(&encoded));
+                memcpy(pVertex + normalByteOffset, &packed, sizeof(packed));
+            }
+            else
+                memcpy(pVertex + normalByteOffset, &pNormals[i], sizeof(DirectX::XMFLOAT3));
+        }
+    }
+}
+
+void GCVertexLayout::Pack(int flagEnabledBits, const GCGeometry& geometry, const DirectX::XMFLOAT3& positionOffset, BYTE* pDestination)
+{
+    static constexpr std::array<PackFunction, m_packTableSize> packTable = MakePackTable(std::make_integer_sequence<int, m_packTableSize>());
+
+    packTable[GetPackIndex(flagEnabledBits)](geometry, positionOffset, pDestination);
+}
+
+void GCVertexLayout::FillInputLayout(int flagEnabledBits, std::vector<D3D12_INPUT_ELEMENT_DESC>& outInputLayout)
+{
+    GC_VERTEX_LAYOUT layout = Make(flagEnabledBits);
+
+    outInputLayout.clear();
+    for (int i = 0; i < layout.elementCount; i++)
+    {
+        const GC_VERTEX_ELEMENT& element = layout.elements[i];
+        outInputLayout.push_back({ element.semanticName, 0, element.format, 0, element.offset, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
+    }
+}
+
+DirectX::XMFLOAT2 GCVertexLayout::EncodeOctahedralNormal(const DirectX::XMFLOAT3& normal)
+{
+    float length = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (length == 0.0f)
+        return DirectX::XMFLOAT2(0.0f, 0.0f);
+
+    float x = normal.x / length;
+    float y = normal.y / length;
+
+    // Lower hemisphere folded over the diagonals
+    if (normal.z < 0.0f)
+    {
+        float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    return DirectX::XMFLOAT2(x, y);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// Attribute of the interleaved vertex stream
+struct GC_VERTEX_ELEMENT
+{
+	int flag = 0; // GC_VERTEX_*
+	const char* semanticName = nullptr;
+	DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+	UINT byteSize = 0;
+	UINT offset = 0; // In the vertex, set by GCVertexLayout::Make
+};
+
+// Interleaved vertex of a GC_VERTEX_* flag combination
+struct GC_VERTEX_LAYOUT
+{
+	static constexpr int m_maxElements = 4;
+
+	GC_VERTEX_ELEMENT elements[m_maxElements] = {};
+	int elementCount = 0;
+	UINT stride = 0;
+
+	constexpr UINT GetOffset(int flag) const
+	{
+		for (int i = 0; i < elementCount; i++)
+		{
+			if (elements[i].flag == flag)
+				return elements[i].offset;
+		}
+		return 0;
+	}
+};
+
+// Single description of the mesh vertex stream : GCMesh packs its vertices with it and GCShader builds its
+// input layout from it, both sides always agree on the offsets and formats.
+// Stream order : position, color, uv, normal. Tangent and binormal flags aren't part of the stream.
+// Compressed flags change the format of their attribute : a full vertex goes from 48 to 20 bytes
+class GCVertexLayout
+{
+public:
+	static constexpr int m_streamFlags = GC_VERTEX_POSITION | GC_VERTEX_COLOR | GC_VERTEX_UV | GC_VERTEX_NORMAL;
+	static constexpr int m_compressedFlags = GC_VERTEX_COLOR_RGBA8 | GC_VERTEX_UV_HALF | GC_VERTEX_NORMAL_OCT | GC_VERTEX_POSITION_HALF;
+
+	static constexpr GC_VERTEX_LAYOUT Make(int flagEnabledBits)
+	{
+		const bool isPositionHalf = (flagEnabledBits & GC_VERTEX_POSITION_HALF) != 0;
+		const bool isColorRgba8 = (flagEnabledBits & GC_VERTEX_COLOR_RGBA8) != 0;
+		const bool isUvHalf = (flagEnabledBits & GC_VERTEX_UV_HALF) != 0;
+		const bool isNormalOct = (flagEnabledBits & GC_VERTEX_NORMAL_OCT) != 0;
+
+		const GC_VERTEX_ELEMENT streamElements[GC_VERTEX_LAYOUT::m_maxElements] = {
+			isPositionHalf
+				? GC_VERTEX_ELEMENT{ GC_VERTEX_POSITION, "POSITION", DXGI_FORMAT_R16G16B16A16_FLOAT, 8, 0 }
+				: GC_VERTEX_ELEMENT{ GC_VERTEX_POSITION, "POSITION", DXGI_FORMAT_R32G32B32_FLOAT, sizeof(DirectX::XMFLOAT3), 0 },
+			isColorRgba8
+				? GC_VERTEX_ELEMENT{ GC_VERTEX_COLOR, "COLOR", DXGI_FORMAT_R8G8B8A8_UNORM, 4, 0 }
+				: GC_VERTEX_ELEMENT{ GC_VERTEX_COLOR, "COLOR", DXGI_FORMAT_R32G32B32A32_FLOAT, sizeof(DirectX::XMFLOAT4), 0 },
+			isUvHalf
+				? GC_VERTEX_ELEMENT{ GC_VERTEX_UV, "TEXCOORD", DXGI_FORMAT_R16G16_FLOAT, 4, 0 }
+				: GC_VERTEX_ELEMENT{ GC_VERTEX_UV, "TEXCOORD", DXGI_FORMAT_R32G32_FLOAT, sizeof(DirectX::XMFLOAT2), 0 },
+			isNormalOct
+				? GC_VERTEX_ELEMENT{ GC_VERTEX_NORMAL, "NORMAL", DXGI_FORMAT_R16G16_SNORM, 4, 0 }
+				: GC_VERTEX_ELEMENT{ GC_VERTEX_NORMAL, "NORMAL", DXGI_FORMAT_R32G32B32_FLOAT, sizeof(DirectX::XMFLOAT3), 0 },
+		};
+
+		GC_VERTEX_LAYOUT layout;
+		for (const GC_VERTEX_ELEMENT& element : streamElements)
+		{
+			if ((flagEnabledBits & element.flag) == 0)
+				continue;
+
+			GC_VERTEX_ELEMENT& placed = layout.elements[layout.elementCount++];
+			placed = element;
+			placed.offset = layout.stride;
+			layout.stride += element.byteSize;
+		}
+
+		return layout;
+	}
+
+	// Writes every vertex of geometry, positionOffset added to the positions, at pDestination (Make(flagEnabledBits).stride
+	// bytes per vertex). pDestination can be mapped upload memory : it is only written, in order
+	static void Pack(int flagEnabledBits, const GCGeometry& geometry, const DirectX::XMFLOAT3& positionOffset, BYTE* pDestination);
+
+	static void FillInputLayout(int flagEnabledBits, std::vector<D3D12_INPUT_ELEMENT_DESC>& outInputLayout);
+
+	// Unit normal to the octahedron map, in [-1, 1]. Decoded by DecodeOctahedralNormal (Utils.hlsl)
+	static DirectX::XMFLOAT2 EncodeOctahedralNormal(const DirectX::XMFLOAT3& normal);
+
+private:
+	using PackFunction = void(*)(const GCGeometry&, const DirectX::XMFLOAT3&, BYTE*);
+
+	// Stream and compressed flags folded on 8 bits, compressed flags are 2 bits above their place in the index
+	static constexpr int m_packTableSize = 256;
+	static constexpr int GetPackIndex(int flagEnabledBits) { return (flagEnabledBits & m_streamFlags) | ((flagEnabledBits & m_compressedFlags) >> 2); }
+	static constexpr int GetPackFlags(int packIndex) { return (packIndex & m_streamFlags) | ((packIndex << 2) & m_compressedFlags); }
+
+	// One instance per flag combination, the attribute and format tests are resolved at compile time
+	template<int Flags>
+	static void PackFlags(const GCGeometry& geometry, const DirectX::XMFLOAT3& positionOffset, BYTE* pDestination);
+
+	// PackFlags of every combination, indexed by GetPackIndex
+	template<int... PackIndices>
+	static constexpr std::array<PackFunction, sizeof...(PackIndices)> MakePackTable(std::integer_sequence<int, PackIndices...>)
+	{
+		return { &PackFlags<GetPackFlags(PackIndices)>... };
+	}
+};
@@ -154,6 +154,11 @@ bool CheckPointersNull(const char* successMsg, const char* warningMsg, Args... a
 #define GC_VERTEX_NORMAL                           0x08 // 00001000
 #define GC_VERTEX_TANGENT                          0x10 // 00010000
 #define GC_VERTEX_BINORMAL                         0x20 // 00100000
+// Compressed formats, set along the attribute they compress (ex : GC_VERTEX_COLOR | GC_VERTEX_COLOR_RGBA8)
+#define GC_VERTEX_COLOR_RGBA8                      0x40 // 01000000 R8G8B8A8_UNORM
+#define GC_VERTEX_UV_HALF                          0x80 // 10000000 R16G16_FLOAT
+#define GC_VERTEX_NORMAL_OCT                      0x100 // 100000000 R16G16_SNORM octahedral, GCShader compiles with GC_NORMAL_OCT to decode it (Utils.hlsl)
+#define GC_VERTEX_POSITION_HALF                   0x200 // 1000000000 R16G16B16A16_FLOAT, w = 1
 
 // Root Parameter Flags
 #define GC_ROOT_PARAMETER_CB0                      0x01 // 00000001
@@ -164,6 +169,7 @@ bool CheckPointersNull(const char* successMsg, const char* warningMsg, Args... a
 #define GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT2   0x20 // 00100000
 #define GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT3   0x40 // 01000000
 #define GC_ROOT_PARAMETER_DESCRIPTOR_TABLE_SLOT4   0x80 // 10000000
+#define GC_ROOT_PARAMETER_SRV_SLOT5                0x100 // 100000000, root SRV t4 (structured buffer)
 
 
 // Lights Type
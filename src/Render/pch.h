@@ -34,6 +34,15 @@
 #include <sstream>
 #include <cassert>
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <deque>
+#include <set>
+#include <iomanip>
 
 
 #include <wrl.h>
@@ -70,6 +79,7 @@ class GCGraphicsLogger;
 enum GC_GRAPHICS_ERROR;
 
 struct GC_DESCRIPTOR_RESOURCE;
+struct GC_DRAW_COMMAND;
 
 struct GCPARTICLE;
 
@@ -80,14 +90,29 @@ class GCModelParserFactory;
 class GCModelParserObj;
 class GCPrimitiveFactory;
 class GCRenderContext;
+class GCRenderQueue;
+class GCDrawRecorder;
+class GCD3D12DrawRecorder;
+class GCParallelDrawRecording;
+class GCCuller;
+class GCTextureReadback;
+class GCGpuTimer;
+class GCTilemap;
 class GCRenderResources;
 class GCShader;
 class GCComputeShader;
 class GCTexture;
 class GCTextureFactory;
+class GCThreadPool;
 class GCShaderUploadBufferBase; 
 class GCUploadBufferBase;
+class GCBuddyAllocator;
+class GCGpuMemoryAllocator;
+class GCMemoryTracker;
+class GCProfiler;
 
+class GCParticleSimulation;
+class GCVertexLayout;
 class GCParticleSystem;
 class GCFontGeometryLoader;
 class GCSpriteSheetGeometryLoader;
@@ -113,10 +138,25 @@ class Window;
 #include "Window.h"
 #include "Macros.h"
 #include "Define.h"
+#include "GCProfiler.h"
+#include "GCMemoryTracker.h"
+#include "GCBuddyAllocator.h"
+#include "GCGpuMemoryAllocator.h"
 #include "GCUploadBuffer.h"
+#include "GCThreadPool.h"
+#include "GCRenderQueue.h"
+#include "GCCuller.h"
+#include "GCTextureReadback.h"
+#include "GCGpuTimestampRing.h"
+#include "GCGpuTimer.h"
+#include "GCStagingRingAllocator.h"
+#include "GCStagingRing.h"
+#include "GCDrawRecorder.h"
+#include "GCD3D12DrawRecorder.h"
 #include "GCRenderContext.h"
 #include "GCRenderResources.h"
 #include "GCGeometry.h"
+#include "GCVertexLayout.h"
 #include "GCMesh.h"
 #include "GCShader.h"
 #include "GCMaterial.h"
@@ -129,6 +169,9 @@ class Window;
 #include "GCTexture.h"
 #include "GCGraphics.h"
 #include "GCTextureFactory.h"
+#include "GCTilemap.h"
+#include "GCParticleSimulation.h"
+#include "GCParticleSystem.h"
 #include "Timer.h"
 
 
@@ -0,0 +1,230 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr UINT64 s_invalid = GCBuddyAllocator::m_invalidOffset;
+
+    struct LIVE_BLOCK
+    {
+        UINT64 offset;
+        UINT64 size; // Requested
+        UINT64 blockSize;
+        uint8_t pattern;
+    };
+
+    UINT64 BlockSizeOf(UINT64 size, UINT64 alignment, UINT64 minBlockSize)
+    {
+        return GCBuddyAllocator::RoundUpPowerOf2(std::max({ size, alignment, minBlockSize }));
+    }
+}
+
+TEST(GCBuddyAllocator, SizesAreRoundedUpToPowersOf2)
+{
+    GCBuddyAllocator allocator;
+    allocator.Initialize(1000, 48);
+
+    EXPECT_EQ(1024u, allocator.GetCapacity());
+
+    // Min block 64
+    UINT64 small = allocator.Allocate(1);
+    UINT64 medium = allocator.Allocate(65);
+    EXPECT_EQ(0u, small);
+    EXPECT_EQ(128u, medium);
+    EXPECT_EQ(64u + 128u, allocator.GetUsedBytes());
+    EXPECT_EQ(66u, allocator.GetRequestedBytes());
+    EXPECT_EQ(2, allocator.GetAllocationCount());
+}
+
+TEST(GCBuddyAllocator, InvalidRequestsFail)
+{
+    GCBuddyAllocator allocator;
+    EXPECT_EQ(s_invalid, allocator.Allocate(16));
+
+    allocator.Initialize(1024, 64);
+    EXPECT_EQ(s_invalid, allocator.Allocate(0));
+    EXPECT_EQ(s_invalid, allocator.Allocate(1025));
+    EXPECT_EQ(s_invalid, allocator.Allocate(16, 2048));
+
+    // Past the largest power of 2, rounding up can't overflow
+    EXPECT_EQ(s_invalid, allocator.Allocate(UINT64_MAX));
+    EXPECT_EQ(s_invalid, allocator.Allocate((1ull << 63) + 1));
+    EXPECT_EQ(s_invalid, allocator.Allocate(16, UINT64_MAX));
+
+    // Unknown offsets and double frees are ignored
+    UINT64 offset = allocator.Allocate(64);
+    allocator.Free(offset + 64);
+    allocator.Free(offset);
+    allocator.Free(offset);
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+    EXPECT_EQ(1024u, allocator.GetLargestFreeBlock());
+}
+
+TEST(GCBuddyAllocator, RoundUpPowerOf2SaturatesAboveTheLargestPowerOf2)
+{
+    EXPECT_EQ(1u, GCBuddyAllocator::RoundUpPowerOf2(0));
+    EXPECT_EQ(1u, GCBuddyAllocator::RoundUpPowerOf2(1));
+    EXPECT_EQ(1024u, GCBuddyAllocator::RoundUpPowerOf2(1000));
+    EXPECT_EQ(1ull << 63, GCBuddyAllocator::RoundUpPowerOf2((1ull << 62) + 1));
+    EXPECT_EQ(1ull << 63, GCBuddyAllocator::RoundUpPowerOf2(1ull << 63));
+    EXPECT_EQ(UINT64_MAX, GCBuddyAllocator::RoundUpPowerOf2((1ull << 63) + 1));
+    EXPECT_EQ(UINT64_MAX, GCBuddyAllocator::RoundUpPowerOf2(UINT64_MAX));
+
+    // Capacity clamped to the largest power of 2
+    GCBuddyAllocator allocator;
+    allocator.Initialize(UINT64_MAX, 1ull << 62);
+    EXPECT_EQ(1ull << 63, allocator.GetCapacity());
+    EXPECT_EQ(0u, allocator.Allocate(1));
+    EXPECT_EQ(1ull << 62, allocator.Allocate(UINT64_MAX >> 2));
+    EXPECT_EQ(s_invalid, allocator.Allocate(UINT64_MAX));
+}
+
+TEST(GCBuddyAllocator, AlignmentAboveTheSizeTakesABiggerBlock)
+{
+    GCBuddyAllocator allocator;
+    allocator.Initialize(1 << 20, 256);
+
+    allocator.Allocate(256);
+    UINT64 aligned = allocator.Allocate(256, 64 * 1024);
+
+    EXPECT_EQ(0u, aligned % (64 * 1024));
+    EXPECT_EQ(256u + 64 * 1024, allocator.GetUsedBytes());
+}
+
+TEST(GCBuddyAllocator, FragmentationOfInterleavedFrees)
+{
+    GCBuddyAllocator allocator;
+    allocator.Initialize(1024, 64);
+
+    std::vector<UINT64> offsets;
+    for (int i = 0; i < 16; i++)
+        offsets.push_back(allocator.Allocate(64));
+    EXPECT_EQ(s_invalid, allocator.Allocate(1));
+    EXPECT_EQ(0.0f, allocator.GetFragmentation()); // Nothing free
+
+    // Every other block : 512 free bytes, none of them can merge
+    for (int i = 0; i < 16; i += 2)
+        allocator.Free(offsets[i]);
+    EXPECT_EQ(512u, allocator.GetFreeBytes());
+    EXPECT_EQ(64u, allocator.GetLargestFreeBlock());
+    EXPECT_FLOAT_EQ(1.0f - 64.0f / 512.0f, allocator.GetFragmentation());
+    EXPECT_EQ(s_invalid, allocator.Allocate(128));
+
+    // The other half merges everything back
+    for (int i = 1; i < 16; i += 2)
+        allocator.Free(offsets[i]);
+    EXPECT_EQ(1024u, allocator.GetLargestFreeBlock());
+    EXPECT_EQ(0.0f, allocator.GetFragmentation());
+    EXPECT_EQ(0u, allocator.Allocate(1024));
+}
+
+// Random allocations and frees over real memory (ASan build) : every block is filled with its own pattern and
+// checked when freed, an overlap or an out of range offset shows up as a broken pattern or an ASan report
+TEST(GCBuddyAllocator, RandomStressKeepsBlocksDisjointAndMergesBack)
+{
+    const UINT64 capacity = 1 << 20;
+    const UINT64 minBlockSize = 256;
+
+    GCBuddyAllocator allocator;
+    allocator.Initialize(capacity, minBlockSize);
+    std::vector<uint8_t> memory(capacity, 0);
+
+    std::mt19937 random(99);
+    std::uniform_int_distribution<int> sizeShifts(0, 17);
+    std::uniform_int_distribution<int> alignmentShifts(0, 14);
+    std::uniform_int_distribution<int> percent(0, 99);
+    const UINT64 oversizedRequests[] = { capacity + 1, (1ull << 63) + 1, UINT64_MAX };
+
+    std::vector<LIVE_BLOCK> live;
+    UINT64 usedBytes = 0;
+    UINT64 requestedBytes = 0;
+    int failedCount = 0;
+    uint8_t nextPattern = 1;
+
+    auto freeBlock = [&](size_t index)
+    {
+        const LIVE_BLOCK& block = live[index];
+        for (UINT64 i = 0; i < block.size; i++)
+            ASSERT_EQ(block.pattern, memory[block.offset + i]) << "block at " << block.offset << " overwritten";
+
+        allocator.Free(block.offset);
+        usedBytes -= block.blockSize;
+        requestedBytes -= block.size;
+        live[index] = live.back();
+        live.pop_back();
+    };
+
+    for (int step = 0; step < 20000; step++)
+    {
+        // Mostly allocating until 3/4 full, mostly freeing above : the allocator runs out of large blocks now and then
+        bool isAllocating = live.empty() || percent(random) < (usedBytes < capacity / 4 * 3 ? 75 : 35);
+        if (isAllocating && percent(random) < 2)
+        {
+            // Too big for the allocator, some above 2^63 : rejected, nothing changes
+            UINT64 oversized = oversizedRequests[random() % 3];
+            bool isAlignment = percent(random) < 50;
+            ASSERT_EQ(s_invalid, isAlignment ? allocator.Allocate(1, oversized) : allocator.Allocate(oversized)) << oversized;
+        }
+        else if (isAllocating)
+        {
+            UINT64 size = 1 + (random() % (1ull << sizeShifts(random)));
+            UINT64 alignment = 1ull << alignmentShifts(random);
+            UINT64 offset = allocator.Allocate(size, alignment);
+            UINT64 blockSize = BlockSizeOf(size, alignment, minBlockSize);
+
+            if (offset == s_invalid)
+            {
+                // Only when no free block is big enough
+                ASSERT_LT(allocator.GetLargestFreeBlock(), blockSize);
+                failedCount++;
+                continue;
+            }
+
+            ASSERT_EQ(0u, offset % alignment);
+            ASSERT_EQ(0u, offset % blockSize); // Blocks are aligned on their size
+            ASSERT_LE(offset + blockSize, capacity);
+
+            LIVE_BLOCK block = { offset, size, blockSize, nextPattern };
+            nextPattern = nextPattern == 255 ? 1 : nextPattern + 1;
+            std::memset(memory.data() + offset, block.pattern, size);
+
+            live.push_back(block);
+            usedBytes += blockSize;
+            requestedBytes += size;
+        }
+        else
+        {
+            freeBlock(random() % live.size());
+            if (HasFatalFailure())
+                return;
+        }
+
+        ASSERT_EQ(usedBytes, allocator.GetUsedBytes());
+        ASSERT_EQ(requestedBytes, allocator.GetRequestedBytes());
+        ASSERT_EQ(static_cast<int>(live.size()), allocator.GetAllocationCount());
+
+        UINT64 largestFreeBlock = allocator.GetLargestFreeBlock();
+        ASSERT_LE(largestFreeBlock, allocator.GetFreeBytes());
+        float fragmentation = allocator.GetFragmentation();
+        ASSERT_GE(fragmentation, 0.0f);
+        ASSERT_LT(fragmentation, 1.0f);
+    }
+
+    EXPECT_GT(failedCount, 0);
+
+    // Freed in random order, the blocks merge back into the whole capacity
+    std::shuffle(live.begin(), live.end(), random);
+    while (live.empty() == false)
+    {
+        freeBlock(live.size() - 1);
+        if (HasFatalFailure())
+            return;
+    }
+
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+    EXPECT_EQ(0u, allocator.GetRequestedBytes());
+    EXPECT_EQ(capacity, allocator.GetLargestFreeBlock());
+    EXPECT_EQ(0.0f, allocator.GetFragmentation());
+    EXPECT_EQ(0u, allocator.Allocate(capacity));
+}
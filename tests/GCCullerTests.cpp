@@ -0,0 +1,244 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+using namespace DirectX;
+
+namespace
+{
+    // Identity view, orthographic box x in [-10, 10], y in [-5, 5], z in [near, 100]
+    constexpr float s_width = 20.0f;
+    constexpr float s_height = 10.0f;
+    constexpr float s_far = 100.0f;
+
+    XMFLOAT4X4 Translation(float x, float y, float z)
+    {
+        XMFLOAT4X4 world;
+        XMStoreFloat4x4(&world, XMMatrixTranslation(x, y, z));
+        return world;
+    }
+
+    XMFLOAT4X4 Identity()
+    {
+        return Translation(0.0f, 0.0f, 0.0f);
+    }
+
+    BoundingBox Box(float x, float y, float z, float extent)
+    {
+        return BoundingBox(XMFLOAT3(x, y, z), XMFLOAT3(extent, extent, extent));
+    }
+
+    // Reference : the box overlaps the orthographic view volume
+    bool OverlapsOrthographic(const BoundingBox& box, float nearZ)
+    {
+        return box.Center.x + box.Extents.x >= -s_width * 0.5f && box.Center.x - box.Extents.x <= s_width * 0.5f
+            && box.Center.y + box.Extents.y >= -s_height * 0.5f && box.Center.y - box.Extents.y <= s_height * 0.5f
+            && box.Center.z + box.Extents.z >= nearZ && box.Center.z - box.Extents.z <= s_far;
+    }
+
+    std::vector<BoundingBox> MakeBoxes(int count)
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> positions(-30.0f, 130.0f);
+        std::uniform_real_distribution<float> extents(0.1f, 3.0f);
+
+        std::vector<BoundingBox> boxes;
+        for (int i = 0; i < count; i++)
+            boxes.push_back(Box(positions(random) * 0.25f - 10.0f, positions(random) * 0.125f - 5.0f, positions(random), extents(random)));
+        return boxes;
+    }
+}
+
+TEST(GCCuller, PlanesOfAnOrthographicCamera)
+{
+    GCCuller culler;
+    culler.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, 1.0f, s_far));
+
+    int inside = culler.Push(Box(0.0f, 0.0f, 50.0f, 1.0f), Identity());
+    int left = culler.Push(Box(-12.0f, 0.0f, 50.0f, 1.0f), Identity());
+    int right = culler.Push(Box(12.0f, 0.0f, 50.0f, 1.0f), Identity());
+    int bottom = culler.Push(Box(0.0f, -7.0f, 50.0f, 1.0f), Identity());
+    int top = culler.Push(Box(0.0f, 7.0f, 50.0f, 1.0f), Identity());
+    int beforeNear = culler.Push(Box(0.0f, 0.0f, -1.0f, 1.0f), Identity());
+    int beyondFar = culler.Push(Box(0.0f, 0.0f, 102.0f, 1.0f), Identity());
+    int acrossRight = culler.Push(Box(10.5f, 0.0f, 50.0f, 1.0f), Identity());
+    int acrossNear = culler.Push(Box(0.0f, 0.0f, 0.5f, 1.0f), Identity());
+
+    culler.Cull(nullptr);
+
+    EXPECT_TRUE(culler.IsVisible(inside));
+    EXPECT_FALSE(culler.IsVisible(left));
+    EXPECT_FALSE(culler.IsVisible(right));
+    EXPECT_FALSE(culler.IsVisible(bottom));
+    EXPECT_FALSE(culler.IsVisible(top));
+    EXPECT_FALSE(culler.IsVisible(beforeNear));
+    EXPECT_FALSE(culler.IsVisible(beyondFar));
+    // Partly inside is visible
+    EXPECT_TRUE(culler.IsVisible(acrossRight));
+    EXPECT_TRUE(culler.IsVisible(acrossNear));
+    EXPECT_EQ(3, culler.GetVisibleCount());
+}
+
+TEST(GCCuller, PlanesOfAPerspectiveCamera)
+{
+    GCCuller culler;
+    // 90 degrees : at depth z the view spans [-z, z] vertically and horizontally
+    culler.SetViewProj(XMMatrixPerspectiveFovLH(3.14159265f * 0.5f, 1.0f, 1.0f, s_far));
+
+    int inside = culler.Push(Box(15.0f, 0.0f, 20.0f, 1.0f), Identity());
+    int outsideSide = culler.Push(Box(25.0f, 0.0f, 20.0f, 1.0f), Identity());
+    int behind = culler.Push(Box(0.0f, 0.0f, -20.0f, 1.0f), Identity());
+    int outsideTop = culler.Push(Box(0.0f, 10.0f, 5.0f, 1.0f), Identity());
+
+    culler.Cull(nullptr);
+
+    EXPECT_TRUE(culler.IsVisible(inside));
+    EXPECT_FALSE(culler.IsVisible(outsideSide));
+    EXPECT_FALSE(culler.IsVisible(behind));
+    EXPECT_FALSE(culler.IsVisible(outsideTop));
+}
+
+TEST(GCCuller, SetCameraTakesTheUploadedMatrices)
+{
+    XMMATRIX view = XMMatrixTranslation(-30.0f, 0.0f, 0.0f);
+    XMMATRIX proj = XMMatrixOrthographicLH(s_width, s_height, 1.0f, s_far);
+
+    GCVIEWPROJCB camera;
+    XMStoreFloat4x4(&camera.view, XMMatrixTranspose(view));
+    XMStoreFloat4x4(&camera.proj, XMMatrixTranspose(proj));
+
+    GCCuller culler;
+    culler.SetCamera(camera);
+
+    int atOrigin = culler.Push(Box(0.0f, 0.0f, 50.0f, 1.0f), Identity());
+    int inView = culler.Push(Box(30.0f, 0.0f, 50.0f, 1.0f), Identity());
+    culler.Cull(nullptr);
+
+    EXPECT_FALSE(culler.IsVisible(atOrigin));
+    EXPECT_TRUE(culler.IsVisible(inView));
+}
+
+TEST(GCCuller, BoundsAreMovedToWorldSpace)
+{
+    GCCuller culler;
+    culler.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, 1.0f, s_far));
+
+    // Same local box, moved out of the view / scaled back into it
+    int moved = culler.Push(Box(0.0f, 0.0f, 50.0f, 1.0f), Translation(20.0f, 0.0f, 0.0f));
+
+    XMFLOAT4X4 scaledWorld;
+    XMStoreFloat4x4(&scaledWorld, XMMatrixMultiply(XMMatrixScaling(10.0f, 1.0f, 1.0f), XMMatrixTranslation(20.0f, 0.0f, 0.0f)));
+    int scaled = culler.Push(Box(0.0f, 0.0f, 50.0f, 1.0f), scaledWorld);
+
+    // Rotated by 90 degrees, the long x extent now spans y
+    XMFLOAT4X4 rotatedWorld;
+    XMStoreFloat4x4(&rotatedWorld, XMMatrixMultiply(XMMatrixRotationZ(3.14159265f * 0.5f), XMMatrixTranslation(0.0f, 12.0f, 0.0f)));
+    int rotated = culler.Push(BoundingBox(XMFLOAT3(0.0f, 0.0f, 50.0f), XMFLOAT3(8.0f, 1.0f, 1.0f)), rotatedWorld);
+
+    culler.Cull(nullptr);
+
+    EXPECT_FALSE(culler.IsVisible(moved));
+    EXPECT_TRUE(culler.IsVisible(scaled));
+    EXPECT_TRUE(culler.IsVisible(rotated));
+}
+
+TEST(GCCuller, TailOfLessThanFourBoundsIsCulledAndPaddingIgnored)
+{
+    // Near behind the origin : the zero padding lanes would be inside the view if they were counted
+    const float nearZ = -10.0f;
+
+    for (int count = 1; count <= 11; count++)
+    {
+        GCCuller culler;
+        culler.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, nearZ, s_far));
+
+        // Alternating visible / culled boxes, the last one of each count in the tail
+        int expectedVisibleCount = 0;
+        std::vector<bool> expected;
+        for (int i = 0; i < count; i++)
+        {
+            bool visible = (i % 2) == (count % 2);
+            culler.Push(Box(visible ? 0.0f : 50.0f, 0.0f, 50.0f, 1.0f), Identity());
+            expected.push_back(visible);
+            expectedVisibleCount += visible ? 1 : 0;
+        }
+
+        culler.Cull(nullptr);
+
+        ASSERT_EQ(count, culler.GetCount());
+        EXPECT_EQ(expectedVisibleCount, culler.GetVisibleCount()) << count << " bounds";
+        for (int i = 0; i < count; i++)
+            EXPECT_EQ(expected[i], culler.IsVisible(i)) << "bound " << i << " of " << count;
+    }
+}
+
+TEST(GCCuller, MatchesTheReferenceOnManyBounds)
+{
+    const float nearZ = 1.0f;
+    std::vector<BoundingBox> boxes = MakeBoxes(1001);
+
+    GCCuller culler;
+    culler.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, nearZ, s_far));
+    for (const BoundingBox& box : boxes)
+        culler.Push(box, Identity());
+
+    culler.Cull(nullptr);
+
+    int expectedVisibleCount = 0;
+    for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+    {
+        bool expected = OverlapsOrthographic(boxes[i], nearZ);
+        expectedVisibleCount += expected ? 1 : 0;
+        ASSERT_EQ(expected, culler.IsVisible(i)) << "bound " << i;
+    }
+    EXPECT_EQ(expectedVisibleCount, culler.GetVisibleCount());
+    // The random boxes hit both sides
+    EXPECT_GT(expectedVisibleCount, 0);
+    EXPECT_LT(expectedVisibleCount, static_cast<int>(boxes.size()));
+}
+
+TEST(GCCuller, ThreadPoolSplitGivesTheSameResult)
+{
+    const float nearZ = 1.0f;
+    // Several tasks, last block partial
+    std::vector<BoundingBox> boxes = MakeBoxes(GCCuller::m_minBoundsPerTask * 4 + 3);
+
+    GCThreadPool pool;
+    pool.Initialize(3);
+
+    GCCuller serial, parallel;
+    serial.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, nearZ, s_far));
+    parallel.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, nearZ, s_far));
+    for (const BoundingBox& box : boxes)
+    {
+        serial.Push(box, Identity());
+        parallel.Push(box, Identity());
+    }
+
+    serial.Cull(nullptr);
+    parallel.Cull(&pool);
+
+    EXPECT_EQ(serial.GetVisibleCount(), parallel.GetVisibleCount());
+    for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+        ASSERT_EQ(serial.IsVisible(i), parallel.IsVisible(i)) << "bound " << i;
+}
+
+TEST(GCCuller, ClearForgetsThePreviousFrame)
+{
+    GCCuller culler;
+    culler.SetViewProj(XMMatrixOrthographicLH(s_width, s_height, 1.0f, s_far));
+
+    for (int i = 0; i < 6; i++)
+        culler.Push(Box(0.0f, 0.0f, 50.0f, 1.0f), Identity());
+    culler.Cull(nullptr);
+    ASSERT_EQ(6, culler.GetVisibleCount());
+
+    culler.Clear();
+    int culled = culler.Push(Box(50.0f, 0.0f, 50.0f, 1.0f), Identity());
+    culler.Cull(nullptr);
+
+    EXPECT_EQ(0, culled);
+    EXPECT_EQ(1, culler.GetCount());
+    EXPECT_EQ(0, culler.GetVisibleCount());
+    EXPECT_FALSE(culler.IsVisible(0));
+}
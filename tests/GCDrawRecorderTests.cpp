@@ -0,0 +1,284 @@
+#include "pch.h"
+#include "MockDrawRecorder.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    ID3D12PipelineState* FakePso(uintptr_t id) { return reinterpret_cast<ID3D12PipelineState*>(id * 0x100); }
+    ID3D12RootSignature* FakeRootSignature(uintptr_t id) { return reinterpret_cast<ID3D12RootSignature*>(id * 0x100); }
+
+    // Textured draw with cb0 (object), cb1 (camera) and cb2 (material), cb3 unused : 9 bindings
+    constexpr int s_bindingsPerDraw = 9;
+
+    GC_DRAW_BINDINGS MakeDraw(int pso, int rootSignature, int mesh, UINT64 objectCb)
+    {
+        GC_DRAW_BINDINGS draw;
+        draw.pPso = FakePso(pso);
+        draw.pRootSignature = FakeRootSignature(rootSignature);
+        draw.vertexBufferView = { 0x10000 + static_cast<UINT64>(mesh) * 0x1000, 1024, 20 };
+        draw.indexBufferView = { 0x90000 + static_cast<UINT64>(mesh) * 0x1000, 12, DXGI_FORMAT_R16_UINT };
+        draw.textureRootIndex = 4;
+        draw.texture.ptr = 0x5000;
+        draw.constantBufferRootIndices[0] = 0;
+        draw.constantBufferRootIndices[1] = 1;
+        draw.constantBufferRootIndices[2] = 2;
+        draw.constantBuffers[0] = objectCb;
+        draw.constantBuffers[1] = 0xC000;
+        draw.constantBuffers[2] = 0xD000;
+        draw.constantBuffers[3] = 0xE000;
+        draw.indexCount = 6;
+        return draw;
+    }
+}
+
+TEST(GCDrawRecorder, IdenticalDrawsOnlyBindOnce)
+{
+    MockDrawRecorder recorder;
+    GC_STATE_CHANGE_STATS stats;
+
+    const int drawCount = 10;
+    for (int i = 0; i < drawCount; i++)
+        recorder.RecordDraw(MakeDraw(1, 1, 1, 0xA000), stats);
+
+    EXPECT_EQ(1, stats.psoChanges);
+    EXPECT_EQ(1, stats.rootSignatureChanges);
+    EXPECT_EQ(s_bindingsPerDraw, stats.issued);
+    EXPECT_EQ((drawCount - 1) * s_bindingsPerDraw, stats.skipped);
+    EXPECT_EQ(drawCount, stats.drawCalls);
+    EXPECT_EQ(static_cast<UINT64>(drawCount * 2), stats.triangles);
+
+    EXPECT_EQ(1, recorder.Count(MockDrawRecorder::PIPELINE_STATE));
+    EXPECT_EQ(1, recorder.Count(MockDrawRecorder::TOPOLOGY));
+    EXPECT_EQ(3, recorder.Count(MockDrawRecorder::CONSTANT_BUFFER_VIEW));
+    EXPECT_EQ(drawCount, recorder.Count(MockDrawRecorder::DRAW));
+    EXPECT_EQ(static_cast<int>(recorder.calls.size()), stats.issued + stats.drawCalls);
+}
+
+TEST(GCDrawRecorder, OnlyChangedBindingsAreIssued)
+{
+    MockDrawRecorder recorder;
+    GC_STATE_CHANGE_STATS stats;
+
+    recorder.RecordDraw(MakeDraw(1, 1, 1, 0xA000), stats);
+    recorder.calls.clear();
+
+    // Other mesh and object cb, same material
+    recorder.RecordDraw(MakeDraw(1, 1, 2, 0xA100), stats);
+
+    EXPECT_EQ(1, recorder.Count(MockDrawRecorder::VERTEX_BUFFER));
+    EXPECT_EQ(1, recorder.Count(MockDrawRecorder::INDEX_BUFFER));
+    ASSERT_EQ(1, recorder.Count(MockDrawRecorder::CONSTANT_BUFFER_VIEW));
+    EXPECT_EQ(0, recorder.Count(MockDrawRecorder::PIPELINE_STATE));
+    EXPECT_EQ(0, recorder.Count(MockDrawRecorder::DESCRIPTOR_TABLE));
+
+    const MockDrawRecorder::CALL& cbCall = *std::find_if(recorder.calls.begin(), recorder.calls.end(), [](const MockDrawRecorder::CALL& call) { return call.type == MockDrawRecorder::CONSTANT_BUFFER_VIEW; });
+    EXPECT_EQ(0u, cbCall.rootIndex);
+    EXPECT_EQ(0xA100u, cbCall.value);
+
+    EXPECT_EQ(s_bindingsPerDraw + 3, stats.issued);
+    EXPECT_EQ(s_bindingsPerDraw - 3, stats.skipped);
+}
+
+TEST(GCDrawRecorder, CountsPsoChangesWithoutRootSignatureChanges)
+{
+    MockDrawRecorder recorder;
+    GC_STATE_CHANGE_STATS stats;
+
+    // Opaque / alpha PSOs of one shader share its root signature
+    const int psos[] = { 1, 2, 2, 1, 3 };
+    for (int pso : psos)
+        recorder.RecordDraw(MakeDraw(pso, 1, 1, 0xA000), stats);
+
+    EXPECT_EQ(4, stats.psoChanges);
+    EXPECT_EQ(1, stats.rootSignatureChanges);
+    EXPECT_EQ(4, recorder.Count(MockDrawRecorder::PIPELINE_STATE));
+    EXPECT_EQ(1, recorder.Count(MockDrawRecorder::ROOT_SIGNATURE));
+}
+
+TEST(GCDrawRecorder, RootSignatureChangeRebindsRootArguments)
+{
+    MockDrawRecorder recorder;
+    GC_STATE_CHANGE_STATS stats;
+
+    recorder.RecordDraw(MakeDraw(1, 1, 1, 0xA000), stats);
+    recorder.calls.clear();
+
+    // Same arguments, but they were bound for the previous root signature
+    recorder.RecordDraw(MakeDraw(2, 2, 1, 0xA000), stats);
+
+    EXPECT_EQ(2, stats.psoChanges);
+    EXPECT_EQ(2, stats.rootSignatureChanges);
+    EXPECT_EQ(1, recorder.Count(MockDrawRecorder::DESCRIPTOR_TABLE));
+    EXPECT_EQ(3, recorder.Count(MockDrawRecorder::CONSTANT_BUFFER_VIEW));
+    // Input assembler state survives a root signature change
+    EXPECT_EQ(0, recorder.Count(MockDrawRecorder::VERTEX_BUFFER));
+    EXPECT_EQ(0, recorder.Count(MockDrawRecorder::TOPOLOGY));
+}
+
+TEST(GCDrawRecorder, ResetStateBindsEverythingAgain)
+{
+    MockDrawRecorder recorder;
+    GC_STATE_CHANGE_STATS stats;
+
+    recorder.RecordDraw(MakeDraw(1, 1, 1, 0xA000), stats);
+    recorder.ResetState();
+    recorder.RecordDraw(MakeDraw(1, 1, 1, 0xA000), stats);
+
+    EXPECT_EQ(2 * s_bindingsPerDraw, stats.issued);
+    EXPECT_EQ(0, stats.skipped);
+    EXPECT_EQ(2, stats.psoChanges);
+    EXPECT_EQ(2, stats.rootSignatureChanges);
+}
+
+TEST(GCDrawRecorder, InstancedDrawsBindTheirInstancesAndCountEveryTriangle)
+{
+    MockDrawRecorder recorder;
+    GC_STATE_CHANGE_STATS stats;
+
+    GC_DRAW_BINDINGS draw = MakeDraw(1, 1, 1, 0xA000);
+    draw.instanceRootIndex = 5;
+    draw.instances.ptr = 0x7000;
+    draw.instanceCount = 100;
+
+    recorder.RecordDraw(draw, stats);
+    recorder.RecordDraw(draw, stats);
+
+    EXPECT_EQ(2, recorder.Count(MockDrawRecorder::DESCRIPTOR_TABLE)); // Texture and instances, once each
+    EXPECT_EQ(s_bindingsPerDraw + 1, stats.issued);
+    EXPECT_EQ(s_bindingsPerDraw + 1, stats.skipped);
+    EXPECT_EQ(2, stats.drawCalls);
+    EXPECT_EQ(400u, stats.triangles);
+}
+
+namespace
+{
+    // Draw i of the frame is recognized by its index count on the mock
+    GC_DRAW_BINDINGS MakeFrameDraw(int drawIndex)
+    {
+        GC_DRAW_BINDINGS draw = MakeDraw(1 + (drawIndex / 100) % 2, 1, drawIndex % 3, 0xA000 + drawIndex * 0x100);
+        draw.indexCount = 3 * (drawIndex + 1);
+        return draw;
+    }
+
+    UINT64 FrameTriangles(int drawCount)
+    {
+        UINT64 triangles = 0;
+        for (int i = 0; i < drawCount; i++)
+            triangles += i + 1;
+        return triangles;
+    }
+}
+
+TEST(GCParallelDrawRecording, ListCountFollowsDrawsPerList)
+{
+    EXPECT_EQ(0, GCParallelDrawRecording::GetListCount(255, 8, 256));
+    EXPECT_EQ(1, GCParallelDrawRecording::GetListCount(256, 8, 256));
+    EXPECT_EQ(3, GCParallelDrawRecording::GetListCount(1000, 8, 256));
+    EXPECT_EQ(8, GCParallelDrawRecording::GetListCount(100000, 8, 256));
+}
+
+TEST(GCParallelDrawRecording, ChunksGoToTheirListInDrawOrder)
+{
+    GCThreadPool pool;
+    pool.Initialize(3);
+
+    const int drawCount = 1000;
+    const int listCount = 4;
+    MockDrawRecorder recorders[listCount];
+    std::vector<std::pair<int, int>> recordedRanges(listCount, { -1, -1 });
+
+    GCParallelDrawRecording recording;
+    GC_STATE_CHANGE_STATS stats;
+    bool isRecorded = recording.Record(&pool, drawCount, listCount, [&](int listIndex, int begin, int end, GC_STATE_CHANGE_STATS& listStats)
+    {
+        recordedRanges[listIndex] = { begin, end };
+        recorders[listIndex].ResetState();
+        for (int i = begin; i < end; i++)
+            recorders[listIndex].RecordDraw(MakeFrameDraw(i), listStats);
+        return true;
+    }, stats);
+
+    ASSERT_TRUE(isRecorded);
+    ASSERT_EQ(static_cast<size_t>(listCount), recording.GetRanges().size());
+
+    // Chunk i on list i, lists in index order replay the frame
+    std::vector<UINT> replayed;
+    for (int listIndex = 0; listIndex < listCount; listIndex++)
+    {
+        EXPECT_EQ(recording.GetRanges()[listIndex], recordedRanges[listIndex]);
+
+        std::vector<UINT> listDraws = recorders[listIndex].GetDrawIndexCounts();
+        EXPECT_EQ(static_cast<size_t>(recordedRanges[listIndex].second - recordedRanges[listIndex].first), listDraws.size());
+        replayed.insert(replayed.end(), listDraws.begin(), listDraws.end());
+    }
+
+    ASSERT_EQ(static_cast<size_t>(drawCount), replayed.size());
+    for (int i = 0; i < drawCount; i++)
+        ASSERT_EQ(static_cast<UINT>(3 * (i + 1)), replayed[i]) << "draw " << i;
+
+    EXPECT_EQ(drawCount, stats.drawCalls);
+    EXPECT_EQ(FrameTriangles(drawCount), stats.triangles);
+}
+
+TEST(GCParallelDrawRecording, MergedStatsMatchTheListsInOrder)
+{
+    GCThreadPool pool;
+    pool.Initialize(2);
+
+    const int drawCount = 1000;
+    const int listCount = 3;
+
+    // What RecordDraws does on each list : a fresh recorder state per list
+    GC_STATE_CHANGE_STATS expected;
+    std::vector<std::pair<int, int>> ranges;
+    GCThreadPool::Partition(drawCount, listCount, ranges);
+    for (const std::pair<int, int>& range : ranges)
+    {
+        MockDrawRecorder recorder;
+        for (int i = range.first; i < range.second; i++)
+            recorder.RecordDraw(MakeFrameDraw(i), expected);
+    }
+
+    // Counters already in the frame stats (static layer) are kept
+    GC_STATE_CHANGE_STATS stats;
+    stats.issued = 7;
+    stats.drawCalls = 2;
+
+    GCParallelDrawRecording recording;
+    recording.Record(&pool, drawCount, listCount, [&](int, int begin, int end, GC_STATE_CHANGE_STATS& listStats)
+    {
+        MockDrawRecorder recorder;
+        for (int i = begin; i < end; i++)
+            recorder.RecordDraw(MakeFrameDraw(i), listStats);
+        return true;
+    }, stats);
+
+    EXPECT_EQ(expected.issued + 7, stats.issued);
+    EXPECT_EQ(expected.skipped, stats.skipped);
+    EXPECT_EQ(expected.psoChanges, stats.psoChanges);
+    EXPECT_EQ(expected.rootSignatureChanges, stats.rootSignatureChanges);
+    EXPECT_EQ(expected.drawCalls + 2, stats.drawCalls);
+    EXPECT_EQ(expected.triangles, stats.triangles);
+
+    // Every list binds its first PSO and root signature again
+    EXPECT_EQ(listCount, stats.rootSignatureChanges);
+}
+
+TEST(GCParallelDrawRecording, FailedListFailsTheRecording)
+{
+    const int listCount = 4;
+    std::vector<int> recordedLists;
+
+    GCParallelDrawRecording recording;
+    GC_STATE_CHANGE_STATS stats;
+    bool isRecorded = recording.Record(nullptr, 1000, listCount, [&](int listIndex, int, int, GC_STATE_CHANGE_STATS&)
+    {
+        recordedLists.push_back(listIndex);
+        return listIndex != 2;
+    }, stats);
+
+    EXPECT_FALSE(isRecorded);
+    // Without a pool the chunks are recorded in order on the caller
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3 }), recordedLists);
+}
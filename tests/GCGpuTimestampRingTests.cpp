@@ -0,0 +1,275 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr UINT32 s_invalid = GCGpuTimestampRing::m_invalidZone;
+
+    // One zone frame, ended and submitted with fenceValue. Returns its slot
+    int RecordFrame(GCGpuTimestampRing& ring, UINT64 frameIndex, UINT64 fenceValue)
+    {
+        if (ring.BeginFrame(frameIndex) == false)
+            return -1;
+
+        int slot = ring.GetRecordingSlot();
+        ring.EndZone(ring.BeginZone("Frame"));
+
+        UINT32 firstQuery = 0;
+        UINT32 queryCount = 0;
+        ring.EndFrame(firstQuery, queryCount);
+        ring.Submit(fenceValue);
+
+        return slot;
+    }
+}
+
+TEST(GCGpuTimestampRing, FrameQueriesAreInItsSlotRange)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(3, 4);
+    EXPECT_EQ(24u, ring.GetQueryCount());
+
+    ASSERT_EQ(0, RecordFrame(ring, 0, 1));
+
+    ASSERT_TRUE(ring.BeginFrame(1));
+    ASSERT_EQ(1, ring.GetRecordingSlot());
+
+    UINT32 outer = ring.BeginZone("Outer");
+    UINT32 inner = ring.BeginZone("Inner");
+    ASSERT_EQ(0u, outer);
+    ASSERT_EQ(1u, inner);
+    EXPECT_EQ(8u, ring.GetBeginQuery(outer));
+    EXPECT_EQ(9u, ring.GetEndQuery(outer));
+    EXPECT_EQ(10u, ring.GetBeginQuery(inner));
+    EXPECT_EQ(11u, ring.GetEndQuery(inner));
+    ring.EndZone(inner);
+    ring.EndZone(outer);
+
+    UINT32 firstQuery = 0;
+    UINT32 queryCount = 0;
+    ASSERT_TRUE(ring.EndFrame(firstQuery, queryCount));
+    EXPECT_EQ(8u, firstQuery);
+    EXPECT_EQ(4u, queryCount);
+
+    const std::vector<GCGpuTimestampRing::GC_GPU_TIMESTAMP_ZONE>& zones = ring.GetSlotZones(1);
+    ASSERT_EQ(2u, zones.size());
+    EXPECT_EQ(0u, zones[0].depth);
+    EXPECT_EQ(1u, zones[1].depth);
+    EXPECT_EQ(1u, ring.GetSlotFrameIndex(1));
+}
+
+TEST(GCGpuTimestampRing, FullFrameIgnoresExtraZones)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(2, 2);
+
+    ASSERT_TRUE(ring.BeginFrame(0));
+    EXPECT_EQ(0u, ring.BeginZone("A"));
+    EXPECT_EQ(1u, ring.BeginZone("B"));
+    EXPECT_EQ(s_invalid, ring.BeginZone("C"));
+
+    // Invalid and out of range zones are ignored
+    ring.EndZone(s_invalid);
+    ring.EndZone(2);
+    EXPECT_EQ(1u, ring.GetOpenZone());
+}
+
+TEST(GCGpuTimestampRing, EmptyFrameFreesItsSlot)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(2, 4);
+
+    ASSERT_TRUE(ring.BeginFrame(0));
+    UINT32 firstQuery = 0;
+    UINT32 queryCount = 0;
+    EXPECT_FALSE(ring.EndFrame(firstQuery, queryCount));
+    ring.Submit(1);
+    EXPECT_EQ(-1, ring.GetReadySlot(UINT64_MAX));
+
+    // Slot 0 was released, the ring goes on with slot 1 then wraps to it
+    EXPECT_EQ(1, RecordFrame(ring, 1, 2));
+    EXPECT_EQ(0, RecordFrame(ring, 2, 3));
+    EXPECT_EQ(0u, ring.GetSkippedFrameCount());
+}
+
+TEST(GCGpuTimestampRing, NoZoneOutsideAFrame)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(2, 4);
+
+    EXPECT_FALSE(ring.IsRecording());
+    EXPECT_EQ(s_invalid, ring.BeginZone("Outside"));
+    EXPECT_EQ(s_invalid, ring.GetOpenZone());
+
+    UINT32 firstQuery = 0;
+    UINT32 queryCount = 0;
+    EXPECT_FALSE(ring.EndFrame(firstQuery, queryCount));
+}
+
+TEST(GCGpuTimestampRing, UninitializedRingTimesNothing)
+{
+    GCGpuTimestampRing ring;
+
+    EXPECT_FALSE(ring.BeginFrame(0));
+    EXPECT_EQ(s_invalid, ring.BeginZone("Zone"));
+    EXPECT_EQ(0u, ring.GetQueryCount());
+}
+
+TEST(GCGpuTimestampRing, SlotsInFlightSkipFramesUntilRetired)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(3, 4);
+
+    EXPECT_EQ(0, RecordFrame(ring, 0, 1));
+    EXPECT_EQ(1, RecordFrame(ring, 1, 2));
+    EXPECT_EQ(2, RecordFrame(ring, 2, 3));
+
+    // Every slot waits for the GPU : frames aren't timed, nothing is recorded
+    EXPECT_FALSE(ring.BeginFrame(3));
+    EXPECT_FALSE(ring.IsRecording());
+    EXPECT_EQ(s_invalid, ring.BeginZone("Skipped"));
+    UINT32 firstQuery = 0;
+    UINT32 queryCount = 0;
+    EXPECT_FALSE(ring.EndFrame(firstQuery, queryCount));
+    ring.Submit(4);
+
+    EXPECT_FALSE(ring.BeginFrame(4));
+    EXPECT_EQ(2u, ring.GetSkippedFrameCount());
+
+    // The skipped submission added no slot, the oldest one is read first
+    EXPECT_EQ(-1, ring.GetReadySlot(0));
+    ASSERT_EQ(0, ring.GetReadySlot(4));
+    EXPECT_EQ(0u, ring.GetSlotFrameIndex(0));
+    ring.Retire(0);
+
+    // Next slot in order is the freed one
+    EXPECT_EQ(0, RecordFrame(ring, 5, 5));
+    EXPECT_EQ(5u, ring.GetSlotFrameIndex(0));
+    EXPECT_FALSE(ring.BeginFrame(6));
+    EXPECT_EQ(3u, ring.GetSkippedFrameCount());
+}
+
+TEST(GCGpuTimestampRing, ReadySlotsFollowSubmissionAndFence)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(3, 4);
+
+    RecordFrame(ring, 0, 10);
+    RecordFrame(ring, 1, 11);
+    RecordFrame(ring, 2, 12);
+
+    EXPECT_EQ(-1, ring.GetReadySlot(9));
+
+    // Oldest first, even when later fences are reached too
+    EXPECT_EQ(0, ring.GetReadySlot(12));
+    EXPECT_EQ(0, ring.GetReadySlot(12));
+    ring.Retire(0);
+    EXPECT_EQ(-1, ring.GetReadySlot(10));
+    EXPECT_EQ(1, ring.GetReadySlot(11));
+    ring.Retire(1);
+    EXPECT_EQ(-1, ring.GetReadySlot(11));
+    EXPECT_EQ(2, ring.GetReadySlot(12));
+    ring.Retire(2);
+    EXPECT_EQ(-1, ring.GetReadySlot(UINT64_MAX));
+
+    // Wrapped slots keep the submission order
+    EXPECT_EQ(0, RecordFrame(ring, 3, 13));
+    EXPECT_EQ(1, RecordFrame(ring, 4, 14));
+    EXPECT_EQ(0, ring.GetReadySlot(14));
+    ring.Retire(0);
+    EXPECT_EQ(1, ring.GetReadySlot(14));
+    EXPECT_TRUE(ring.GetSlotZones(0).empty());
+}
+
+TEST(GCGpuTimestampRing, FramesNeverSubmittedAreDropped)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(2, 4);
+
+    // Ended without Submit, more times than there are slots : none stays in flight
+    for (UINT64 frame = 0; frame < 5; frame++)
+    {
+        ASSERT_TRUE(ring.BeginFrame(frame));
+        ring.EndZone(ring.BeginZone("Frame"));
+
+        UINT32 firstQuery = 0;
+        UINT32 queryCount = 0;
+        ASSERT_TRUE(ring.EndFrame(firstQuery, queryCount));
+    }
+    EXPECT_EQ(0u, ring.GetSkippedFrameCount());
+    EXPECT_EQ(-1, ring.GetReadySlot(UINT64_MAX));
+
+    // A late Submit is for a dropped frame once the next one began
+    ASSERT_TRUE(ring.BeginFrame(5));
+    ring.Submit(1);
+    EXPECT_EQ(-1, ring.GetReadySlot(UINT64_MAX));
+
+    UINT32 firstQuery = 0;
+    UINT32 queryCount = 0;
+    ring.EndZone(ring.BeginZone("Frame"));
+    ASSERT_TRUE(ring.EndFrame(firstQuery, queryCount));
+    ring.Submit(2);
+    int slot = ring.GetReadySlot(2);
+    ASSERT_GE(slot, 0);
+    EXPECT_EQ(5u, ring.GetSlotFrameIndex(slot));
+}
+
+TEST(GCGpuTimestampRing, FramesNeverEndedReuseTheirSlot)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(2, 4);
+
+    ASSERT_TRUE(ring.BeginFrame(0));
+    ring.BeginZone("Lost");
+    ASSERT_EQ(0, ring.GetRecordingSlot());
+
+    // Restarted in the same slot, the zones of the lost frame are gone
+    ASSERT_TRUE(ring.BeginFrame(1));
+    EXPECT_EQ(0, ring.GetRecordingSlot());
+    EXPECT_TRUE(ring.GetSlotZones(0).empty());
+    EXPECT_EQ(s_invalid, ring.GetOpenZone());
+    EXPECT_EQ(0u, ring.BeginZone("Frame"));
+    EXPECT_EQ(0u, ring.GetSlotZones(0)[0].depth);
+    EXPECT_EQ(1u, ring.GetSlotFrameIndex(0));
+}
+
+TEST(GCGpuTimestampRing, OpenZonesCloseInnermostFirst)
+{
+    GCGpuTimestampRing ring;
+    ring.Initialize(2, 8);
+
+    ASSERT_TRUE(ring.BeginFrame(0));
+    UINT32 frame = ring.BeginZone("Frame");
+    UINT32 shadows = ring.BeginZone("Shadows");
+    ring.EndZone(shadows);
+    UINT32 draws = ring.BeginZone("Draws");
+    UINT32 opaque = ring.BeginZone("Opaque");
+
+    // What GCGpuTimer::EndFrame does : ends the innermost open zone until none is left
+    std::vector<UINT32> closed;
+    UINT32 zone;
+    while ((zone = ring.GetOpenZone()) != s_invalid)
+    {
+        closed.push_back(zone);
+        ring.EndZone(zone);
+    }
+    EXPECT_EQ((std::vector<UINT32>{ opaque, draws, frame }), closed);
+
+    const std::vector<GCGpuTimestampRing::GC_GPU_TIMESTAMP_ZONE>& zones = ring.GetSlotZones(0);
+    for (const GCGpuTimestampRing::GC_GPU_TIMESTAMP_ZONE& z : zones)
+        EXPECT_TRUE(z.isEnded) << z.name;
+
+    // Depth is back to the frame level
+    EXPECT_EQ(1u, zones[shadows].depth);
+    EXPECT_EQ(1u, zones[draws].depth);
+    EXPECT_EQ(2u, zones[opaque].depth);
+    UINT32 after = ring.BeginZone("After");
+    EXPECT_EQ(0u, zones[after].depth);
+
+    // An ended zone isn't ended twice
+    ring.EndZone(after);
+    ring.EndZone(after);
+    UINT32 last = ring.BeginZone("Last");
+    EXPECT_EQ(0u, zones[last].depth);
+}
@@ -0,0 +1,217 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+using namespace DirectX;
+
+namespace
+{
+    // Every particle spawns at the same place with the same velocity, no emission from Update
+    GC_PARTICLE_EMITTER_DESC FixedDesc(int maxParticles)
+    {
+        GC_PARTICLE_EMITTER_DESC desc;
+        desc.position = XMFLOAT3(1.0f, 2.0f, 3.0f);
+        desc.velocityMin = XMFLOAT3(4.0f, 5.0f, -6.0f);
+        desc.velocityMax = desc.velocityMin;
+        desc.gravity = XMFLOAT3(0.0f, -10.0f, 2.0f);
+        desc.drag = 0.5f;
+        desc.lifetimeMin = 10.0f;
+        desc.lifetimeMax = 10.0f;
+        desc.spawnRate = 0.0f;
+        desc.maxParticles = maxParticles;
+        return desc;
+    }
+}
+
+TEST(GCParticleSimulation, IntegrateMatchesTheScalarSteps)
+{
+    const GC_PARTICLE_EMITTER_DESC desc = FixedDesc(16);
+
+    // 7 particles : one full SIMD group and a group of 3 with a padding lane
+    GCParticleSimulation simulation;
+    simulation.Initialize(desc, 1);
+    ASSERT_EQ(7, simulation.Burst(7));
+
+    XMFLOAT3 position = desc.position;
+    XMFLOAT3 velocity = desc.velocityMin;
+    float age = 0.0f;
+
+    const float deltaTimes[] = { 0.016f, 0.033f, 0.1f };
+    for (float dt : deltaTimes)
+    {
+        simulation.Update(dt);
+
+        float damping = 1.0f - desc.drag * dt;
+        velocity.x = (velocity.x + desc.gravity.x * dt) * damping;
+        velocity.y = (velocity.y + desc.gravity.y * dt) * damping;
+        velocity.z = (velocity.z + desc.gravity.z * dt) * damping;
+        position.x += velocity.x * dt;
+        position.y += velocity.y * dt;
+        position.z += velocity.z * dt;
+        age += dt;
+    }
+
+    ASSERT_EQ(7, simulation.GetCount());
+    for (int i = 0; i < simulation.GetCount(); i++)
+    {
+        XMFLOAT3 simulatedVelocity = simulation.GetVelocity(i);
+        XMFLOAT3 simulatedPosition = simulation.GetPosition(i);
+        EXPECT_FLOAT_EQ(velocity.x, simulatedVelocity.x) << "particle " << i;
+        EXPECT_FLOAT_EQ(velocity.y, simulatedVelocity.y) << "particle " << i;
+        EXPECT_FLOAT_EQ(velocity.z, simulatedVelocity.z) << "particle " << i;
+        EXPECT_FLOAT_EQ(position.x, simulatedPosition.x) << "particle " << i;
+        EXPECT_FLOAT_EQ(position.y, simulatedPosition.y) << "particle " << i;
+        EXPECT_FLOAT_EQ(position.z, simulatedPosition.z) << "particle " << i;
+        EXPECT_FLOAT_EQ(age, simulation.GetAge(i)) << "particle " << i;
+    }
+}
+
+TEST(GCParticleSimulation, DragNeverReversesTheVelocity)
+{
+    GC_PARTICLE_EMITTER_DESC desc = FixedDesc(4);
+    desc.gravity = XMFLOAT3(0.0f, 0.0f, 0.0f);
+    desc.drag = 20.0f;
+
+    GCParticleSimulation simulation;
+    simulation.Initialize(desc, 1);
+    simulation.Burst(1);
+    simulation.Update(0.1f);
+
+    XMFLOAT3 velocity = simulation.GetVelocity(0);
+    EXPECT_EQ(0.0f, velocity.x);
+    EXPECT_EQ(0.0f, velocity.y);
+    EXPECT_EQ(0.0f, velocity.z);
+}
+
+TEST(GCParticleSimulation, ThreadPoolSplitGivesTheSameResult)
+{
+    GC_PARTICLE_EMITTER_DESC desc = FixedDesc(GCParticleSimulation::m_particlesPerTask * 3 + 5);
+    desc.velocityMin = XMFLOAT3(-5.0f, -5.0f, -5.0f);
+    desc.velocityMax = XMFLOAT3(5.0f, 5.0f, 5.0f);
+    desc.positionSpread = XMFLOAT3(10.0f, 10.0f, 10.0f);
+
+    GCThreadPool pool;
+    pool.Initialize(3);
+
+    GCParticleSimulation serial, parallel;
+    serial.Initialize(desc, 42);
+    parallel.Initialize(desc, 42);
+    serial.Burst(desc.maxParticles);
+    parallel.Burst(desc.maxParticles);
+
+    for (int frame = 0; frame < 3; frame++)
+    {
+        serial.Update(0.016f);
+        parallel.Update(0.016f, &pool);
+    }
+
+    ASSERT_EQ(serial.GetCount(), parallel.GetCount());
+    for (int i = 0; i < serial.GetCount(); i++)
+    {
+        ASSERT_EQ(serial.GetPosition(i).x, parallel.GetPosition(i).x) << "particle " << i;
+        ASSERT_EQ(serial.GetPosition(i).y, parallel.GetPosition(i).y) << "particle " << i;
+        ASSERT_EQ(serial.GetPosition(i).z, parallel.GetPosition(i).z) << "particle " << i;
+        ASSERT_EQ(serial.GetAge(i), parallel.GetAge(i)) << "particle " << i;
+    }
+}
+
+TEST(GCParticleSimulation, CompactRemovesDeadParticlesOnly)
+{
+    GC_PARTICLE_EMITTER_DESC desc = FixedDesc(64);
+    GCParticleSimulation simulation;
+    simulation.Initialize(desc, 1);
+
+    // Interleaved short (1 s) and long (3 s) lived particles
+    for (int i = 0; i < 10; i++)
+    {
+        bool isShort = i % 3 != 2;
+        desc.lifetimeMin = isShort ? 1.0f : 3.0f;
+        desc.lifetimeMax = desc.lifetimeMin;
+        simulation.SetDesc(desc);
+        simulation.Burst(1);
+    }
+    ASSERT_EQ(10, simulation.GetCount());
+
+    simulation.Update(0.5f);
+    EXPECT_EQ(10, simulation.GetCount());
+
+    simulation.Update(0.5f);
+    ASSERT_EQ(3, simulation.GetCount());
+    for (int i = 0; i < simulation.GetCount(); i++)
+    {
+        EXPECT_EQ(3.0f, simulation.GetLifetime(i));
+        EXPECT_FLOAT_EQ(1.0f, simulation.GetAge(i));
+    }
+
+    // All dead at once, holes at the end included
+    simulation.Update(2.0f);
+    EXPECT_EQ(0, simulation.GetCount());
+}
+
+TEST(GCParticleSimulation, SpawnCountCarriesTheFractionOver)
+{
+    GC_PARTICLE_EMITTER_DESC desc = FixedDesc(1000);
+    desc.spawnRate = 10.0f;
+
+    GCParticleSimulation simulation;
+    simulation.Initialize(desc, 1);
+
+    EXPECT_EQ(2, simulation.ConsumeSpawnCount(0.25f)); // 2.5
+    EXPECT_EQ(3, simulation.ConsumeSpawnCount(0.25f)); // 0.5 + 2.5
+    EXPECT_EQ(0, simulation.ConsumeSpawnCount(0.05f)); // 0.5
+    EXPECT_EQ(1, simulation.ConsumeSpawnCount(0.05f)); // 1.0
+
+    // 30 particles per second at 60 fps, many frames below one particle
+    desc.spawnRate = 30.0f;
+    simulation.SetDesc(desc);
+    simulation.Clear();
+
+    int spawnCount = 0;
+    for (int frame = 0; frame < 120; frame++)
+        spawnCount += simulation.ConsumeSpawnCount(1.0f / 60.0f);
+    EXPECT_NEAR(60, spawnCount, 1);
+}
+
+TEST(GCParticleSimulation, EmissionIsCappedByMaxParticles)
+{
+    GC_PARTICLE_EMITTER_DESC desc = FixedDesc(10);
+    GCParticleSimulation simulation;
+    simulation.Initialize(desc, 1);
+
+    EXPECT_EQ(6, simulation.Burst(6));
+    EXPECT_EQ(4, simulation.Burst(6));
+    EXPECT_EQ(0, simulation.Burst(1));
+    EXPECT_EQ(10, simulation.GetCount());
+
+    // Update emits from spawnRate without going over either
+    desc.spawnRate = 1000.0f;
+    simulation.SetDesc(desc);
+    simulation.Update(0.1f);
+    EXPECT_EQ(10, simulation.GetCount());
+}
+
+TEST(GCParticleSimulation, PackInterpolatesSizeAndColorOverTheLifetime)
+{
+    GC_PARTICLE_EMITTER_DESC desc = FixedDesc(4);
+    desc.lifetimeMin = 2.0f;
+    desc.lifetimeMax = 2.0f;
+    desc.startSize = 1.0f;
+    desc.endSize = 0.0f;
+    desc.startColor = XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f);
+    desc.endColor = XMFLOAT4(0.0f, 0.0f, 1.0f, 0.0f);
+
+    GCParticleSimulation simulation;
+    simulation.Initialize(desc, 1);
+    simulation.Burst(1);
+    simulation.Update(0.5f);
+
+    GCPARTICLE particle;
+    simulation.Pack(&particle);
+
+    EXPECT_FLOAT_EQ(0.75f, particle.size);
+    EXPECT_FLOAT_EQ(0.75f, particle.color.x);
+    EXPECT_FLOAT_EQ(0.25f, particle.color.z);
+    EXPECT_FLOAT_EQ(0.75f, particle.color.w);
+    EXPECT_FLOAT_EQ(0.5f, particle.age);
+    EXPECT_FLOAT_EQ(2.0f, particle.lifetime);
+}
@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // Keys of a frame over few shaders / materials / textures / depths : many equal keys. 1 in 4 alpha
+    std::vector<uint64_t> MakeFrameKeys(int count, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> shaders(0, 3);
+        std::uniform_int_distribution<int> materials(0, 5);
+        std::uniform_int_distribution<int> textures(0, 2);
+        std::uniform_int_distribution<int> depths(-4, 4);
+
+        std::vector<uint64_t> keys(count);
+        for (int i = 0; i < count; i++)
+        {
+            float depth = static_cast<float>(depths(random)) * 2.5f;
+            if (i % 4 == 0)
+                keys[i] = GCRenderQueue::MakeAlphaKey(depth, static_cast<uint32_t>(i % 8)); // Repeated sequences, equal alpha keys too
+            else
+                keys[i] = GCRenderQueue::MakeOpaqueKey(shaders(random), materials(random), textures(random), depth);
+        }
+        return keys;
+    }
+
+    // Sorted by the queue, compared entry by entry (key and submission index) with std::stable_sort
+    void ExpectSameAsStableSort(const std::vector<uint64_t>& keys)
+    {
+        GCRenderQueue queue;
+        std::vector<GC_RENDER_QUEUE_ENTRY> expected;
+        for (uint64_t key : keys)
+        {
+            queue.Push(key);
+            expected.push_back({ key, static_cast<uint32_t>(expected.size()) });
+        }
+
+        queue.Sort();
+        std::stable_sort(expected.begin(), expected.end(), [](const GC_RENDER_QUEUE_ENTRY& a, const GC_RENDER_QUEUE_ENTRY& b) { return a.key < b.key; });
+
+        const std::vector<GC_RENDER_QUEUE_ENTRY>& entries = queue.GetEntries();
+        ASSERT_EQ(expected.size(), entries.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(expected[i].key, entries[i].key) << "at " << i;
+            ASSERT_EQ(expected[i].index, entries[i].index) << "at " << i;
+        }
+    }
+}
+
+TEST(GCRenderQueue, RadixSortMatchesStableSortWithDuplicateKeys)
+{
+    // Radix path, then the comparison sort path below its minimum count
+    ExpectSameAsStableSort(MakeFrameKeys(20000, 1));
+    ExpectSameAsStableSort(MakeFrameKeys(4097, 2));
+    ExpectSameAsStableSort(MakeFrameKeys(100, 3));
+}
+
+TEST(GCRenderQueue, SkippedBytePassesKeepTheOrder)
+{
+    std::mt19937 random(7);
+
+    // Only the top byte differs : a single pass, the result comes from the scratch buffer
+    std::vector<uint64_t> keys;
+    for (int i = 0; i < 1000; i++)
+        keys.push_back((static_cast<uint64_t>(random() % 4) << 56) | 0x0011223344556677ull);
+    ExpectSameAsStableSort(keys);
+
+    // Lowest and highest bytes differ : two passes
+    keys.clear();
+    for (int i = 0; i < 1000; i++)
+        keys.push_back((static_cast<uint64_t>(random() % 4) << 56) | (random() % 3));
+    ExpectSameAsStableSort(keys);
+
+    // Every key equal : no pass at all, submission order
+    ExpectSameAsStableSort(std::vector<uint64_t>(1000, GCRenderQueue::MakeOpaqueKey(1, 2, 3, 4.0f)));
+}
+
+TEST(GCRenderQueue, OpaqueDrawsComeBeforeAlphaDraws)
+{
+    std::vector<uint64_t> keys = MakeFrameKeys(5000, 4);
+
+    GCRenderQueue queue;
+    for (uint64_t key : keys)
+        queue.Push(key);
+    queue.Sort();
+
+    // Pass bit first : every alpha key after every opaque one, whatever the other fields
+    bool isAlpha = false;
+    for (const GC_RENDER_QUEUE_ENTRY& entry : queue.GetEntries())
+    {
+        bool isEntryAlpha = (entry.key >> 63) != 0;
+        ASSERT_FALSE(isAlpha && isEntryAlpha == false) << "opaque draw " << entry.index << " after an alpha draw";
+        isAlpha = isEntryAlpha;
+    }
+    EXPECT_TRUE(isAlpha);
+}
+
+TEST(GCRenderQueue, OpaqueKeyFieldsSortByPriority)
+{
+    auto key = [](int shader, int material, int texture, float depth) { return GCRenderQueue::MakeOpaqueKey(shader, material, texture, depth); };
+
+    // Shader, then material, then texture, then depth
+    EXPECT_LT(key(0, 65535, 4095, 1000.0f), key(1, 0, 0, 0.0f));
+    EXPECT_LT(key(1, 0, 4095, 1000.0f), key(1, 1, 0, 0.0f));
+    EXPECT_LT(key(1, 1, 0, 1000.0f), key(1, 1, 1, 0.0f));
+
+    // Front to back, negative depths included
+    EXPECT_LT(key(1, 1, 1, -10.0f), key(1, 1, 1, -1.0f));
+    EXPECT_LT(key(1, 1, 1, -1.0f), key(1, 1, 1, 0.5f));
+    EXPECT_LT(key(1, 1, 1, 0.5f), key(1, 1, 1, 100.0f));
+
+    // Material ids above 255 keep their high bits
+    EXPECT_LT(key(1, 255, 0, 0.0f), key(1, 256, 0, 0.0f));
+}
+
+TEST(GCRenderQueue, AlphaKeysSortBackToFrontThenBySubmission)
+{
+    EXPECT_LT(GCRenderQueue::MakeAlphaKey(100.0f, 5), GCRenderQueue::MakeAlphaKey(10.0f, 0));
+    EXPECT_LT(GCRenderQueue::MakeAlphaKey(1.0f, 5), GCRenderQueue::MakeAlphaKey(-1.0f, 0));
+    EXPECT_LT(GCRenderQueue::MakeAlphaKey(10.0f, 0), GCRenderQueue::MakeAlphaKey(10.0f, 1));
+
+    // The farthest alpha draw still comes after the nearest opaque one
+    EXPECT_LT(GCRenderQueue::MakeOpaqueKey(4095, 65535, 4095, 1e30f), GCRenderQueue::MakeAlphaKey(1e30f, 0));
+}
@@ -0,0 +1,229 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr UINT64 s_invalid = GCStagingRingAllocator::m_invalidOffset;
+}
+
+TEST(GCStagingRingAllocator, AllocationsAreAlignedAndPaddingIsUsed)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(256);
+
+    EXPECT_EQ(0u, allocator.Allocate(3, 1));
+    EXPECT_EQ(16u, allocator.Allocate(8, 16));
+    EXPECT_EQ(24u, allocator.Allocate(1, 4));
+    EXPECT_EQ(32u, allocator.Allocate(64, 32));
+
+    // 3 + 13 padding + 8 + 1 + 7 padding + 64
+    EXPECT_EQ(96u, allocator.GetUsedBytes());
+    EXPECT_EQ(96u, allocator.GetOpenBytes());
+}
+
+TEST(GCStagingRingAllocator, InvalidSizesFail)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(64);
+
+    EXPECT_EQ(s_invalid, allocator.Allocate(0, 1));
+    EXPECT_EQ(s_invalid, allocator.Allocate(65, 1));
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+}
+
+TEST(GCStagingRingAllocator, FullRingFailsUntilRetired)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(64);
+
+    ASSERT_EQ(0u, allocator.Allocate(64, 16));
+    EXPECT_EQ(s_invalid, allocator.Allocate(1, 1));
+
+    // Closed but the GPU isn't done with it yet
+    allocator.Close(1);
+    allocator.Retire(0);
+    EXPECT_EQ(s_invalid, allocator.Allocate(1, 1));
+    EXPECT_EQ(64u, allocator.GetUsedBytes());
+
+    allocator.Retire(1);
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+    EXPECT_FALSE(allocator.HasPendingBatches());
+    // Empty ring restarts at 0, the whole capacity in one piece
+    EXPECT_EQ(0u, allocator.Allocate(64, 16));
+}
+
+TEST(GCStagingRingAllocator, AlignmentPaddingCanMakeAnAllocationFail)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(64);
+
+    ASSERT_EQ(0u, allocator.Allocate(1, 1));
+    allocator.Close(1);
+
+    // 63 bytes free after the head but only 48 once aligned on 16, the start of the ring is still in use
+    EXPECT_EQ(s_invalid, allocator.Allocate(56, 16));
+    EXPECT_EQ(16u, allocator.Allocate(48, 16));
+}
+
+TEST(GCStagingRingAllocator, RingEndIsSkippedWhenTheAllocationDoesntFit)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(100);
+
+    ASSERT_EQ(0u, allocator.Allocate(60, 1));
+    allocator.Close(1);
+    ASSERT_EQ(60u, allocator.Allocate(30, 1));
+    allocator.Close(2);
+
+    allocator.Retire(1);
+    EXPECT_EQ(30u, allocator.GetUsedBytes());
+
+    // 10 bytes left at the end : the allocation goes back to 0, the end counts as used
+    EXPECT_EQ(0u, allocator.Allocate(20, 1));
+    EXPECT_EQ(60u, allocator.GetUsedBytes());
+    EXPECT_EQ(30u, allocator.GetOpenBytes());
+    allocator.Close(3);
+
+    // Up to the tail (60) is free, not past it
+    EXPECT_EQ(s_invalid, allocator.Allocate(41, 1));
+    EXPECT_EQ(20u, allocator.Allocate(40, 1));
+    allocator.Close(4);
+    EXPECT_EQ(100u, allocator.GetUsedBytes());
+
+    // Skipped end released with the batch that skipped it
+    allocator.Retire(2);
+    EXPECT_EQ(70u, allocator.GetUsedBytes());
+    allocator.Retire(3);
+    EXPECT_EQ(40u, allocator.GetUsedBytes());
+    allocator.Retire(4);
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+}
+
+TEST(GCStagingRingAllocator, WrappedAllocationFailsWhenTheStartIsInUse)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(100);
+
+    ASSERT_EQ(0u, allocator.Allocate(40, 1));
+    allocator.Close(1);
+    ASSERT_EQ(40u, allocator.Allocate(50, 1));
+    allocator.Close(2);
+
+    // 10 bytes at the end, the start is [0, 40) still in flight
+    EXPECT_EQ(s_invalid, allocator.Allocate(20, 1));
+
+    allocator.Retire(1);
+    EXPECT_EQ(0u, allocator.Allocate(20, 1));
+}
+
+TEST(GCStagingRingAllocator, BatchesRetireInCloseOrder)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(1024);
+
+    allocator.Allocate(100, 1);
+    allocator.Close(5);
+    allocator.Allocate(100, 1);
+    allocator.Close(6);
+    allocator.Allocate(100, 1);
+    allocator.Close(7);
+    ASSERT_EQ(300u, allocator.GetUsedBytes());
+
+    allocator.Retire(4);
+    EXPECT_EQ(300u, allocator.GetUsedBytes());
+    allocator.Retire(6);
+    EXPECT_EQ(100u, allocator.GetUsedBytes());
+    EXPECT_TRUE(allocator.HasPendingBatches());
+    allocator.Retire(7);
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+    EXPECT_FALSE(allocator.HasPendingBatches());
+}
+
+TEST(GCStagingRingAllocator, OpenAllocationsSurviveRetire)
+{
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(1024);
+
+    allocator.Allocate(100, 1);
+    allocator.Close(1);
+    allocator.Allocate(50, 1);
+
+    // Not closed yet : not part of any fence
+    allocator.Retire(100);
+    EXPECT_EQ(50u, allocator.GetUsedBytes());
+    EXPECT_EQ(50u, allocator.GetOpenBytes());
+
+    // Nothing open : no empty batch
+    allocator.Close(2);
+    allocator.Retire(2);
+    allocator.Close(3);
+    EXPECT_FALSE(allocator.HasPendingBatches());
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+}
+
+TEST(GCStagingRingAllocator, RandomFramesNeverOverlapLiveAllocations)
+{
+    const UINT64 capacity = 4096;
+    GCStagingRingAllocator allocator;
+    allocator.Initialize(capacity);
+
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> sizes(1, 700);
+    std::uniform_int_distribution<int> alignmentShifts(0, 6);
+    std::uniform_int_distribution<int> allocationCounts(0, 6);
+    std::uniform_int_distribution<int> latencies(0, 3);
+
+    // Live ranges with the fence of their batch, 0 while open
+    struct RANGE { UINT64 begin, end, fenceValue; };
+    std::vector<RANGE> live;
+
+    UINT64 fenceValue = 0;
+    UINT64 completedFenceValue = 0;
+    int failedCount = 0;
+
+    for (int frame = 0; frame < 5000; frame++)
+    {
+        int allocationCount = allocationCounts(random);
+        for (int a = 0; a < allocationCount; a++)
+        {
+            UINT64 size = sizes(random);
+            UINT64 alignment = 1ull << alignmentShifts(random);
+            UINT64 offset = allocator.Allocate(size, alignment);
+            if (offset == s_invalid)
+            {
+                failedCount++;
+                continue;
+            }
+
+            ASSERT_EQ(0u, offset % alignment);
+            ASSERT_LE(offset + size, capacity);
+            for (const RANGE& range : live)
+                ASSERT_TRUE(offset + size <= range.begin || offset >= range.end) << "frame " << frame;
+
+            live.push_back({ offset, offset + size, 0 });
+            ASSERT_LE(allocator.GetUsedBytes(), capacity);
+        }
+
+        fenceValue++;
+        allocator.Close(fenceValue);
+        for (RANGE& range : live)
+        {
+            if (range.fenceValue == 0)
+                range.fenceValue = fenceValue;
+        }
+
+        // The GPU lags a few frames behind
+        completedFenceValue = std::max(completedFenceValue, fenceValue > 3 ? fenceValue - latencies(random) : 0);
+        allocator.Retire(completedFenceValue);
+        live.erase(std::remove_if(live.begin(), live.end(), [&](const RANGE& range) { return range.fenceValue <= completedFenceValue; }), live.end());
+
+        if (live.empty())
+            ASSERT_EQ(0u, allocator.GetUsedBytes());
+    }
+
+    // Both sides were exercised
+    EXPECT_GT(failedCount, 0);
+    allocator.Retire(fenceValue);
+    EXPECT_EQ(0u, allocator.GetUsedBytes());
+}
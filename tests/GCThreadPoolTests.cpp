@@ -0,0 +1,73 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+TEST(GCThreadPool, PartitionSplitsInOrderedNearlyEqualRanges)
+{
+    std::vector<std::pair<int, int>> ranges;
+    GCThreadPool::Partition(10, 3, ranges);
+
+    ASSERT_EQ(3u, ranges.size());
+    EXPECT_EQ(std::make_pair(0, 4), ranges[0]);
+    EXPECT_EQ(std::make_pair(4, 7), ranges[1]);
+    EXPECT_EQ(std::make_pair(7, 10), ranges[2]);
+}
+
+TEST(GCThreadPool, PartitionCoversTheWholeRangeWithoutGaps)
+{
+    std::vector<std::pair<int, int>> ranges;
+    for (int count = 1; count < 100; count++)
+    {
+        for (int taskCount = 1; taskCount < 12; taskCount++)
+        {
+            GCThreadPool::Partition(count, taskCount, ranges);
+
+            ASSERT_EQ(static_cast<size_t>(std::min(count, taskCount)), ranges.size());
+            int begin = 0;
+            int minSize = count;
+            int maxSize = 0;
+            for (const std::pair<int, int>& range : ranges)
+            {
+                EXPECT_EQ(begin, range.first);
+                EXPECT_LT(range.first, range.second);
+                minSize = std::min(minSize, range.second - range.first);
+                maxSize = std::max(maxSize, range.second - range.first);
+                begin = range.second;
+            }
+            EXPECT_EQ(count, begin);
+            EXPECT_LE(maxSize - minSize, 1);
+        }
+    }
+}
+
+TEST(GCThreadPool, PartitionOfNothingIsEmpty)
+{
+    std::vector<std::pair<int, int>> ranges = { { 0, 1 } };
+
+    GCThreadPool::Partition(0, 4, ranges);
+    EXPECT_TRUE(ranges.empty());
+
+    GCThreadPool::Partition(8, 0, ranges);
+    EXPECT_TRUE(ranges.empty());
+}
+
+TEST(GCThreadPool, ParallelForRunsEveryTaskOnce)
+{
+    GCThreadPool pool;
+    pool.Initialize(3);
+    ASSERT_EQ(4, pool.GetThreadCount());
+
+    for (int job = 0; job < 50; job++)
+    {
+        std::vector<std::atomic<int>> runs(37);
+        pool.ParallelFor(static_cast<int>(runs.size()), [&](int taskIndex, int threadIndex)
+        {
+            EXPECT_GE(threadIndex, 0);
+            EXPECT_LT(threadIndex, 4);
+            runs[taskIndex]++;
+        });
+
+        for (std::atomic<int>& count : runs)
+            ASSERT_EQ(1, count.load());
+    }
+}
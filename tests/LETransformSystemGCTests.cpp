@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "LETransformGC.h"
+
+#include <gtest/gtest.h>
+
+using namespace DirectX;
+
+namespace
+{
+    // What LEObjectGC uploaded before the SoA system : Scaling * RotationZ * Translation(x, -y)
+    XMFLOAT4X4 ReferenceWorld(float x, float y, float scaleX, float scaleY, float radians)
+    {
+        XMFLOAT4X4 world;
+        XMStoreFloat4x4(&world, XMMatrixMultiply(XMMatrixMultiply(XMMatrixScaling(scaleX, scaleY, 1.0f), XMMatrixRotationZ(radians)), XMMatrixTranslation(x, -y, 0.0f)));
+        return world;
+    }
+
+    void ExpectMatrixNear(const XMFLOAT4X4& expected, const XMFLOAT4X4& actual)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            for (int column = 0; column < 4; column++)
+                EXPECT_NEAR(expected.m[row][column], actual.m[row][column], 1e-4f) << "row " << row << " column " << column;
+        }
+    }
+}
+
+TEST(LETransformSystemGC, UpdateMatchesScalingRotationTranslation)
+{
+    LETransformSystemGC system;
+
+    // Two blocks, the second one partially used
+    std::vector<int> handles;
+    for (int i = 0; i < 6; i++)
+    {
+        int handle = system.Create();
+        system.SetPosition(handle, 10.0f * i, -3.0f * i);
+        system.SetScale(handle, 1.0f + i, 2.0f - 0.25f * i);
+        system.SetRotation(handle, 0.3f * i);
+        handles.push_back(handle);
+    }
+
+    ASSERT_TRUE(system.IsDirty());
+    system.Update();
+    EXPECT_FALSE(system.IsDirty());
+
+    for (int i = 0; i < 6; i++)
+        ExpectMatrixNear(ReferenceWorld(10.0f * i, -3.0f * i, 1.0f + i, 2.0f - 0.25f * i, 0.3f * i), system.GetWorldMatrix(handles[i]));
+}
+
+TEST(LETransformSystemGC, UpdateOnlyRebuildsDirtyBlocks)
+{
+    LETransformSystemGC system;
+
+    std::vector<int> handles;
+    for (int i = 0; i < 8; i++)
+        handles.push_back(system.Create());
+    system.Update();
+
+    // Written behind the setters' back : only a dirty block would overwrite it
+    int first = handles[0];
+    int fifth = handles[4];
+    XMFLOAT4X4& firstWorld = const_cast<XMFLOAT4X4&>(system.GetWorldMatrix(first));
+    firstWorld._41 = 123.0f;
+
+    system.SetPosition(fifth, 5.0f, 6.0f);
+    system.Update();
+
+    EXPECT_EQ(123.0f, system.GetWorldMatrix(first)._41);
+    ExpectMatrixNear(ReferenceWorld(5.0f, 6.0f, 1.0f, 1.0f, 0.0f), system.GetWorldMatrix(fifth));
+}
+
+TEST(LETransformSystemGC, DestroyedHandlesAreReusedWithDefaults)
+{
+    LETransformSystemGC system;
+
+    int handle = system.Create();
+    system.SetPosition(handle, 4.0f, 2.0f);
+    system.SetScale(handle, 3.0f, 3.0f);
+    EXPECT_EQ(1, system.GetCount());
+
+    system.Destroy(handle);
+    EXPECT_EQ(0, system.GetCount());
+
+    int reused = system.Create();
+    EXPECT_EQ(handle, reused);
+    EXPECT_EQ(0.0f, system.GetX(reused));
+    EXPECT_EQ(1.0f, system.GetScaleX(reused));
+
+    system.Update();
+    ExpectMatrixNear(ReferenceWorld(0.0f, 0.0f, 1.0f, 1.0f, 0.0f), system.GetWorldMatrix(reused));
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// Draw recorder that keeps the calls it receives instead of writing a command list
+class MockDrawRecorder : public GCDrawRecorder
+{
+public:
+	enum CALL_TYPE
+	{
+		PIPELINE_STATE,
+		ROOT_SIGNATURE,
+		TOPOLOGY,
+		VERTEX_BUFFER,
+		INDEX_BUFFER,
+		DESCRIPTOR_TABLE,
+		CONSTANT_BUFFER_VIEW,
+		DRAW,
+	};
+
+	struct CALL
+	{
+		CALL_TYPE type;
+		UINT rootIndex; // Root arguments
+		UINT64 value; // Pointer, address or index count
+	};
+
+	std::vector<CALL> calls;
+
+	int Count(CALL_TYPE type) const
+	{
+		return static_cast<int>(std::count_if(calls.begin(), calls.end(), [type](const CALL& call) { return call.type == type; }));
+	}
+
+	// Index counts of the recorded draws, in order
+	std::vector<UINT> GetDrawIndexCounts() const
+	{
+		std::vector<UINT> indexCounts;
+		for (const CALL& call : calls)
+		{
+			if (call.type == DRAW)
+				indexCounts.push_back(static_cast<UINT>(call.value));
+		}
+		return indexCounts;
+	}
+
+protected:
+	void SetPipelineState(ID3D12PipelineState* pPso) override { calls.push_back({ PIPELINE_STATE, 0, reinterpret_cast<UINT64>(pPso) }); }
+	void SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature) override { calls.push_back({ ROOT_SIGNATURE, 0, reinterpret_cast<UINT64>(pRootSignature) }); }
+	void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) override { calls.push_back({ TOPOLOGY, 0, static_cast<UINT64>(topology) }); }
+	void SetVertexBuffer(const D3D12_VERTEX_BUFFER_VIEW& view) override { calls.push_back({ VERTEX_BUFFER, 0, view.BufferLocation }); }
+	void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view) override { calls.push_back({ INDEX_BUFFER, 0, view.BufferLocation }); }
+	void SetGraphicsRootDescriptorTable(UINT rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE descriptor) override { calls.push_back({ DESCRIPTOR_TABLE, rootIndex, descriptor.ptr }); }
+	void SetGraphicsRootConstantBufferView(UINT rootIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override { calls.push_back({ CONSTANT_BUFFER_VIEW, rootIndex, address }); }
+	void DrawIndexedInstanced(UINT indexCount, UINT instanceCount) override { calls.push_back({ DRAW, instanceCount, indexCount }); }
+};
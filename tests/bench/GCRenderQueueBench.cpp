@@ -0,0 +1,72 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // Frame of opaque draws over a few shaders / materials / textures, 1 in 8 alpha
+    std::vector<uint64_t> MakeFrameKeys(int count)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> shaders(0, 15);
+        std::uniform_int_distribution<int> materials(0, 255);
+        std::uniform_int_distribution<int> textures(0, 63);
+        std::uniform_real_distribution<float> depths(0.1f, 1000.0f);
+
+        std::vector<uint64_t> keys(count);
+        for (int i = 0; i < count; i++)
+        {
+            if (i % 8 == 0)
+                keys[i] = GCRenderQueue::MakeAlphaKey(depths(random), static_cast<uint32_t>(i));
+            else
+                keys[i] = GCRenderQueue::MakeOpaqueKey(shaders(random), materials(random), textures(random), depths(random));
+        }
+        return keys;
+    }
+}
+
+// Push of the frame keys then the radix sort, as the render context does every frame
+static void BM_RenderQueueSort(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+    std::vector<uint64_t> keys = MakeFrameKeys(count);
+
+    GCRenderQueue queue;
+    queue.Reserve(count);
+
+    for (auto _ : state)
+    {
+        queue.Clear();
+        for (uint64_t key : keys)
+            queue.Push(key);
+
+        queue.Sort();
+        benchmark::DoNotOptimize(queue.GetSortedIndex(0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RenderQueueSort)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// Same frame with std::stable_sort, the comparison sort the radix sort replaces
+static void BM_RenderQueueStableSort(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+    std::vector<uint64_t> keys = MakeFrameKeys(count);
+
+    std::vector<GC_RENDER_QUEUE_ENTRY> entries;
+    entries.reserve(count);
+
+    for (auto _ : state)
+    {
+        entries.clear();
+        for (uint64_t key : keys)
+            entries.push_back({ key, static_cast<uint32_t>(entries.size()) });
+
+        std::stable_sort(entries.begin(), entries.end(), [](const GC_RENDER_QUEUE_ENTRY& a, const GC_RENDER_QUEUE_ENTRY& b) { return a.key < b.key; });
+        benchmark::DoNotOptimize(entries[0].index);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RenderQueueStableSort)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
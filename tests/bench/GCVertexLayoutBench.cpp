@@ -0,0 +1,62 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // Vertices of a large mesh with every stream attribute filled
+    GCGeometry MakeGeometry(int vertexCount)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        GCGeometry geometry;
+        geometry.pos.resize(vertexCount);
+        geometry.color.resize(vertexCount);
+        geometry.uv.resize(vertexCount);
+        geometry.normals.resize(vertexCount);
+        for (int i = 0; i < vertexCount; i++)
+        {
+            geometry.pos[i] = DirectX::XMFLOAT3(unit(random) * 100.0f, unit(random) * 100.0f, unit(random) * 100.0f);
+            geometry.color[i] = DirectX::XMFLOAT4(unit(random) * 0.5f + 0.5f, unit(random) * 0.5f + 0.5f, unit(random) * 0.5f + 0.5f, 1.0f);
+            geometry.uv[i] = DirectX::XMFLOAT2(unit(random) * 0.5f + 0.5f, unit(random) * 0.5f + 0.5f);
+
+            DirectX::XMFLOAT3 normal(unit(random), unit(random), unit(random));
+            float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+            geometry.normals[i] = length > 0.0f ? DirectX::XMFLOAT3(normal.x / length, normal.y / length, normal.z / length) : DirectX::XMFLOAT3(0.0f, 0.0f, 1.0f);
+        }
+        geometry.vertexNumber = vertexCount;
+        return geometry;
+    }
+}
+
+// One Pack of a 64K vertices mesh per flag combination : cost of each encoder against the plain copy
+static void BM_VertexLayoutPack(benchmark::State& state)
+{
+    const int flags = static_cast<int>(state.range(0));
+    const GCGeometry geometry = MakeGeometry(1 << 16);
+
+    const UINT stride = GCVertexLayout::Make(flags).stride;
+    std::vector<BYTE> destination(geometry.pos.size() * stride);
+    const DirectX::XMFLOAT3 noOffset(0.0f, 0.0f, 0.0f);
+
+    for (auto _ : state)
+    {
+        GCVertexLayout::Pack(flags, geometry, noOffset, destination.data());
+        benchmark::DoNotOptimize(destination.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * geometry.pos.size());
+    state.SetBytesProcessed(state.iterations() * destination.size());
+    state.counters["stride"] = stride;
+}
+BENCHMARK(BM_VertexLayoutPack)
+    ->ArgName("flags")
+    ->Arg(GCVertexLayout::m_streamFlags)
+    ->Arg(GCVertexLayout::m_streamFlags | GC_VERTEX_POSITION_HALF)
+    ->Arg(GCVertexLayout::m_streamFlags | GC_VERTEX_COLOR_RGBA8)
+    ->Arg(GCVertexLayout::m_streamFlags | GC_VERTEX_UV_HALF)
+    ->Arg(GCVertexLayout::m_streamFlags | GC_VERTEX_NORMAL_OCT)
+    ->Arg(GCVertexLayout::m_streamFlags | GCVertexLayout::m_compressedFlags)
+    ->Unit(benchmark::kMicrosecond);
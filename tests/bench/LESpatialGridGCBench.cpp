@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "LESpatialGridGC.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // Fixed world : more objects means more objects per cell and per query
+    constexpr float s_worldSize = 16384.0f;
+
+    struct Bounds
+    {
+        float minX, minY, maxX, maxY;
+    };
+
+    std::vector<Bounds> MakeObjects(int count)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> positions(0.0f, s_worldSize);
+        std::uniform_real_distribution<float> sizes(16.0f, 128.0f);
+
+        std::vector<Bounds> objects(count);
+        for (Bounds& bounds : objects)
+        {
+            bounds.minX = positions(random);
+            bounds.minY = positions(random);
+            bounds.maxX = bounds.minX + sizes(random);
+            bounds.maxY = bounds.minY + sizes(random);
+        }
+        return objects;
+    }
+
+    void FillGrid(LESpatialGridGC& grid, const std::vector<Bounds>& objects)
+    {
+        for (int handle = 0; handle < static_cast<int>(objects.size()); handle++)
+            grid.Update(handle, objects[handle].minX, objects[handle].minY, objects[handle].maxX, objects[handle].maxY);
+    }
+
+    // Screen sized rects walking across the world
+    Bounds QueryRectAt(int query)
+    {
+        float x = static_cast<float>((query * 1931) % static_cast<int>(s_worldSize - 1920.0f));
+        float y = static_cast<float>((query * 3371) % static_cast<int>(s_worldSize - 1080.0f));
+        return { x, y, x + 1920.0f, y + 1080.0f };
+    }
+}
+
+// One screen query (visible objects of a camera) against a grid of state.range(0) objects
+static void BM_SpatialGridQueryRect(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+
+    LESpatialGridGC grid;
+    FillGrid(grid, MakeObjects(count));
+
+    std::vector<int> handles;
+    int query = 0;
+    size_t foundCount = 0;
+    for (auto _ : state)
+    {
+        Bounds rect = QueryRectAt(query++);
+        handles.clear();
+        grid.QueryRect(rect.minX, rect.minY, rect.maxX, rect.maxY, handles);
+        foundCount += handles.size();
+        benchmark::DoNotOptimize(handles.data());
+    }
+
+    state.counters["found"] = benchmark::Counter(static_cast<double>(foundCount), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SpatialGridQueryRect)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// Same queries as a scan of every object, what the grid replaces
+static void BM_SpatialGridQueryRectScan(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+    std::vector<Bounds> objects = MakeObjects(count);
+
+    std::vector<int> handles;
+    int query = 0;
+    for (auto _ : state)
+    {
+        Bounds rect = QueryRectAt(query++);
+        handles.clear();
+        for (int handle = 0; handle < count; handle++)
+        {
+            const Bounds& bounds = objects[handle];
+            if (bounds.maxX >= rect.minX && bounds.minX <= rect.maxX && bounds.maxY >= rect.minY && bounds.minY <= rect.maxY)
+                handles.push_back(handle);
+        }
+        benchmark::DoNotOptimize(handles.data());
+    }
+}
+BENCHMARK(BM_SpatialGridQueryRectScan)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// Picking under the cursor
+static void BM_SpatialGridQueryPoint(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+
+    LESpatialGridGC grid;
+    FillGrid(grid, MakeObjects(count));
+
+    std::vector<int> handles;
+    int query = 0;
+    for (auto _ : state)
+    {
+        Bounds rect = QueryRectAt(query++);
+        handles.clear();
+        grid.QueryPoint(rect.minX, rect.minY, handles);
+        benchmark::DoNotOptimize(handles.data());
+    }
+}
+BENCHMARK(BM_SpatialGridQueryPoint)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
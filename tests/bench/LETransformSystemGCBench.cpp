@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "LETransformGC.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    void CreateTransforms(LETransformSystemGC& system, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            int handle = system.Create();
+            system.SetPosition(handle, static_cast<float>(i % 1920), static_cast<float>(i / 1920));
+            system.SetScale(handle, 1.0f + (i % 7) * 0.1f, 1.0f);
+        }
+    }
+}
+
+// Every object moved this frame : setters then one Update over all the blocks
+static void BM_TransformSystemUpdateAllDirty(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+
+    LETransformSystemGC system;
+    CreateTransforms(system, count);
+    system.Update();
+
+    float rotation = 0.0f;
+    for (auto _ : state)
+    {
+        rotation += 0.01f;
+        for (int handle = 0; handle < count; handle++)
+            system.SetRotation(handle, rotation);
+
+        system.Update();
+        benchmark::DoNotOptimize(system.GetWorldMatrix(count - 1));
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransformSystemUpdateAllDirty)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// One object in 64 moved : Update only visits the dirty blocks
+static void BM_TransformSystemUpdateSparse(benchmark::State& state)
+{
+    const int count = static_cast<int>(state.range(0));
+
+    LETransformSystemGC system;
+    CreateTransforms(system, count);
+    system.Update();
+
+    float x = 0.0f;
+    for (auto _ : state)
+    {
+        x += 1.0f;
+        for (int handle = 0; handle < count; handle += 64)
+            system.SetPosition(handle, x, 0.0f);
+
+        system.Update();
+        benchmark::DoNotOptimize(system.GetWorldMatrix(0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * (count / 64));
+}
+BENCHMARK(BM_TransformSystemUpdateSparse)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
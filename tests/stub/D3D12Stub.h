@@ -0,0 +1,66 @@
+#pragma once
+
+// D3D12 types named by the headers of the device-free sources, Linux test build only. Interfaces are only
+// passed around as pointers : they stay incomplete
+struct ID3D12PipelineState;
+struct ID3D12RootSignature;
+struct ID3D12GraphicsCommandList;
+
+typedef UINT64 D3D12_GPU_VIRTUAL_ADDRESS;
+
+enum DXGI_FORMAT
+{
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+	DXGI_FORMAT_R32G32B32_FLOAT = 6,
+	DXGI_FORMAT_R16G16B16A16_FLOAT = 10,
+	DXGI_FORMAT_R32G32_FLOAT = 16,
+	DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+	DXGI_FORMAT_R16G16_FLOAT = 34,
+	DXGI_FORMAT_R16G16_SNORM = 37,
+	DXGI_FORMAT_R16_UINT = 57,
+};
+
+enum D3D_PRIMITIVE_TOPOLOGY
+{
+	D3D_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+	D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+};
+typedef D3D_PRIMITIVE_TOPOLOGY D3D12_PRIMITIVE_TOPOLOGY;
+
+struct D3D12_GPU_DESCRIPTOR_HANDLE
+{
+	UINT64 ptr;
+};
+
+struct D3D12_VERTEX_BUFFER_VIEW
+{
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+
+struct D3D12_INDEX_BUFFER_VIEW
+{
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
+
+enum D3D12_INPUT_CLASSIFICATION
+{
+	D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA = 0,
+	D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA = 1,
+};
+
+struct D3D12_INPUT_ELEMENT_DESC
+{
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	DXGI_FORMAT Format;
+	UINT InputSlot;
+	UINT AlignedByteOffset;
+	D3D12_INPUT_CLASSIFICATION InputSlotClass;
+	UINT InstanceDataStepRate;
+};
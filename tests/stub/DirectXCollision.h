@@ -0,0 +1,25 @@
+#pragma once
+
+// Bounding volumes of DirectXCollision named by the device-free sources, Linux test build only. Data and
+// constructors, the intersection tests are not needed
+
+namespace DirectX
+{
+	struct BoundingBox
+	{
+		XMFLOAT3 Center;
+		XMFLOAT3 Extents;
+
+		BoundingBox() : Center(0.0f, 0.0f, 0.0f), Extents(1.0f, 1.0f, 1.0f) {}
+		constexpr BoundingBox(const XMFLOAT3& center, const XMFLOAT3& extents) : Center(center), Extents(extents) {}
+	};
+
+	struct BoundingSphere
+	{
+		XMFLOAT3 Center;
+		float Radius;
+
+		BoundingSphere() : Center(0.0f, 0.0f, 0.0f), Radius(1.0f) {}
+		constexpr BoundingSphere(const XMFLOAT3& center, float radius) : Center(center), Radius(radius) {}
+	};
+}
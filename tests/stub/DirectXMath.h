@@ -0,0 +1,263 @@
+#pragma once
+
+// Scalar stand-in for the part of DirectXMath the device-free sources use, so they build on Linux.
+// Same layouts and semantics as DirectXMath (row vectors, row-major matrices, 0xFFFFFFFF comparison masks),
+// without the SSE paths : benchmarks measure the code around the math, not the math itself.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#define XM_CALLCONV
+
+namespace DirectX
+{
+	struct XMVECTOR
+	{
+		union
+		{
+			float f[4];
+			uint32_t u[4];
+		};
+	};
+
+	using FXMVECTOR = const XMVECTOR;
+	using GXMVECTOR = const XMVECTOR;
+	using HXMVECTOR = const XMVECTOR;
+	using CXMVECTOR = const XMVECTOR&;
+
+	struct XMMATRIX
+	{
+		XMVECTOR r[4];
+
+		XMMATRIX() = default;
+		XMMATRIX(FXMVECTOR r0, FXMVECTOR r1, FXMVECTOR r2, CXMVECTOR r3) : r{ r0, r1, r2, r3 } {}
+	};
+
+	using FXMMATRIX = const XMMATRIX;
+	using CXMMATRIX = const XMMATRIX&;
+
+	struct XMFLOAT2
+	{
+		float x, y;
+
+		XMFLOAT2() = default;
+		constexpr XMFLOAT2(float _x, float _y) : x(_x), y(_y) {}
+	};
+
+	struct XMFLOAT3
+	{
+		float x, y, z;
+
+		XMFLOAT3() = default;
+		constexpr XMFLOAT3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+	};
+
+	struct XMFLOAT4
+	{
+		float x, y, z, w;
+
+		XMFLOAT4() = default;
+		constexpr XMFLOAT4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+	};
+
+	struct XMFLOAT4X4
+	{
+		union
+		{
+			struct
+			{
+				float _11, _12, _13, _14;
+				float _21, _22, _23, _24;
+				float _31, _32, _33, _34;
+				float _41, _42, _43, _44;
+			};
+			float m[4][4];
+		};
+
+		XMFLOAT4X4() = default;
+		constexpr XMFLOAT4X4(float m00, float m01, float m02, float m03,
+			float m10, float m11, float m12, float m13,
+			float m20, float m21, float m22, float m23,
+			float m30, float m31, float m32, float m33)
+			: _11(m00), _12(m01), _13(m02), _14(m03),
+			_21(m10), _22(m11), _23(m12), _24(m13),
+			_31(m20), _32(m21), _33(m22), _34(m23),
+			_41(m30), _42(m31), _43(m32), _44(m33) {}
+	};
+
+	constexpr float XM_PI = 3.141592654f;
+	constexpr float XM_PIDIV2 = 1.570796327f;
+
+	inline XMVECTOR XMVectorSet(float x, float y, float z, float w) { XMVECTOR v; v.f[0] = x; v.f[1] = y; v.f[2] = z; v.f[3] = w; return v; }
+	inline XMVECTOR XMVectorSetInt(uint32_t x, uint32_t y, uint32_t z, uint32_t w) { XMVECTOR v; v.u[0] = x; v.u[1] = y; v.u[2] = z; v.u[3] = w; return v; }
+	inline XMVECTOR XMVectorReplicate(float value) { return XMVectorSet(value, value, value, value); }
+	inline XMVECTOR XMVectorZero() { return XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f); }
+	inline XMVECTOR XMVectorSplatOne() { return XMVectorReplicate(1.0f); }
+	inline XMVECTOR XMVectorTrueInt() { return XMVectorSetInt(0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu); }
+	inline XMVECTOR XMVectorSplatX(FXMVECTOR v) { return XMVectorReplicate(v.f[0]); }
+	inline XMVECTOR XMVectorSplatY(FXMVECTOR v) { return XMVectorReplicate(v.f[1]); }
+	inline XMVECTOR XMVectorSplatZ(FXMVECTOR v) { return XMVectorReplicate(v.f[2]); }
+	inline XMVECTOR XMVectorSplatW(FXMVECTOR v) { return XMVectorReplicate(v.f[3]); }
+	inline float XMVectorGetX(FXMVECTOR v) { return v.f[0]; }
+	inline float XMVectorGetY(FXMVECTOR v) { return v.f[1]; }
+	inline float XMVectorGetZ(FXMVECTOR v) { return v.f[2]; }
+	inline float XMVectorGetW(FXMVECTOR v) { return v.f[3]; }
+
+	static const XMVECTOR g_XMIdentityR0 = XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+	static const XMVECTOR g_XMIdentityR1 = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+	static const XMVECTOR g_XMIdentityR2 = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+	static const XMVECTOR g_XMIdentityR3 = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+
+	// Lane by lane
+	template<typename Function>
+	inline XMVECTOR XMVectorMap(FXMVECTOR a, FXMVECTOR b, Function function)
+	{
+		XMVECTOR result;
+		for (int i = 0; i < 4; i++)
+			result.f[i] = function(a.f[i], b.f[i]);
+		return result;
+	}
+
+	inline XMVECTOR XMVectorAdd(FXMVECTOR a, FXMVECTOR b) { return XMVectorMap(a, b, [](float x, float y) { return x + y; }); }
+	inline XMVECTOR XMVectorSubtract(FXMVECTOR a, FXMVECTOR b) { return XMVectorMap(a, b, [](float x, float y) { return x - y; }); }
+	inline XMVECTOR XMVectorMultiply(FXMVECTOR a, FXMVECTOR b) { return XMVectorMap(a, b, [](float x, float y) { return x * y; }); }
+	inline XMVECTOR XMVectorDivide(FXMVECTOR a, FXMVECTOR b) { return XMVectorMap(a, b, [](float x, float y) { return x / y; }); }
+	inline XMVECTOR XMVectorMin(FXMVECTOR a, FXMVECTOR b) { return XMVectorMap(a, b, [](float x, float y) { return x < y ? x : y; }); }
+	inline XMVECTOR XMVectorMax(FXMVECTOR a, FXMVECTOR b) { return XMVectorMap(a, b, [](float x, float y) { return x > y ? x : y; }); }
+	inline XMVECTOR XMVectorMultiplyAdd(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c) { return XMVectorAdd(XMVectorMultiply(a, b), c); }
+	inline XMVECTOR XMVectorScale(FXMVECTOR v, float scale) { return XMVectorMultiply(v, XMVectorReplicate(scale)); }
+	inline XMVECTOR XMVectorNegate(FXMVECTOR v) { return XMVectorSubtract(XMVectorZero(), v); }
+	inline XMVECTOR XMVectorAbs(FXMVECTOR v) { return XMVectorMap(v, v, [](float x, float) { return std::fabs(x); }); }
+
+	inline XMVECTOR XMVectorGreaterOrEqual(FXMVECTOR a, FXMVECTOR b)
+	{
+		XMVECTOR result;
+		for (int i = 0; i < 4; i++)
+			result.u[i] = a.f[i] >= b.f[i] ? 0xFFFFFFFFu : 0u;
+		return result;
+	}
+
+	inline XMVECTOR XMVectorAndInt(FXMVECTOR a, FXMVECTOR b)
+	{
+		XMVECTOR result;
+		for (int i = 0; i < 4; i++)
+			result.u[i] = a.u[i] & b.u[i];
+		return result;
+	}
+
+	inline void XMVectorSinCos(XMVECTOR* pSin, XMVECTOR* pCos, FXMVECTOR v)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			pSin->f[i] = std::sin(v.f[i]);
+			pCos->f[i] = std::cos(v.f[i]);
+		}
+	}
+
+	inline XMVECTOR XMVector3Dot(FXMVECTOR a, FXMVECTOR b) { return XMVectorReplicate(a.f[0] * b.f[0] + a.f[1] * b.f[1] + a.f[2] * b.f[2]); }
+	inline XMVECTOR XMVector4Dot(FXMVECTOR a, FXMVECTOR b) { return XMVectorReplicate(a.f[0] * b.f[0] + a.f[1] * b.f[1] + a.f[2] * b.f[2] + a.f[3] * b.f[3]); }
+
+	// Row vector : v.x * r0 + v.y * r1 + v.z * r2 + r3
+	inline XMVECTOR XMVector3Transform(FXMVECTOR v, FXMMATRIX m)
+	{
+		XMVECTOR result = XMVectorMultiplyAdd(XMVectorSplatX(v), m.r[0], m.r[3]);
+		result = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], result);
+		return XMVectorMultiplyAdd(XMVectorSplatZ(v), m.r[2], result);
+	}
+
+	inline XMVECTOR XMVector4Transform(FXMVECTOR v, FXMMATRIX m)
+	{
+		XMVECTOR result = XMVectorMultiply(XMVectorSplatX(v), m.r[0]);
+		result = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], result);
+		result = XMVectorMultiplyAdd(XMVectorSplatZ(v), m.r[2], result);
+		return XMVectorMultiplyAdd(XMVectorSplatW(v), m.r[3], result);
+	}
+
+	// Divided by the length of the normal (xyz)
+	inline XMVECTOR XMPlaneNormalize(FXMVECTOR plane)
+	{
+		float length = std::sqrt(plane.f[0] * plane.f[0] + plane.f[1] * plane.f[1] + plane.f[2] * plane.f[2]);
+		return length > 0.0f ? XMVectorScale(plane, 1.0f / length) : plane;
+	}
+
+	inline XMMATRIX XMMatrixSet(float m00, float m01, float m02, float m03,
+		float m10, float m11, float m12, float m13,
+		float m20, float m21, float m22, float m23,
+		float m30, float m31, float m32, float m33)
+	{
+		return XMMATRIX(XMVectorSet(m00, m01, m02, m03), XMVectorSet(m10, m11, m12, m13), XMVectorSet(m20, m21, m22, m23), XMVectorSet(m30, m31, m32, m33));
+	}
+
+	inline XMMATRIX XMMatrixIdentity() { return XMMATRIX(g_XMIdentityR0, g_XMIdentityR1, g_XMIdentityR2, g_XMIdentityR3); }
+
+	inline XMMATRIX XMMatrixTranspose(FXMMATRIX m)
+	{
+		XMMATRIX result;
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+				result.r[row].f[column] = m.r[column].f[row];
+		}
+		return result;
+	}
+
+	inline XMMATRIX XMMatrixMultiply(FXMMATRIX a, CXMMATRIX b)
+	{
+		XMMATRIX result;
+		for (int row = 0; row < 4; row++)
+			result.r[row] = XMVector4Transform(a.r[row], b);
+		return result;
+	}
+
+	inline XMMATRIX XMMatrixScaling(float x, float y, float z) { return XMMatrixSet(x, 0.0f, 0.0f, 0.0f, 0.0f, y, 0.0f, 0.0f, 0.0f, 0.0f, z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f); }
+	inline XMMATRIX XMMatrixTranslation(float x, float y, float z) { return XMMatrixSet(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, x, y, z, 1.0f); }
+
+	inline XMMATRIX XMMatrixRotationZ(float angle)
+	{
+		float sinAngle = std::sin(angle);
+		float cosAngle = std::cos(angle);
+		return XMMatrixSet(cosAngle, sinAngle, 0.0f, 0.0f, -sinAngle, cosAngle, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	// Left handed, depth in [0, 1]
+	inline XMMATRIX XMMatrixOrthographicLH(float width, float height, float nearZ, float farZ)
+	{
+		float range = 1.0f / (farZ - nearZ);
+		return XMMatrixSet(2.0f / width, 0.0f, 0.0f, 0.0f, 0.0f, 2.0f / height, 0.0f, 0.0f, 0.0f, 0.0f, range, 0.0f, 0.0f, 0.0f, -range * nearZ, 1.0f);
+	}
+
+	inline XMMATRIX XMMatrixPerspectiveFovLH(float fovAngleY, float aspectRatio, float nearZ, float farZ)
+	{
+		float height = 1.0f / std::tan(0.5f * fovAngleY);
+		float width = height / aspectRatio;
+		float range = farZ / (farZ - nearZ);
+		return XMMatrixSet(width, 0.0f, 0.0f, 0.0f, 0.0f, height, 0.0f, 0.0f, 0.0f, 0.0f, range, 1.0f, 0.0f, 0.0f, -range * nearZ, 0.0f);
+	}
+
+	inline XMVECTOR XMLoadFloat2(const XMFLOAT2* pSource) { return XMVectorSet(pSource->x, pSource->y, 0.0f, 0.0f); }
+	inline XMVECTOR XMLoadFloat3(const XMFLOAT3* pSource) { return XMVectorSet(pSource->x, pSource->y, pSource->z, 0.0f); }
+	inline XMVECTOR XMLoadFloat4(const XMFLOAT4* pSource) { return XMVectorSet(pSource->x, pSource->y, pSource->z, pSource->w); }
+
+	inline void XMStoreFloat2(XMFLOAT2* pDestination, FXMVECTOR v) { pDestination->x = v.f[0]; pDestination->y = v.f[1]; }
+	inline void XMStoreFloat3(XMFLOAT3* pDestination, FXMVECTOR v) { pDestination->x = v.f[0]; pDestination->y = v.f[1]; pDestination->z = v.f[2]; }
+	inline void XMStoreFloat4(XMFLOAT4* pDestination, FXMVECTOR v) { pDestination->x = v.f[0]; pDestination->y = v.f[1]; pDestination->z = v.f[2]; pDestination->w = v.f[3]; }
+	inline void XMStoreInt4(uint32_t* pDestination, FXMVECTOR v) { std::memcpy(pDestination, v.u, sizeof(v.u)); }
+
+	inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* pSource)
+	{
+		return XMMatrixSet(pSource->_11, pSource->_12, pSource->_13, pSource->_14,
+			pSource->_21, pSource->_22, pSource->_23, pSource->_24,
+			pSource->_31, pSource->_32, pSource->_33, pSource->_34,
+			pSource->_41, pSource->_42, pSource->_43, pSource->_44);
+	}
+
+	inline void XMStoreFloat4x4(XMFLOAT4X4* pDestination, FXMMATRIX m)
+	{
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+				pDestination->m[row][column] = m.r[row].f[column];
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+// Packed vector types of DirectXPackedVector used by the vertex encoders, Linux test build only.
+// Same bit layouts and rounding as DirectXMath (half round to nearest even, normalized formats saturated)
+
+namespace DirectX
+{
+	namespace PackedVector
+	{
+		typedef uint16_t HALF;
+
+		inline HALF XMConvertFloatToHalf(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			uint32_t sign = (bits >> 16) & 0x8000u;
+			uint32_t absBits = bits & 0x7FFFFFFFu;
+
+			if (absBits >= 0x7F800000u) // Inf, NaN
+				return static_cast<HALF>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x200u : 0u));
+			if (absBits >= 0x477FF000u) // Rounds past the largest half
+				return static_cast<HALF>(sign | 0x7C00u);
+
+			uint32_t half;
+			if (absBits < 0x38800000u) // Half denormal
+			{
+				uint32_t shift = 113u - (absBits >> 23);
+				if (shift > 24u)
+					return static_cast<HALF>(sign);
+				uint32_t mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+				half = mantissa >> shift;
+				uint32_t remainder = mantissa & ((1u << shift) - 1u);
+				uint32_t halfway = 1u << (shift - 1u);
+				if (remainder > halfway || (remainder == halfway && (half & 1u)))
+					half++;
+			}
+			else
+			{
+				half = (absBits - 0x38000000u) >> 13;
+				uint32_t remainder = absBits & 0x1FFFu;
+				if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+					half++;
+			}
+
+			return static_cast<HALF>(sign | half);
+		}
+
+		struct XMHALF2
+		{
+			HALF x, y;
+
+			XMHALF2() = default;
+			XMHALF2(float _x, float _y) : x(XMConvertFloatToHalf(_x)), y(XMConvertFloatToHalf(_y)) {}
+		};
+
+		struct XMHALF4
+		{
+			HALF x, y, z, w;
+
+			XMHALF4() = default;
+			XMHALF4(float _x, float _y, float _z, float _w) : x(XMConvertFloatToHalf(_x)), y(XMConvertFloatToHalf(_y)), z(XMConvertFloatToHalf(_z)), w(XMConvertFloatToHalf(_w)) {}
+		};
+
+		struct XMUBYTEN4
+		{
+			uint8_t x, y, z, w;
+		};
+
+		struct XMSHORTN2
+		{
+			int16_t x, y;
+		};
+
+		inline void XMStoreUByteN4(XMUBYTEN4* pDestination, FXMVECTOR v)
+		{
+			uint8_t* components[4] = { &pDestination->x, &pDestination->y, &pDestination->z, &pDestination->w };
+			for (int i = 0; i < 4; i++)
+			{
+				float saturated = std::fmin(std::fmax(v.f[i], 0.0f), 1.0f);
+				*components[i] = static_cast<uint8_t>(std::nearbyint(saturated * 255.0f));
+			}
+		}
+
+		inline void XMStoreShortN2(XMSHORTN2* pDestination, FXMVECTOR v)
+		{
+			float x = std::fmin(std::fmax(v.f[0], -1.0f), 1.0f);
+			float y = std::fmin(std::fmax(v.f[1], -1.0f), 1.0f);
+			pDestination->x = static_cast<int16_t>(std::nearbyint(x * 32767.0f));
+			pDestination->y = static_cast<int16_t>(std::nearbyint(y * 32767.0f));
+		}
+	}
+}
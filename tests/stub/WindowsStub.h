@@ -0,0 +1,20 @@
+#pragma once
+
+// Windows types named by the headers of the device-free sources, Linux test build only
+#include <cstdint>
+
+typedef uint8_t BYTE;
+typedef int32_t INT;
+typedef uint32_t UINT;
+typedef int32_t INT32;
+typedef uint32_t UINT32;
+typedef int64_t INT64;
+typedef uint64_t UINT64;
+typedef int32_t HRESULT;
+typedef void* HANDLE;
+typedef const char* LPCSTR;
+
+// Debugger output, dropped
+inline void OutputDebugStringA(const char*) {}
+inline void OutputDebugStringW(const wchar_t*) {}
+#define OutputDebugString OutputDebugStringW
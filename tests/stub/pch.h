@@ -0,0 +1,51 @@
+#pragma once
+
+// Test build replacement of src/Render/pch.h and src/Main/pch.h, for the sources that need no device.
+// Standard headers, the Windows / DirectX stand-ins, then the engine headers of the tested sources
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <set>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
+#include <iostream>
+#include <cassert>
+
+#include "WindowsStub.h"
+#include "D3D12Stub.h"
+#include "DirectXMath.h"
+#include "DirectXCollision.h"
+#include "DirectXPackedVector.h"
+
+// Named by Macros.h
+class GCMaterial;
+class GCMesh;
+
+#include "GCGraphicsLogger.h"
+#include "Macros.h"
+#include "GCShaderConstantBufferStruct.h"
+#include "GCGeometry.h"
+#include "GCProfiler.h"
+#include "GCBuddyAllocator.h"
+#include "GCThreadPool.h"
+#include "GCGpuTimestampRing.h"
+#include "GCStagingRingAllocator.h"
+#include "GCDrawRecorder.h"
+#include "GCRenderQueue.h"
+#include "GCCuller.h"
+#include "GCParticleSimulation.h"
+#include "GCVertexLayout.h"